@@ -18,6 +18,7 @@
 #include "mrc/coroutines/concepts/awaitable.hpp"
 #include "mrc/coroutines/sync_wait.hpp"
 #include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
 #include "mrc/coroutines/when_all.hpp"
 
 #include <benchmark/benchmark.h>
@@ -27,6 +28,7 @@
 #include <memory>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 using namespace mrc;
 
@@ -142,9 +144,52 @@ static void mrc_coro_await_incrementing_awaitable_baseline(benchmark::State& sta
     coroutines::sync_wait(task());
 }
 
+// fan out from inside the pool, every task reschedules itself a few times; stresses the pool's scheduling path
+template <coroutines::ThreadPool::SchedulingMode ModeT>
+static void mrc_coro_thread_pool_fan_out(benchmark::State& state)
+{
+    coroutines::ThreadPool tp{{.thread_count = static_cast<uint32_t>(state.range(0)), .scheduling_mode = ModeT}};
+
+    auto inner = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+        for (int i = 0; i < 4; ++i)
+        {
+            co_await tp.yield();
+        }
+    };
+
+    auto outer = [&]() -> coroutines::Task<void> {
+        co_await tp.schedule();
+
+        std::vector<coroutines::Task<void>> tasks;
+        tasks.reserve(1024);
+        for (std::size_t i = 0; i < 1024; ++i)
+        {
+            tasks.push_back(inner());
+        }
+
+        co_await coroutines::when_all(std::move(tasks));
+    };
+
+    for (auto _ : state)
+    {
+        coroutines::sync_wait(outer());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 1024 * 5);
+}
+
 BENCHMARK(mrc_coro_create_single_task_and_sync);
 BENCHMARK(mrc_coro_create_single_task_and_sync_on_when_all);
 BENCHMARK(mrc_coro_create_two_tasks_and_sync_on_when_all);
 BENCHMARK(mrc_coro_await_suspend_never);
 BENCHMARK(mrc_coro_await_incrementing_awaitable_baseline);
 BENCHMARK(mrc_coro_await_incrementing_awaitable);
+BENCHMARK_TEMPLATE(mrc_coro_thread_pool_fan_out, coroutines::ThreadPool::SchedulingMode::GlobalQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(mrc_coro_thread_pool_fan_out, coroutines::ThreadPool::SchedulingMode::WorkStealing)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime();
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -15,15 +15,43 @@
  * limitations under the License.
  */
 
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/recent_channel.hpp"
+#include "mrc/channel/ring_channel.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/core/watcher.hpp"
+#include "mrc/coroutines/async_generator.hpp"
+#include "mrc/coroutines/closable_ring_buffer.hpp"
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/when_all.hpp"
+#include "mrc/data/cached_reusable_pool.hpp"
 #include "mrc/data/reusable_pool.hpp"
+#include "mrc/edge/edge_builder.hpp"
+#include "mrc/edge/edge_ring_buffer.hpp"
+#include "mrc/edge/edge_writable.hpp"
+#include "mrc/node/coro_node.hpp"
+#include "mrc/node/operators/broadcast.hpp"
+#include "mrc/node/operators/queued_broadcast.hpp"
+#include "mrc/node/rx_node.hpp"
+#include "mrc/node/rx_sink.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/types.hpp"
 #include "mrc/utils/macros.hpp"
 
 #include <benchmark/benchmark.h>
+#include <boost/fiber/fiber.hpp>
+#include <rxcpp/rx.hpp>
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 using namespace mrc;
 
@@ -53,11 +81,112 @@ class Buffer
   private:
     std::array<float, 1024> m_buffer;
 };
+
+struct CountingWatcher : public WatcherInterface
+{
+    void on_entry(const WatchableEvent& /*op*/, const void* /*addr*/) final
+    {
+        benchmark::DoNotOptimize(++m_entries);
+    }
+
+    void on_exit(const WatchableEvent& /*op*/, bool /*rc*/, const void* /*addr*/) final
+    {
+        benchmark::DoNotOptimize(++m_exits);
+    }
+
+    std::uint64_t m_entries{0};
+    std::uint64_t m_exits{0};
+};
+
+// The previous std::deque based RecentChannel write/read paths, kept as a baseline for the ring buffer implementation
+template <typename T>
+class DequeRecentChannel
+{
+  public:
+    DequeRecentChannel(std::size_t count) : m_max_size(count) {}
+
+    channel::Status await_write(T&& data)
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+        if (m_deque.size() >= m_max_size)
+        {
+            m_deque.pop_front();
+        }
+        m_deque.push_back(std::move(data));
+        m_cv.notify_one();
+        return channel::Status::success;
+    }
+
+    channel::Status await_read(T& data)
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] {
+            return !m_deque.empty();
+        });
+        data = std::move(m_deque.front());
+        m_deque.pop_front();
+        return channel::Status::success;
+    }
+
+  private:
+    Mutex m_mutex;
+    CondV m_cv;
+    std::size_t m_max_size;
+    std::deque<T> m_deque;
+};
+
+template <typename T>
+class FanOutSource : public node::WritableAcceptor<T>
+{
+  public:
+    void write(T&& data)
+    {
+        this->get_writable_edge()->await_write(std::move(data));
+    }
+
+    void complete()
+    {
+        this->release_edge_connection();
+    }
+};
+
+template <typename T>
+class DiscardSink : public node::WritableProvider<T>
+{
+    class DiscardEdge : public edge::IEdgeWritable<T>
+    {
+      public:
+        channel::Status await_write(T&& data) final
+        {
+            benchmark::DoNotOptimize(data);
+            return channel::Status::success;
+        }
+    };
+
+  public:
+    DiscardSink()
+    {
+        this->init_owned_edge(std::make_shared<DiscardEdge>());
+    }
+};
+
+// Issues the subscription normally issued by the runnable, so the progress engine runs on the calling fiber
+template <typename NodeT>
+class SubscribedRxNode : public NodeT
+{
+  public:
+    void drain()
+    {
+        rxcpp::composite_subscription subscription;
+        this->subscribe(subscription);
+    }
+};
 }  // namespace
 
+template <typename PoolT>
 static void mrc_data_reusable(benchmark::State& state)
 {
-    auto pool = data::ReusablePool<Buffer>::create(32);
+    auto pool = PoolT::create(32);
     pool->add_item(std::make_unique<Buffer>());
     pool->add_item(std::make_unique<Buffer>());
 
@@ -68,4 +197,422 @@ static void mrc_data_reusable(benchmark::State& state)
     }
 }
 
-BENCHMARK(mrc_data_reusable);
+BENCHMARK_TEMPLATE(mrc_data_reusable, data::ReusablePool<Buffer>);
+BENCHMARK_TEMPLATE(mrc_data_reusable, data::CachedReusablePool<Buffer>);
+
+// every benchmark thread repeatedly acquires and returns items of a single shared pool
+template <typename PoolT>
+static void mrc_data_reusable_shared(benchmark::State& state)
+{
+    static std::shared_ptr<PoolT> pool;
+
+    if (state.thread_index() == 0)
+    {
+        pool = PoolT::create(64);
+        for (int i = 0; i < 32; ++i)
+        {
+            pool->add_item(std::make_unique<Buffer>());
+        }
+    }
+
+    for (auto _ : state)
+    {
+        auto buffer = pool->await_item();
+        benchmark::DoNotOptimize(buffer->data()[0] += 1.0);
+    }
+
+    if (state.thread_index() == 0)
+    {
+        pool.reset();
+    }
+}
+
+BENCHMARK_TEMPLATE(mrc_data_reusable_shared, data::ReusablePool<Buffer>)->Threads(1)->Threads(4)->Threads(8);
+BENCHMARK_TEMPLATE(mrc_data_reusable_shared, data::CachedReusablePool<Buffer>)->Threads(1)->Threads(4)->Threads(8);
+
+template <typename ChannelT>
+static void mrc_channel_write_read(benchmark::State& state)
+{
+    ChannelT channel(128);
+    int output = 0;
+
+    for (auto _ : state)
+    {
+        channel.await_write(42);
+        channel.await_read(output);
+        benchmark::DoNotOptimize(output);
+    }
+}
+
+BENCHMARK_TEMPLATE(mrc_channel_write_read, channel::BufferedChannel<int>);
+BENCHMARK_TEMPLATE(mrc_channel_write_read, DequeRecentChannel<int>);
+BENCHMARK_TEMPLATE(mrc_channel_write_read, channel::RecentChannel<int>);
+BENCHMARK_TEMPLATE(mrc_channel_write_read, channel::RingChannel<int, channel::RingChannelMode::spsc>);
+BENCHMARK_TEMPLATE(mrc_channel_write_read, channel::RingChannel<int, channel::RingChannelMode::mpmc>);
+
+// drop-oldest channels in steady state; every write past the first range(0) items overwrites the oldest one
+template <typename ChannelT>
+static void mrc_recent_channel_overwrite(benchmark::State& state)
+{
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+
+    ChannelT channel(capacity);
+    std::string output;
+
+    for (std::size_t i = 0; i < capacity; ++i)
+    {
+        channel.await_write(std::string(32, 'x'));
+    }
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            channel.await_write(std::string(32, 'x'));
+        }
+        channel.await_read(output);
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 17);
+}
+
+BENCHMARK_TEMPLATE(mrc_recent_channel_overwrite, DequeRecentChannel<std::string>)->Arg(4)->Arg(128)->Arg(4096);
+BENCHMARK_TEMPLATE(mrc_recent_channel_overwrite, channel::RecentChannel<std::string>)->Arg(4)->Arg(128)->Arg(4096);
+
+// cost of the Watchable hooks per channel op with range(0) attached watchers
+static void mrc_channel_watchers(benchmark::State& state)
+{
+    channel::BufferedChannel<int> channel(128);
+    int output = 0;
+
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        channel.add_watcher(std::make_shared<CountingWatcher>());
+    }
+
+    for (auto _ : state)
+    {
+        channel.await_write(42);
+        channel.await_read(output);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(mrc_channel_watchers)->Arg(0)->Arg(1)->Arg(4);
+
+template <typename ChannelT>
+static void mrc_channel_write_read_n(benchmark::State& state)
+{
+    const auto batch_size = static_cast<std::size_t>(state.range(0));
+
+    ChannelT channel(128);
+    std::vector<int> input(batch_size, 42);
+    std::vector<int> output;
+    output.reserve(batch_size);
+
+    for (auto _ : state)
+    {
+        channel.await_write_n(input);
+        channel.await_read_n(output, batch_size);
+        benchmark::DoNotOptimize(output.data());
+        output.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK_TEMPLATE(mrc_channel_write_read_n, channel::BufferedChannel<int>)->RangeMultiplier(4)->Range(1, 64);
+BENCHMARK_TEMPLATE(mrc_channel_write_read_n, channel::RingChannel<int, channel::RingChannelMode::spsc>)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+BENCHMARK_TEMPLATE(mrc_channel_write_read_n, channel::RingChannel<int, channel::RingChannelMode::mpmc>)
+    ->RangeMultiplier(4)
+    ->Range(1, 64);
+
+// fan out of a 4 KiB payload to range(0) downstreams; Broadcast copies the payload for every downstream but one, where
+// QueuedBroadcast hands every downstream the same envelope
+template <typename BroadcastT>
+static void mrc_broadcast_fan_out(benchmark::State& state)
+{
+    using payload_t = std::vector<float>;
+    using output_t  = typename BroadcastT::source_type_t;
+
+    FanOutSource<payload_t> source;
+    BroadcastT broadcast;
+    std::vector<std::unique_ptr<DiscardSink<output_t>>> sinks;
+
+    mrc::make_edge(source, broadcast);
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        mrc::make_edge(broadcast, *sinks.emplace_back(std::make_unique<DiscardSink<output_t>>()));
+    }
+
+    const payload_t payload(1024, 1.0F);
+
+    for (auto _ : state)
+    {
+        source.write(payload_t(payload));
+    }
+
+    source.complete();
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(mrc_broadcast_fan_out, node::Broadcast<std::vector<float>>)->Arg(2)->Arg(6)->Arg(12);
+BENCHMARK_TEMPLATE(mrc_broadcast_fan_out, node::QueuedBroadcast<std::vector<float>>)->Arg(2)->Arg(6)->Arg(12);
+
+// range(0) stages passing 1024 ints along a chain, all on the calling thread: fibers hopping through BufferedChannels
+// versus coroutine node bodies hopping through ClosableRingBuffers with CoroWriter
+static void mrc_stage_chain_fibers(benchmark::State& state)
+{
+    constexpr int ItemCount = 1024;
+    const auto stage_count  = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::vector<std::unique_ptr<channel::BufferedChannel<int>>> channels;
+        for (std::size_t i = 0; i <= stage_count; ++i)
+        {
+            channels.push_back(std::make_unique<channel::BufferedChannel<int>>(16));
+        }
+
+        std::vector<boost::fibers::fiber> stages;
+        for (std::size_t i = 0; i < stage_count; ++i)
+        {
+            stages.emplace_back([input = channels[i].get(), output = channels[i + 1].get()] {
+                int value;
+                while (input->await_read(value) == channel::Status::success)
+                {
+                    output->await_write(value + 1);
+                }
+                output->close_channel();
+            });
+        }
+
+        boost::fibers::fiber producer([input = channels.front().get()] {
+            for (int i = 0; i < ItemCount; ++i)
+            {
+                input->await_write(int(i));
+            }
+            input->close_channel();
+        });
+
+        int value;
+        while (channels.back()->await_read(value) == channel::Status::success)
+        {
+            benchmark::DoNotOptimize(value);
+        }
+
+        producer.join();
+        for (auto& stage : stages)
+        {
+            stage.join();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * ItemCount * stage_count);
+}
+
+static void mrc_stage_chain_coroutines(benchmark::State& state)
+{
+    using buffer_t = coroutines::ClosableRingBuffer<int>;
+
+    constexpr int ItemCount = 1024;
+    const auto stage_count  = static_cast<std::size_t>(state.range(0));
+
+    auto read_all = [](std::shared_ptr<buffer_t> buffer) -> coroutines::AsyncGenerator<int> {
+        while (true)
+        {
+            auto item = co_await buffer->read();
+            if (!item)
+            {
+                co_return;
+            }
+            co_yield std::move(*item);
+        }
+    };
+
+    auto stage = [](coroutines::AsyncGenerator<int> input, node::CoroWriter<int> output) -> coroutines::Task<void> {
+        auto iter = co_await input.begin();
+        while (iter != input.end())
+        {
+            co_await output.write(*iter + 1);
+            co_await ++iter;
+        }
+    };
+
+    for (auto _ : state)
+    {
+        std::vector<std::shared_ptr<buffer_t>> buffers;
+        std::vector<std::shared_ptr<edge::EdgeRingBufferWriter<int>>> edges;
+        for (std::size_t i = 0; i <= stage_count; ++i)
+        {
+            buffers.push_back(std::make_shared<buffer_t>(buffer_t::Options{.capacity = 16}));
+            edges.push_back(std::make_shared<edge::EdgeRingBufferWriter<int>>(buffers.back()));
+        }
+
+        std::vector<coroutines::Task<void>> tasks;
+        for (std::size_t i = 0; i < stage_count; ++i)
+        {
+            tasks.push_back(stage(read_all(buffers[i]), node::CoroWriter<int>(std::move(edges[i + 1]))));
+        }
+
+        tasks.push_back([](node::CoroWriter<int> output) -> coroutines::Task<void> {
+            for (int i = 0; i < ItemCount; ++i)
+            {
+                co_await output.write(int(i));
+            }
+        }(node::CoroWriter<int>(std::move(edges.front()))));
+
+        tasks.push_back([](coroutines::AsyncGenerator<int> input) -> coroutines::Task<void> {
+            auto iter = co_await input.begin();
+            while (iter != input.end())
+            {
+                benchmark::DoNotOptimize(*iter);
+                co_await ++iter;
+            }
+        }(read_all(buffers.back())));
+
+        coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+    }
+
+    state.SetItemsProcessed(state.iterations() * ItemCount * stage_count);
+}
+
+BENCHMARK(mrc_stage_chain_fibers)->Arg(1)->Arg(4)->Arg(16);
+BENCHMARK(mrc_stage_chain_coroutines)->Arg(1)->Arg(4)->Arg(16);
+
+// 1024 ints passed from the channel of an RxSink to its observer. StaticV sets the observer from its callable, which
+// keeps the subscription statically typed, otherwise the observer is type erased before it is set
+template <bool StaticV>
+static void mrc_rx_sink_observer(benchmark::State& state)
+{
+    constexpr int ItemCount = 1024;
+
+    auto on_next = [](int value) {
+        benchmark::DoNotOptimize(value);
+    };
+
+    for (auto _ : state)
+    {
+        FanOutSource<int> source;
+        SubscribedRxNode<node::RxSink<int>> sink;
+
+        if constexpr (StaticV)
+        {
+            sink.set_observer(on_next);
+        }
+        else
+        {
+            sink.set_observer(rxcpp::make_observer_dynamic<int>(on_next));
+        }
+
+        mrc::make_edge(source, sink);
+
+        boost::fibers::fiber producer([&source] {
+            for (int i = 0; i < ItemCount; ++i)
+            {
+                source.write(int(i));
+            }
+            source.complete();
+        });
+
+        sink.drain();
+        producer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * ItemCount);
+}
+
+// 1024 ints passed through a single map operator of an RxNode. StaticV builds the node with pipe(), otherwise with
+// make_stream(), which goes through the type erased observables and observer
+template <bool StaticV>
+static void mrc_rx_node_observer(benchmark::State& state)
+{
+    constexpr int ItemCount = 1024;
+
+    auto op = rxcpp::operators::map([](int value) {
+        return value + 1;
+    });
+
+    for (auto _ : state)
+    {
+        FanOutSource<int> source;
+        SubscribedRxNode<node::RxNode<int>> node;
+        DiscardSink<int> sink;
+
+        if constexpr (StaticV)
+        {
+            node.pipe(op);
+        }
+        else
+        {
+            node.make_stream([op](const rxcpp::observable<int>& input) {
+                return input | op;
+            });
+        }
+
+        mrc::make_edge(source, node);
+        mrc::make_edge(node, sink);
+
+        boost::fibers::fiber producer([&source] {
+            for (int i = 0; i < ItemCount; ++i)
+            {
+                source.write(int(i));
+            }
+            source.complete();
+        });
+
+        node.drain();
+        producer.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * ItemCount);
+}
+
+// per item cost of an RxNodeComponent with a single map operator, built with pipe() or with make_stream()
+template <bool StaticV>
+static void mrc_rx_node_component_observer(benchmark::State& state)
+{
+    auto op = rxcpp::operators::map([](int value) {
+        return value + 1;
+    });
+
+    FanOutSource<int> source;
+    node::RxNodeComponent<int, int> component;
+    DiscardSink<int> sink;
+
+    if constexpr (StaticV)
+    {
+        component.pipe(op);
+    }
+    else
+    {
+        component.make_stream([op](const rxcpp::observable<int>& input) {
+            return input | op;
+        });
+    }
+
+    mrc::make_edge(source, component);
+    mrc::make_edge(component, sink);
+
+    for (auto _ : state)
+    {
+        source.write(1);
+    }
+
+    source.complete();
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(mrc_rx_sink_observer, false);
+BENCHMARK_TEMPLATE(mrc_rx_sink_observer, true);
+BENCHMARK_TEMPLATE(mrc_rx_node_observer, false);
+BENCHMARK_TEMPLATE(mrc_rx_node_observer, true);
+BENCHMARK_TEMPLATE(mrc_rx_node_component_observer, false);
+BENCHMARK_TEMPLATE(mrc_rx_node_component_observer, true);
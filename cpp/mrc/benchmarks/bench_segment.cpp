@@ -234,8 +234,10 @@ class SimpleEmitReceiveFixture : public benchmark::Fixture
  * @tparam OneAtATimeV Indicates whether or not tracers should be sent through the segment one at a time. This can be
  * used to test the maximum raw throughput of each component.
  * @tparam InternalNodesV Number of internal stages the segment should have add.
+ * @tparam ComponentNodesV Build the internal stages with make_node_component rather than make_node. The segment builder
+ * fuses such a chain into a single observable chain.
  */
-template <class TracerTypeT, bool OneAtATimeV, std::size_t InternalNodesV>
+template <class TracerTypeT, bool OneAtATimeV, std::size_t InternalNodesV, bool ComponentNodesV = false>
 class LongEmitReceiveFixture : public benchmark::Fixture
 {
   public:
@@ -259,13 +261,28 @@ class LongEmitReceiveFixture : public benchmark::Fixture
             {
                 auto int_name     = "n" + std::to_string(i);
                 auto internal_idx = m_watcher->get_or_create_node_entry(int_name);
-                auto internal     = segment.make_node<data_type_t, data_type_t>(
-                    int_name,
-                    m_watcher->create_tracer_receive_tap(int_name),
-                    rxcpp::operators::map([](data_type_t tracer) {
-                        return tracer;
-                    }),
-                    m_watcher->create_tracer_emit_tap(int_name));
+
+                std::shared_ptr<segment::ObjectProperties> internal;
+                if constexpr (ComponentNodesV)
+                {
+                    internal = segment.make_node_component<data_type_t, data_type_t>(
+                        int_name,
+                        m_watcher->create_tracer_receive_tap(int_name),
+                        rxcpp::operators::map([](data_type_t tracer) {
+                            return tracer;
+                        }),
+                        m_watcher->create_tracer_emit_tap(int_name));
+                }
+                else
+                {
+                    internal = segment.make_node<data_type_t, data_type_t>(
+                        int_name,
+                        m_watcher->create_tracer_receive_tap(int_name),
+                        rxcpp::operators::map([](data_type_t tracer) {
+                            return tracer;
+                        }),
+                        m_watcher->create_tracer_emit_tap(int_name));
+                }
 
                 segment.make_edge(last_node, internal);
                 last_node = internal;
@@ -324,6 +341,14 @@ using throughput_tracer_2_t = TracerEnsemble<std::size_t, ThroughputTracer>;
 class SegmentLongComponentRawThroughput : public LongEmitReceiveFixture<throughput_tracer_2_t, true, InternalNodeCount>
 {};
 
+class SegmentLongRxComponentRawLatency
+  : public LongEmitReceiveFixture<latency_tracer_2_t, true, InternalNodeCount, true>
+{};
+
+class SegmentLongRxComponentRawThroughput
+  : public LongEmitReceiveFixture<throughput_tracer_2_t, true, InternalNodeCount, true>
+{};
+
 // NOLINTNEXTLINE
 BENCHMARK_F(RxcppManualLatency, rxcpp_manual_latency)(benchmark::State& state)
 {
@@ -409,3 +434,27 @@ BENCHMARK_F(SegmentLongComponentRawLatency, long_pipeline_component_latency)(ben
     }
     add_state_counters(m_watcher->aggregate_tracers(), state);
 }
+
+// NOLINTNEXTLINE
+BENCHMARK_F(SegmentLongRxComponentRawThroughput, long_pipeline_rx_component_throughput)(benchmark::State& state)
+{
+    m_watcher->tracer_count(1e4);
+    for (auto _ : state)
+    {
+        m_watcher->reset();
+        m_watcher->trace_until_notified();
+    }
+    add_state_counters(m_watcher->aggregate_tracers(), state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_F(SegmentLongRxComponentRawLatency, long_pipeline_rx_component_latency)(benchmark::State& state)
+{
+    m_watcher->tracer_count(1e4);
+    for (auto _ : state)
+    {
+        m_watcher->reset();
+        m_watcher->trace_until_notified();
+    }
+    add_state_counters(m_watcher->aggregate_tracers(), state);
+}
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::benchmarking {
+
+/**
+ * @brief Fixed size log-linear histogram of nanosecond latencies, in the spirit of HdrHistogram. Values below
+ * SubBucketCount are recorded exactly; every larger power of two is split into SubBucketCount linear sub-buckets, so
+ * the relative error of any reported value is bounded by 1 / SubBucketCount. Values at or above 2^MaxValueBits are
+ * clamped into the last bucket.
+ */
+class LatencyHistogram
+{
+  public:
+    static constexpr std::size_t SubBucketBits  = 3;
+    static constexpr std::size_t SubBucketCount = std::size_t(1) << SubBucketBits;
+    static constexpr std::size_t MaxValueBits   = 36;  // ~68.7 seconds
+    static constexpr std::size_t BucketCount    = SubBucketCount * (MaxValueBits - SubBucketBits + 1);
+
+    static constexpr std::size_t bucket_index(std::uint64_t value)
+    {
+        if (value < SubBucketCount)
+        {
+            return value;
+        }
+
+        if (value >= (std::uint64_t(1) << MaxValueBits))
+        {
+            return BucketCount - 1;
+        }
+
+        const std::size_t msb   = std::bit_width(value) - 1;
+        const std::size_t shift = msb - SubBucketBits;
+        const std::size_t sub   = (value >> shift) & (SubBucketCount - 1);
+
+        return SubBucketCount + shift * SubBucketCount + sub;
+    }
+
+    static constexpr std::uint64_t bucket_lower_bound(std::size_t index)
+    {
+        if (index < SubBucketCount)
+        {
+            return index;
+        }
+
+        const std::size_t shift = (index - SubBucketCount) / SubBucketCount;
+        const std::size_t sub   = (index - SubBucketCount) % SubBucketCount;
+
+        return (SubBucketCount + sub) << shift;
+    }
+
+    static constexpr std::uint64_t bucket_upper_bound(std::size_t index)
+    {
+        if (index < SubBucketCount)
+        {
+            return index;
+        }
+
+        const std::size_t shift = (index - SubBucketCount) / SubBucketCount;
+
+        return bucket_lower_bound(index) + (std::uint64_t(1) << shift) - 1;
+    }
+
+    void record(std::uint64_t value, std::uint64_t count = 1)
+    {
+        m_buckets[bucket_index(value)] += count;
+        m_count += count;
+    }
+
+    void add_to_bucket(std::size_t index, std::uint64_t count)
+    {
+        m_buckets[index] += count;
+        m_count += count;
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (std::size_t i = 0; i < BucketCount; ++i)
+        {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+    }
+
+    void clear()
+    {
+        m_buckets.fill(0);
+        m_count = 0;
+    }
+
+    std::uint64_t count() const
+    {
+        return m_count;
+    }
+
+    const std::array<std::uint64_t, BucketCount>& buckets() const
+    {
+        return m_buckets;
+    }
+
+    /**
+     * @brief Value at or below which the requested fraction of recorded values fall, reported as the upper bound of
+     * the bucket containing it.
+     * @param quantile Fraction in [0, 1], e.g. 0.99 for the 99th percentile.
+     * @return Latency in nanoseconds, or 0 if the histogram is empty.
+     */
+    std::uint64_t percentile(double quantile) const
+    {
+        if (m_count == 0)
+        {
+            return 0;
+        }
+
+        quantile = std::clamp(quantile, 0.0, 1.0);
+        auto target =
+            std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(m_count))));
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += m_buckets[i];
+            if (seen >= target)
+            {
+                return bucket_upper_bound(i);
+            }
+        }
+
+        return bucket_upper_bound(BucketCount - 1);
+    }
+
+  private:
+    std::array<std::uint64_t, BucketCount> m_buckets{};
+    std::uint64_t m_count{0};
+};
+
+}  // namespace mrc::benchmarking
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,14 +17,15 @@
 
 #pragma once
 
+#include "mrc/benchmarking/latency_histogram.hpp"
 #include "mrc/benchmarking/util.hpp"
 #include "mrc/core/watcher.hpp"
 
 #include <nlohmann/json_fwd.hpp>
 
-#include <array>
+#include <atomic>
 #include <cstddef>  // for size_t
-#include <functional>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -35,35 +36,43 @@
 namespace mrc::benchmarking {
 
 /**
- * @brief Class used to store statistics gathered from internal nodes via watcher interfaces. The class consists
- * of various static elements that allow for a consistent global view + aggregation of thread local storage elements
- * which keep track of statistics on a per thread basis.
+ * @brief Class used to store statistics gathered from internal nodes via watcher interfaces. There is one
+ * TraceStatistics object per unique name; each is assigned a dense integer id when it is registered, and the
+ * counters themselves live in per-thread shards indexed by that id. Watcher callbacks only ever touch the calling
+ * thread's shard, so recording is wait-free, while aggregation merges every shard under per-slot seqlocks without
+ * stopping the writers.
+ *
+ * Start timestamps (read, write and operator chain) are stored in the shard of the thread that observed the entry
+ * event and read back from the shard of the thread that observes the matching exit event. No attempt is made to
+ * detect a fiber that migrates between threads in the middle of an event (only possible when the node is launched
+ * with LaunchOptions::allow_work_sharing); the exit is then measured against whatever start time the new thread last
+ * recorded for that node, so the latencies of work sharing nodes are not meaningful. Counts are unaffected.
  */
 class TraceStatistics : public WatcherInterface
 {
-    // Thread local map to store a name-unique per-thread TraceStatistics struct.
-    thread_local static std::map<std::string, std::shared_ptr<TraceStatistics>> TraceObjectMap;
-
-    // Multi-map containing a shared pointer to all TraceStatistics structures across all thread_local storage.
-    // Primarily used to aggregate statistics across threads without blocking or having to run per-thread routines.
+    // Multi-map containing a shared pointer to every registered TraceStatistics object, one per unique name.
+    // Registration, reset and aggregation take s_state_mutex; the watcher callbacks never do.
     static std::multimap<std::string, std::shared_ptr<TraceStatistics>> TraceObjectMultimap;
     static std::recursive_mutex s_state_mutex;
+    static std::size_t s_next_id;
 
-    // Performance optimization that assigns an initial number of 'slots' for watcher entrypoint handling. Slot count
-    // should be greater than or equal to the number of WatchableEvents
-    static constexpr std::size_t MaxSlotsV = 10;
-
-    static bool s_trace_operators;
+    static std::atomic<bool> s_trace_operators;
     static bool s_trace_operators_set_manually;
 
-    static bool s_trace_channels;
+    static std::atomic<bool> s_trace_channels;
     static bool s_trace_channels_set_manually;
 
+    // Bumped by reset; per-thread counters written under an older epoch are treated as zero.
+    static std::atomic<std::uint64_t> s_epoch;
+
     static bool s_initialized;
 
     static void init();
 
   public:
+    // Upper bound on the number of uniquely named TraceStatistics objects
+    static constexpr std::size_t MaxNodes = 8192;
+
     /**
      * @brief Aggregate statistics across all running stats aware elements.
      * @return Return the aggregated statistics in json format.
@@ -71,19 +80,17 @@ class TraceStatistics : public WatcherInterface
     static nlohmann::json aggregate();
 
     /**
-     * @brief (Threadsafe) Retrieve the thread local stats object associated with a given unique name or create a new
-     * one if it does not exist. Its worth noting that the TraceStatistics object retrived is not explicitly thread
-     * local -- rather, the map associating uniquely named TraceStatistics objects for each thread is thread-local.
+     * @brief (Threadsafe) Retrieve the stats object associated with a given unique name or create and register a
+     * new one if it does not exist. The returned object may be shared by watchers running on any thread.
      * @param name Name of the uniquely identified stats object.
-     * @return Shared pointer to the thread local stats object.
+     * @return Shared pointer to the stats object.
      */
     static std::shared_ptr<TraceStatistics> get_or_create(const std::string& name);
 
     /**
-     * @brief Retrieve a multi-map containing pointers to all thread local TraceStatistics objects. Can be used for
+     * @brief Retrieve a multi-map containing pointers to all registered TraceStatistics objects. Can be used for
      * custom aggregation.
-     * @return Multi-map where the multiplicity of each entry will be equal to the number of unique threads which
-     * have called 'get_or_create'.
+     * @return Multi-map with exactly one entry per name passed to 'get_or_create'.
      */
     [[maybe_unused]] static const std::multimap<std::string, std::shared_ptr<TraceStatistics>>&
     get_thread_local_results_map();
@@ -129,61 +136,37 @@ class TraceStatistics : public WatcherInterface
     TraceStatistics(const TraceStatistics&) = delete;
     TraceStatistics(TraceStatistics&&)      = delete;
 
-    nlohmann::json to_json() const;
-
-    /**
-     * @brief Watcher interface override.
-     */
-    void on_entry(const WatchableEvent& e, const void* data) override;
-
-    /**
-     * @brief Watcher interface override.
-     */
-    void on_exit(const WatchableEvent& e, bool rc, const void* data) override;
-
-  private:
-    TraceStatistics(const std::string& name);
-
-    /**
-     * @brief Entry point for channel event.
-     */
-    void channel_read_end();
-
     /**
-     * @brief Entry point for channel event.
+     * @brief Snapshot of this object's statistics merged across all threads. Safe to call while the node is running.
      */
-    void channel_read_start();
+    nlohmann::json to_json() const;
 
     /**
-     * @brief Entry point for channel event.
+     * @brief Dense id assigned at registration, used to index the per-thread shards.
      */
-    void channel_write_end();
+    std::size_t id() const;
 
-    /**
-     * @brief Entry point for channel event.
-     */
-    void channel_write_start();
+    const std::string& name() const;
 
     /**
-     * @brief clear all counters on this stats object.
+     * @brief Merged histograms of the per-element latencies recorded since the last reset, in nanoseconds.
      */
-    void clear();
+    LatencyHistogram operator_latency_histogram() const;
+    LatencyHistogram channel_read_latency_histogram() const;
+    LatencyHistogram channel_write_latency_histogram() const;
 
     /**
-     * @brief Data emission handler -- called when an node emits a data element to its source output.
+     * @brief Watcher interface override.
      */
-    void emit();
+    void on_entry(const WatchableEvent& e, const void* data) override;
 
     /**
-     * @brief Initializes the lookup tables for WatchableEvent handlers. These will be set to no-ops if
-     * the related tracing flags are false, or the handling implementation otherwise.
+     * @brief Watcher interface override.
      */
-    void initialize_lookup_tables();
+    void on_exit(const WatchableEvent& e, bool rc, const void* data) override;
 
-    /**
-     * @brief Data receive handler -- called when an node pulls data from it's sink a data element to its source output.
-     */
-    void receive();
+  private:
+    TraceStatistics(std::string name, std::size_t id);
 
     /**
      * Thread ID where this stats object is created.
@@ -191,24 +174,11 @@ class TraceStatistics : public WatcherInterface
      */
     std::thread::id parent_id() const;
 
-    const std::string& m_name;
+    const std::string m_name;
+    const std::size_t m_id;
     const std::thread::id m_parent_id;
 
-    TimeUtil::time_pt_t m_start_time;
-    TimeUtil::time_pt_t m_internal_chain_start;
-    TimeUtil::time_pt_t m_channel_read_start;
-    TimeUtil::time_pt_t m_channel_write_start;
-
-    std::size_t m_emission_count{0};
-    std::size_t m_receive_count{0};
-    std::size_t m_channel_sink_reads{0};
-    std::size_t m_channel_source_writes{0};
-    std::size_t m_total_internal_elapsed_ns{0};
-    std::size_t m_total_ch_read_elapsed_ns{0};
-    std::size_t m_total_ch_write_elapsed_ns{0};
-
-    std::array<std::function<void(void)>, MaxSlotsV> m_entry_lookup_table;
-    std::array<std::function<void(void)>, MaxSlotsV> m_exit_lookup_table;
+    std::atomic<TimeUtil::time_pt_t> m_start_time;
 };
 
 }  // namespace mrc::benchmarking
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -22,6 +22,10 @@
 #include <boost/fiber/buffered_channel.hpp>
 #include <boost/fiber/channel_op_status.hpp>
 
+#include <cstddef>
+#include <span>
+#include <vector>
+
 namespace mrc::channel {
 
 template <typename T>
@@ -34,13 +38,35 @@ class BufferedChannel final : public Channel<T>
     ~BufferedChannel() final = default;
 
   private:
+    // Each blocking operation first attempts its non-blocking counterpart so the wait timer, and the clock, are only
+    // involved when the channel is actually full or empty
     inline Status do_await_write(T&& val) final
     {
+        auto rc = m_channel.try_push(std::move(val));
+
+        if (rc != status_t::full)
+        {
+            return status(rc);
+        }
+
+        auto timer = this->mutable_telemetry().writer_wait();
+        timer.start();
+
         return status(m_channel.push(std::move(val)));
     }
 
     inline Status do_await_read(T& val) final
     {
+        auto rc = m_channel.try_pop(std::ref(val));
+
+        if (rc != status_t::empty)
+        {
+            return status(rc);
+        }
+
+        auto timer = this->mutable_telemetry().reader_wait();
+        timer.start();
+
         return status(m_channel.pop(std::ref(val)));
     }
 
@@ -51,9 +77,56 @@ class BufferedChannel final : public Channel<T>
 
     Status do_await_read_until(T& val, const time_point_t& deadline) final
     {
+        auto rc = m_channel.try_pop(std::ref(val));
+
+        if (rc != status_t::empty)
+        {
+            return status(rc);
+        }
+
+        auto timer = this->mutable_telemetry().reader_wait();
+        timer.start();
+
         return status(m_channel.pop_wait_until(std::ref(val), deadline));
     }
 
+    Status do_await_write_n(std::span<T> data) final
+    {
+        for (auto& item : data)
+        {
+            auto rc = do_await_write(std::move(item));
+
+            if (rc != Status::success)
+            {
+                return rc;
+            }
+        }
+
+        return Status::success;
+    }
+
+    Status do_await_read_n(std::vector<T>& data, std::size_t max_count) final
+    {
+        T item;
+        auto rc = do_await_read(item);
+
+        if (rc != Status::success)
+        {
+            return rc;
+        }
+
+        const auto end_size = data.size() + max_count;
+
+        data.push_back(std::move(item));
+
+        while (data.size() < end_size && m_channel.try_pop(std::ref(item)) == status_t::success)
+        {
+            data.push_back(std::move(item));
+        }
+
+        return Status::success;
+    }
+
     void do_close_channel() final
     {
         m_channel.close();
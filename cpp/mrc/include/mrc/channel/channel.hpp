@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,10 +20,14 @@
 #include "mrc/channel/egress.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/status.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/channel/types.hpp"
 #include "mrc/core/watcher.hpp"
 
 #include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
 
 namespace mrc::channel {
 
@@ -32,7 +36,39 @@ void set_default_channel_size(std::size_t default_size);
 
 struct ChannelBase
 {
+    ChannelBase() : m_telemetry(std::make_shared<ChannelTelemetry>()) {}
     virtual ~ChannelBase() = 0;
+
+    /**
+     * @brief Occupancy and backpressure counters of this channel. The telemetry is shared so it can be reported after
+     * the channel itself has been moved into an edge or destroyed.
+     */
+    std::shared_ptr<const ChannelTelemetry> telemetry() const
+    {
+        return m_telemetry;
+    }
+
+    ChannelStats stats() const
+    {
+        return m_telemetry->stats();
+    }
+
+    /**
+     * @brief True if the channel is only safe to use with exactly one writer and one reader at a time
+     */
+    virtual bool is_single_producer_single_consumer() const
+    {
+        return false;
+    }
+
+  protected:
+    ChannelTelemetry& mutable_telemetry()
+    {
+        return *m_telemetry;
+    }
+
+  private:
+    std::shared_ptr<ChannelTelemetry> m_telemetry;
 };
 
 /**
@@ -71,6 +107,9 @@ class Channel : public Ingress<T>, public Egress<T>, public Watchable, public Ch
     Status await_read_until(T& t, const time_point_t& tp) final;
     Status try_read(T& t) final;
 
+    Status await_write_n(std::span<T> data) final;
+    Status await_read_n(std::vector<T>& data, std::size_t max_count) final;
+
     void close_channel();
     bool is_channel_closed() const;
 
@@ -83,6 +122,11 @@ class Channel : public Ingress<T>, public Egress<T>, public Watchable, public Ch
 
     virtual void do_close_channel()           = 0;
     virtual bool do_is_channel_closed() const = 0;
+
+    // Batched variants. The defaults are built on the single item methods above; implementations which can move a
+    // batch with a single synchronization point should override them.
+    virtual Status do_await_write_n(std::span<T> data);
+    virtual Status do_await_read_n(std::vector<T>& data, std::size_t max_count);
 };
 
 template <typename T>
@@ -90,6 +134,10 @@ inline Status Channel<T>::await_write(T&& t)
 {
     WATCHER_PROLOGUE(WatchableEvent::channel_write);
     auto rc = do_await_write(std::move(t));
+    if (rc == Status::success)
+    {
+        this->mutable_telemetry().record_write(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_write, rc == Status::success);
     return rc;
 }
@@ -99,6 +147,10 @@ inline Status Channel<T>::await_read(T& t)
 {
     WATCHER_PROLOGUE(WatchableEvent::channel_read);
     auto rc = do_await_read(t);
+    if (rc == Status::success)
+    {
+        this->mutable_telemetry().record_read(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
     return rc;
 }
@@ -108,6 +160,10 @@ inline Status Channel<T>::await_read_until(T& t, const time_point_t& tp)
 {
     WATCHER_PROLOGUE(WatchableEvent::channel_read);
     auto rc = do_await_read_until(t, tp);
+    if (rc == Status::success)
+    {
+        this->mutable_telemetry().record_read(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
     return rc;
 }
@@ -117,10 +173,80 @@ inline Status Channel<T>::try_read(T& t)
 {
     WATCHER_PROLOGUE(WatchableEvent::channel_read);
     auto rc = do_try_read(t);
+    if (rc == Status::success)
+    {
+        this->mutable_telemetry().record_read(1);
+    }
     WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
     return rc;
 }
 
+template <typename T>
+Status Channel<T>::await_write_n(std::span<T> data)
+{
+    WATCHER_PROLOGUE(WatchableEvent::channel_write);
+    auto rc = do_await_write_n(data);
+    if (rc == Status::success)
+    {
+        this->mutable_telemetry().record_write(data.size());
+    }
+    WATCHER_EPILOGUE(WatchableEvent::channel_write, rc == Status::success);
+    return rc;
+}
+
+template <typename T>
+Status Channel<T>::await_read_n(std::vector<T>& data, std::size_t max_count)
+{
+    WATCHER_PROLOGUE(WatchableEvent::channel_read);
+    const auto start_size = data.size();
+    auto rc               = do_await_read_n(data, max_count);
+    if (data.size() > start_size)
+    {
+        this->mutable_telemetry().record_read(data.size() - start_size);
+    }
+    WATCHER_EPILOGUE(WatchableEvent::channel_read, rc == Status::success);
+    return rc;
+}
+
+template <typename T>
+Status Channel<T>::do_await_write_n(std::span<T> data)
+{
+    for (auto& item : data)
+    {
+        auto rc = do_await_write(std::move(item));
+
+        if (rc != Status::success)
+        {
+            return rc;
+        }
+    }
+
+    return Status::success;
+}
+
+template <typename T>
+Status Channel<T>::do_await_read_n(std::vector<T>& data, std::size_t max_count)
+{
+    T item;
+    auto rc = do_await_read(item);
+
+    if (rc != Status::success)
+    {
+        return rc;
+    }
+
+    const auto end_size = data.size() + max_count;
+
+    data.push_back(std::move(item));
+
+    while (data.size() < end_size && do_try_read(item) == Status::success)
+    {
+        data.push_back(std::move(item));
+    }
+
+    return Status::success;
+}
+
 template <typename T>
 inline void Channel<T>::close_channel()
 {
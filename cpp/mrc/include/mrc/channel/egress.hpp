@@ -20,6 +20,9 @@
 #include "mrc/channel/status.hpp"
 #include "mrc/channel/types.hpp"
 
+#include <cstddef>
+#include <vector>
+
 namespace mrc::channel {
 
 /**
@@ -35,6 +38,35 @@ struct Egress
     virtual Status await_read(T&)                            = 0;
     virtual Status await_read_until(T&, const time_point_t&) = 0;
     virtual Status try_read(T&)                              = 0;
+
+    /**
+     * @brief Block until at least one item is available, then append up to `max_count` (> 0) items which are
+     * immediately available to `data` without blocking further. Returns Status::success if at least one item was
+     * appended.
+     *
+     * The default implementation performs one `await_read` followed by `try_read` calls.
+     */
+    virtual Status await_read_n(std::vector<T>& data, std::size_t max_count)
+    {
+        T item;
+        auto rc = await_read(item);
+
+        if (rc != Status::success)
+        {
+            return rc;
+        }
+
+        const auto end_size = data.size() + max_count;
+
+        data.push_back(std::move(item));
+
+        while (data.size() < end_size && try_read(item) == Status::success)
+        {
+            data.push_back(std::move(item));
+        }
+
+        return Status::success;
+    }
 };
 
 }  // namespace mrc::channel
@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/recent_channel.hpp"
+#include "mrc/channel/ring_channel.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace mrc::channel {
+
+/**
+ * @brief Selects the Channel implementation backing an edge.
+ *
+ * buffered  - BufferedChannel, the default for all sinks and sources
+ * recent    - RecentChannel, drops the oldest item when full instead of blocking the writer
+ * ring_spsc - RingChannel<T, RingChannelMode::spsc>, only valid with exactly one writer and one reader
+ * ring_mpmc - RingChannel<T, RingChannelMode::mpmc>
+ */
+enum class ChannelType
+{
+    buffered,
+    recent,
+    ring_spsc,
+    ring_mpmc,
+};
+
+template <typename T>
+std::unique_ptr<Channel<T>> make_channel(ChannelType type, std::size_t buffer_size = default_channel_size())
+{
+    switch (type)
+    {
+    case ChannelType::buffered:
+        return std::make_unique<BufferedChannel<T>>(buffer_size);
+    case ChannelType::recent:
+        return std::make_unique<RecentChannel<T>>(buffer_size);
+    case ChannelType::ring_spsc:
+        return std::make_unique<RingChannel<T, RingChannelMode::spsc>>(buffer_size);
+    case ChannelType::ring_mpmc:
+        return std::make_unique<RingChannel<T, RingChannelMode::mpmc>>(buffer_size);
+    }
+
+    throw std::invalid_argument("Unknown ChannelType");
+}
+
+}  // namespace mrc::channel
@@ -41,4 +41,9 @@ class RecentChannel;
 template <typename T>
 class NullChannel;
 
+enum class RingChannelMode;
+
+template <typename T, RingChannelMode ModeT>
+class RingChannel;
+
 }  // namespace mrc::channel
@@ -19,6 +19,7 @@
 
 #include "mrc/channel/status.hpp"
 
+#include <span>
 #include <type_traits>  // IWYU pragma: export
 #include <utility>
 
@@ -44,6 +45,28 @@ struct Ingress : public IngressHandle
 
     virtual Status await_write(T&&) = 0;
 
+    /**
+     * @brief Write all items in `data`, in order, moving each element out of the span. Blocks as needed. Returns the
+     * first non-success status, at which point the remaining elements have not been written.
+     *
+     * The default implementation calls `await_write` for each element; implementations should override this to
+     * amortize synchronization across the batch.
+     */
+    virtual Status await_write_n(std::span<T> data)
+    {
+        for (auto& item : data)
+        {
+            auto rc = await_write(std::move(item));
+
+            if (rc != Status::success)
+            {
+                return rc;
+            }
+        }
+
+        return Status::success;
+    }
+
     // If the above overload cannot be matched, copy by value and move into the await_write(T&&) overload. This is only
     // necessary for lvalues. The template parameters give it lower priority in overload resolution.
     template <typename TT = T, typename = std::enable_if_t<std::is_copy_constructible_v<TT>>>
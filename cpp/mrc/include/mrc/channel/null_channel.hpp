@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,7 +20,10 @@
 #include "mrc/channel/channel.hpp"
 #include "mrc/types.hpp"  // for Mutex & CondV
 
+#include <cstddef>
 #include <memory>  // for lock_guard
+#include <span>
+#include <vector>
 
 namespace mrc::channel {
 
@@ -37,12 +40,15 @@ class NullChannel : public Channel<T>
         {
             return Status::closed;
         }
+        this->mutable_telemetry().record_drop(1);
         return Status::success;
     }
 
     Status do_await_read(T& t) override
     {
         std::unique_lock<Mutex> lock(m_mutex);
+        auto timer = this->mutable_telemetry().reader_wait();
+        timer.start();
         m_cv.wait(lock, [this] {
             return m_is_shutdown;
         });
@@ -57,12 +63,35 @@ class NullChannel : public Channel<T>
     Status do_await_read_until(T& t, const time_point_t& deadline) override
     {
         std::unique_lock<Mutex> lock(m_mutex);
+        auto timer = this->mutable_telemetry().reader_wait();
+        timer.start();
         m_cv.wait_until(lock, deadline, [this] {
             return m_is_shutdown;
         });
         return (m_is_shutdown ? Status::closed : Status::timeout);
     }
 
+    Status do_await_write_n(std::span<T> data) override
+    {
+        if (m_is_shutdown)
+        {
+            return Status::closed;
+        }
+        this->mutable_telemetry().record_drop(data.size());
+        return Status::success;
+    }
+
+    Status do_await_read_n(std::vector<T>& /*data*/, std::size_t /*max_count*/) override
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+        auto timer = this->mutable_telemetry().reader_wait();
+        timer.start();
+        m_cv.wait(lock, [this] {
+            return m_is_shutdown;
+        });
+        return Status::closed;
+    }
+
     void do_close_channel() override
     {
         std::lock_guard<Mutex> lock(m_mutex);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,114 +20,346 @@
 #include "mrc/channel/channel.hpp"
 #include "mrc/types.hpp"  // for CondV & Mutex
 
-#include <boost/fiber/mutex.hpp>
+#include <boost/fiber/operations.hpp>
 
+#include <atomic>
 #include <cstddef>  // for size_t
-#include <deque>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <thread>  // for lock_guard & unique_lock
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace mrc::channel {
 
+/**
+ * @brief Bounded channel which never blocks writers; when full, the oldest item is discarded to make room.
+ *
+ * Items are stored in a fixed ring of slots allocated on construction, so the steady state performs no allocation.
+ * Each slot carries a sequence number (the bounded MPMC queue described by Dmitry Vyukov) which lets writers and
+ * readers claim slots with a single CAS. A writer which finds the ring full claims the oldest slot exactly as a reader
+ * would and destroys its item, so overwriting is lock-free and safe against concurrent readers. Readers only take the
+ * mutex to park when the ring is empty.
+ *
+ * Every discarded item is counted in stats().dropped. After the channel is closed writes fail immediately and reads
+ * continue to drain the remaining items before reporting Status::closed.
+ *
+ * @tparam T
+ */
 template <typename T>
 class RecentChannel : public Channel<T>
 {
+    static constexpr std::size_t CacheLineSize = 64;
+
   public:
-    RecentChannel(std::size_t count = default_channel_size()) : m_max_size(count) {}
-    ~RecentChannel() override = default;
+    RecentChannel(std::size_t count = default_channel_size()) :
+      m_capacity(count),
+      m_slots(std::make_unique<Slot[]>(count))
+    {
+        if (count == 0)
+        {
+            throw std::invalid_argument("RecentChannel count must be greater than 0.");
+        }
+
+        for (std::size_t i = 0; i < m_capacity; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~RecentChannel() override
+    {
+        // Destroy any items which were written but never read
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        for (auto pos = m_head.load(std::memory_order_acquire); pos != tail; ++pos)
+        {
+            m_slots[pos % m_capacity].ptr()->~T();
+        }
+    }
+
+    /**
+     * @brief Number of most recent items retained before the oldest are dropped
+     */
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
 
   private:
-    Status do_await_write(T&& data) override
+    // Number of times an empty reader will yield the fiber before parking on the condition variable
+    static constexpr std::size_t YieldCount = 8;
+
+    struct Slot
     {
-        std::lock_guard<Mutex> lock(m_mutex);
-        if (m_is_shutdown)
+        alignas(T) std::byte storage[sizeof(T)];  // NOLINT
+        std::atomic<std::size_t> sequence{0};
+
+        T* ptr()
         {
-            return Status::closed;
+            return std::launder(reinterpret_cast<T*>(storage));  // NOLINT
         }
-        if (m_deque.size() >= m_max_size)
+    };
+
+    Status do_await_write(T&& data) override
+    {
+        if (m_is_closed.load(std::memory_order_acquire))
         {
-            m_deque.pop_front();
+            return Status::closed;
         }
-        m_deque.push_back(std::move(data));
-        m_cv.notify_one();
+
+        push_overwrite(std::move(data));
+        notify_readers(false);
+
         return Status::success;
     }
 
     Status do_await_read(T& data) override
     {
-        std::unique_lock<Mutex> lock(m_mutex);
-        while (m_deque.empty() && !m_is_shutdown)
+        return await_read_impl(data, nullptr);
+    }
+
+    Status do_try_read(T& data) override
+    {
+        if (try_pop(&data))
         {
-            m_cv.wait(lock, [this] {
-                return m_is_shutdown || !m_deque.empty();
-            });
+            return Status::success;
         }
-        if (m_is_shutdown)
+
+        return m_is_closed.load(std::memory_order_acquire) ? Status::closed : Status::empty;
+    }
+
+    Status do_await_read_until(T& data, const time_point_t& deadline) override
+    {
+        return await_read_impl(data, &deadline);
+    }
+
+    Status do_await_write_n(std::span<T> data) override
+    {
+        if (m_is_closed.load(std::memory_order_acquire))
         {
             return Status::closed;
         }
-        data = std::move(m_deque.front());
-        m_deque.pop_front();
+
+        for (auto& item : data)
+        {
+            push_overwrite(std::move(item));
+        }
+
+        if (!data.empty())
+        {
+            notify_readers(data.size() > 1);
+        }
+
         return Status::success;
     }
 
-    Status do_try_read(T& data) override
+    Status do_await_read_n(std::vector<T>& data, std::size_t max_count) override
     {
-        std::unique_lock<Mutex> lock(m_mutex);
-        if (m_is_shutdown)
+        T item;
+        auto rc = await_read_impl(item, nullptr);
+
+        if (rc != Status::success)
         {
-            return Status::closed;
+            return rc;
         }
-        if (m_deque.empty())
+
+        data.push_back(std::move(item));
+
+        for (std::size_t popped = 1; popped < max_count && try_pop(&item); ++popped)
         {
-            return Status::empty;
+            data.push_back(std::move(item));
         }
-        data = std::move(m_deque.front());
-        m_deque.pop_front();
+
         return Status::success;
     }
 
-    Status do_await_read_until(T& data, const time_point_t& deadline) override
+    void do_close_channel() override
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+
+        m_is_closed.store(true, std::memory_order_release);
+        m_not_empty.notify_all();
+    }
+
+    bool do_is_channel_closed() const override
+    {
+        return m_is_closed.load(std::memory_order_acquire);
+    }
+
+    Status await_read_impl(T& data, const time_point_t* deadline)
     {
+        auto timer = this->mutable_telemetry().reader_wait();
+
+        for (std::size_t i = 0; i < YieldCount; ++i)
+        {
+            if (try_pop(&data))
+            {
+                return Status::success;
+            }
+
+            // Only report closed once the ring has been drained
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            timer.start();
+            boost::this_fiber::yield();
+        }
+
         std::unique_lock<Mutex> lock(m_mutex);
 
-        while (m_deque.empty() && !m_is_shutdown && deadline < clock_t::now())
+        m_waiting_readers.fetch_add(1, std::memory_order_seq_cst);
+
+        while (true)
         {
-            m_cv.wait_until(lock, deadline, [this] {
-                return m_is_shutdown || !m_deque.empty();
-            });
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (try_pop(&data))
+            {
+                m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                return Status::success;
+            }
+
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                return Status::closed;
+            }
+
+            if (deadline == nullptr)
+            {
+                m_not_empty.wait(lock);
+            }
+            else if (m_not_empty.wait_until(lock, *deadline) == boost::fibers::cv_status::timeout)
+            {
+                // One final attempt since an item may have landed between the timeout and reacquiring the lock
+                m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                return try_pop(&data) ? Status::success : Status::timeout;
+            }
         }
-        if (m_is_shutdown)
+    }
+
+    // Pairs with the seq_cst fence executed by a parking reader after incrementing m_waiting_readers, see RingChannel
+    void notify_readers(bool notify_all)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (m_waiting_readers.load(std::memory_order_relaxed) > 0)
         {
-            return Status::closed;
+            std::lock_guard<Mutex> lock(m_mutex);
+
+            if (notify_all)
+            {
+                m_not_empty.notify_all();
+            }
+            else
+            {
+                m_not_empty.notify_one();
+            }
         }
-        if (m_deque.empty())
+    }
+
+    void push_overwrite(T&& data)
+    {
+        while (!try_push(std::move(data)))
         {
-            return Status::timeout;
+            // Full; discard the oldest item. This can fail if a reader took it first, in which case there is now room
+            if (try_pop(nullptr))
+            {
+                this->mutable_telemetry().record_drop(1);
+            }
         }
-        data = std::move(m_deque.front());
-        m_deque.pop_front();
-        return Status::success;
     }
 
-    void do_close_channel() override
+    bool try_push(T&& data)
     {
-        std::lock_guard<Mutex> lock(m_mutex);
-        m_is_shutdown = true;
-        m_cv.notify_all();
+        auto pos = m_tail.load(std::memory_order_relaxed);
+        Slot* slot{nullptr};
+
+        while (true)
+        {
+            slot           = &m_slots[pos % m_capacity];
+            const auto seq = slot->sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (dif == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (slot->storage) T(std::move(data));
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
     }
 
-    bool do_is_channel_closed() const override
+    // Moves the oldest item into data, or destroys it if data is nullptr
+    bool try_pop(T* data)
     {
-        std::lock_guard<Mutex> lock(m_mutex);
-        return m_is_shutdown;
+        auto pos = m_head.load(std::memory_order_relaxed);
+        Slot* slot{nullptr};
+
+        while (true)
+        {
+            slot           = &m_slots[pos % m_capacity];
+            const auto seq = slot->sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+            if (dif == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (dif < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        auto* item = slot->ptr();
+        if (data != nullptr)
+        {
+            *data = std::move(*item);
+        }
+        item->~T();
+        slot->sequence.store(pos + m_capacity, std::memory_order_release);
+
+        return true;
     }
 
+    const std::size_t m_capacity;
+    std::unique_ptr<Slot[]> m_slots;  // NOLINT
+
+    alignas(CacheLineSize) std::atomic<std::size_t> m_tail{0};
+    alignas(CacheLineSize) std::atomic<std::size_t> m_head{0};
+
+    // Slow path state, only touched when the ring is empty or being closed
+    alignas(CacheLineSize) std::atomic<bool> m_is_closed{false};
+    std::atomic<std::size_t> m_waiting_readers{0};
     mutable Mutex m_mutex;
-    CondV m_cv;
-    bool m_is_shutdown{false};
-    std::size_t m_max_size;
-    std::deque<T> m_deque;
+    CondV m_not_empty;
 };
 
 }  // namespace mrc::channel
@@ -0,0 +1,526 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/types.hpp"  // for CondV & Mutex
+
+#include <boost/fiber/operations.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mrc::channel {
+
+/**
+ * @brief Concurrency contract of a RingChannel.
+ *
+ * spsc - exactly one writer and one reader may access the channel concurrently. Use this for edges between a single
+ *        upstream and a sink with a single progress engine.
+ * mpmc - any number of writers and readers.
+ */
+enum class RingChannelMode
+{
+    spsc,
+    mpmc,
+};
+
+namespace detail {
+
+// Fixed at 64 rather than std::hardware_destructive_interference_size which is not ABI stable across compilers
+inline constexpr std::size_t ring_channel_cache_line_size = 64;
+
+}  // namespace detail
+
+/**
+ * @brief Bounded lock-free ring buffer implementation of Channel.
+ *
+ * Reads and writes which can be satisfied immediately never take a lock; the head and tail counters each live on
+ * their own cache line. Only when the ring is full (writers) or empty (readers) does the caller park itself on a fiber
+ * condition variable, and the opposite side only touches the mutex when it observes a parked waiter.
+ *
+ * The RingChannelMode selects the ring algorithm at compile time. The spsc variant uses plain head/tail counters with
+ * cached copies of the opposing index, the mpmc variant uses per-slot sequence numbers.
+ *
+ * Like BufferedChannel, after the channel is closed writes fail immediately and reads continue to drain the remaining
+ * items before reporting Status::closed.
+ *
+ * @tparam T
+ * @tparam ModeT
+ */
+template <typename T, RingChannelMode ModeT = RingChannelMode::mpmc>
+class RingChannel final : public Channel<T>
+{
+    static constexpr std::size_t CacheLineSize = detail::ring_channel_cache_line_size;
+
+  public:
+    RingChannel(std::size_t buffer_size = default_channel_size()) :
+      m_capacity(buffer_size),
+      m_mask(buffer_size - 1),
+      m_slots(std::make_unique<Slot[]>(buffer_size))
+    {
+        if (buffer_size < 2 || ((buffer_size & (buffer_size - 1)) != 0))
+        {
+            throw std::invalid_argument("RingChannel buffer_size must be greater than 1 and a power of 2.");
+        }
+
+        if constexpr (ModeT == RingChannelMode::mpmc)
+        {
+            for (std::size_t i = 0; i < m_capacity; ++i)
+            {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            this->mutable_telemetry().set_single_producer_single_consumer();
+        }
+    }
+
+    ~RingChannel() final
+    {
+        // Destroy any items which were written but never read
+        const auto tail = m_tail.load(std::memory_order_acquire);
+        for (auto pos = m_head.load(std::memory_order_acquire); pos != tail; ++pos)
+        {
+            m_slots[pos & m_mask].ptr()->~T();
+        }
+    }
+
+    /**
+     * @brief Number of items the ring can hold before writers block
+     */
+    std::size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    bool is_single_producer_single_consumer() const final
+    {
+        return ModeT == RingChannelMode::spsc;
+    }
+
+  private:
+    // Number of times a blocked reader or writer will yield the fiber before parking on the condition variable
+    static constexpr std::size_t YieldCount = 8;
+
+    struct Slot
+    {
+        alignas(T) std::byte storage[sizeof(T)];  // NOLINT
+        std::atomic<std::size_t> sequence{0};
+
+        T* ptr()
+        {
+            return std::launder(reinterpret_cast<T*>(storage));  // NOLINT
+        }
+    };
+
+    Status do_await_write(T&& val) final
+    {
+        auto timer = this->mutable_telemetry().writer_wait();
+
+        for (std::size_t i = 0; i < YieldCount; ++i)
+        {
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                return Status::closed;
+            }
+
+            if (try_push(std::move(val)))
+            {
+                notify_waiters(m_waiting_readers, m_not_empty);
+                return Status::success;
+            }
+
+            timer.start();
+            boost::this_fiber::yield();
+        }
+
+        std::unique_lock<Mutex> lock(m_mutex);
+
+        m_waiting_writers.fetch_add(1, std::memory_order_seq_cst);
+
+        while (true)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                m_waiting_writers.fetch_sub(1, std::memory_order_relaxed);
+                return Status::closed;
+            }
+
+            if (try_push(std::move(val)))
+            {
+                m_waiting_writers.fetch_sub(1, std::memory_order_relaxed);
+                lock.unlock();
+
+                notify_waiters(m_waiting_readers, m_not_empty);
+                return Status::success;
+            }
+
+            m_not_full.wait(lock);
+        }
+    }
+
+    Status do_await_read(T& val) final
+    {
+        return await_read_impl(val, nullptr);
+    }
+
+    Status do_await_read_until(T& val, const time_point_t& deadline) final
+    {
+        return await_read_impl(val, &deadline);
+    }
+
+    Status do_try_read(T& val) final
+    {
+        if (try_pop(val))
+        {
+            notify_waiters(m_waiting_writers, m_not_full);
+            return Status::success;
+        }
+
+        return m_is_closed.load(std::memory_order_acquire) ? Status::closed : Status::empty;
+    }
+
+    Status do_await_write_n(std::span<T> data) final
+    {
+        std::size_t pushed = 0;
+
+        for (auto& item : data)
+        {
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                return Status::closed;
+            }
+
+            if (try_push(std::move(item)))
+            {
+                ++pushed;
+                continue;
+            }
+
+            // The ring is full. Wake any readers for what has been pushed so far before falling back to the blocking
+            // path, which issues its own notification
+            if (pushed > 0)
+            {
+                notify_waiters(m_waiting_readers, m_not_empty, pushed > 1);
+                pushed = 0;
+            }
+
+            auto rc = do_await_write(std::move(item));
+
+            if (rc != Status::success)
+            {
+                return rc;
+            }
+        }
+
+        if (pushed > 0)
+        {
+            notify_waiters(m_waiting_readers, m_not_empty, pushed > 1);
+        }
+
+        return Status::success;
+    }
+
+    Status do_await_read_n(std::vector<T>& data, std::size_t max_count) final
+    {
+        T item;
+        auto rc = await_read_impl(item, nullptr);
+
+        if (rc != Status::success)
+        {
+            return rc;
+        }
+
+        data.push_back(std::move(item));
+
+        std::size_t popped = 0;
+
+        while (popped + 1 < max_count && try_pop(item))
+        {
+            data.push_back(std::move(item));
+            ++popped;
+        }
+
+        if (popped > 0)
+        {
+            notify_waiters(m_waiting_writers, m_not_full, true);
+        }
+
+        return Status::success;
+    }
+
+    void do_close_channel() final
+    {
+        std::lock_guard<Mutex> lock(m_mutex);
+
+        m_is_closed.store(true, std::memory_order_release);
+
+        m_not_empty.notify_all();
+        m_not_full.notify_all();
+    }
+
+    bool do_is_channel_closed() const final
+    {
+        return m_is_closed.load(std::memory_order_acquire);
+    }
+
+    Status await_read_impl(T& val, const time_point_t* deadline)
+    {
+        auto timer = this->mutable_telemetry().reader_wait();
+
+        for (std::size_t i = 0; i < YieldCount; ++i)
+        {
+            if (try_pop(val))
+            {
+                notify_waiters(m_waiting_writers, m_not_full);
+                return Status::success;
+            }
+
+            // Only report closed once the ring has been drained
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                break;
+            }
+
+            timer.start();
+            boost::this_fiber::yield();
+        }
+
+        std::unique_lock<Mutex> lock(m_mutex);
+
+        m_waiting_readers.fetch_add(1, std::memory_order_seq_cst);
+
+        while (true)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (try_pop(val))
+            {
+                m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                lock.unlock();
+
+                notify_waiters(m_waiting_writers, m_not_full);
+                return Status::success;
+            }
+
+            if (m_is_closed.load(std::memory_order_acquire))
+            {
+                m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                return Status::closed;
+            }
+
+            if (deadline == nullptr)
+            {
+                m_not_empty.wait(lock);
+            }
+            else if (m_not_empty.wait_until(lock, *deadline) == boost::fibers::cv_status::timeout)
+            {
+                // One final attempt since an item may have landed between the timeout and reacquiring the lock
+                if (try_pop(val))
+                {
+                    m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                    lock.unlock();
+
+                    notify_waiters(m_waiting_writers, m_not_full);
+                    return Status::success;
+                }
+
+                m_waiting_readers.fetch_sub(1, std::memory_order_relaxed);
+                return Status::timeout;
+            }
+        }
+    }
+
+    // The seq_cst fence pairs with the one executed by a parking waiter after incrementing its waiting counter. Either
+    // the waiter observes our ring update on its final check, or we observe its counter and notify under the lock.
+    void notify_waiters(const std::atomic<std::size_t>& waiting, CondV& cv, bool notify_all = false)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (waiting.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<Mutex> lock(m_mutex);
+
+            if (notify_all)
+            {
+                cv.notify_all();
+            }
+            else
+            {
+                cv.notify_one();
+            }
+        }
+    }
+
+    bool try_push(T&& val)
+    {
+        if constexpr (ModeT == RingChannelMode::spsc)
+        {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+
+            if (tail - m_head_cache == m_capacity)
+            {
+                m_head_cache = m_head.load(std::memory_order_acquire);
+
+                if (tail - m_head_cache == m_capacity)
+                {
+                    return false;
+                }
+            }
+
+            new (m_slots[tail & m_mask].storage) T(std::move(val));
+            m_tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+        }
+        else
+        {
+            auto pos = m_tail.load(std::memory_order_relaxed);
+            Slot* slot{nullptr};
+
+            while (true)
+            {
+                slot           = &m_slots[pos & m_mask];
+                const auto seq = slot->sequence.load(std::memory_order_acquire);
+                const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                if (dif == 0)
+                {
+                    if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (dif < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (slot->storage) T(std::move(val));
+            slot->sequence.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+    }
+
+    bool try_pop(T& val)
+    {
+        if constexpr (ModeT == RingChannelMode::spsc)
+        {
+            const auto head = m_head.load(std::memory_order_relaxed);
+
+            if (head == m_tail_cache)
+            {
+                m_tail_cache = m_tail.load(std::memory_order_acquire);
+
+                if (head == m_tail_cache)
+                {
+                    return false;
+                }
+            }
+
+            auto* item = m_slots[head & m_mask].ptr();
+            val        = std::move(*item);
+            item->~T();
+            m_head.store(head + 1, std::memory_order_release);
+
+            return true;
+        }
+        else
+        {
+            auto pos = m_head.load(std::memory_order_relaxed);
+            Slot* slot{nullptr};
+
+            while (true)
+            {
+                slot           = &m_slots[pos & m_mask];
+                const auto seq = slot->sequence.load(std::memory_order_acquire);
+                const auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+                if (dif == 0)
+                {
+                    if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (dif < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+
+            auto* item = slot->ptr();
+            val        = std::move(*item);
+            item->~T();
+            slot->sequence.store(pos + m_capacity, std::memory_order_release);
+
+            return true;
+        }
+    }
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;  // NOLINT
+
+    // Writer owned cache line. m_head_cache is only used by the spsc writer
+    alignas(CacheLineSize) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_head_cache{0};
+
+    // Reader owned cache line. m_tail_cache is only used by the spsc reader
+    alignas(CacheLineSize) std::atomic<std::size_t> m_head{0};
+    std::size_t m_tail_cache{0};
+
+    // Slow path state, only touched when the ring is full, empty or being closed
+    alignas(CacheLineSize) std::atomic<bool> m_is_closed{false};
+    std::atomic<std::size_t> m_waiting_readers{0};
+    std::atomic<std::size_t> m_waiting_writers{0};
+    mutable Mutex m_mutex;
+    CondV m_not_empty;
+    CondV m_not_full;
+};
+
+}  // namespace mrc::channel
+
+namespace mrc {
+
+template <typename T, channel::RingChannelMode ModeT = channel::RingChannelMode::mpmc>
+using RingChannel = channel::RingChannel<T, ModeT>;  // NOLINT
+
+}
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::channel {
+
+/**
+ * @brief Point in time view of a channel's occupancy and backpressure.
+ */
+struct ChannelStats
+{
+    std::size_t occupancy{0};        // items written but not yet read or dropped
+    std::size_t high_water_mark{0};  // largest occupancy observed, see ChannelTelemetry
+    std::uint64_t writes{0};
+    std::uint64_t reads{0};
+    std::uint64_t dropped{0};
+    std::chrono::nanoseconds writer_blocked{0};  // total time writers spent waiting for space
+    std::chrono::nanoseconds reader_starved{0};  // total time readers spent waiting for data
+};
+
+/**
+ * @brief Whether ChannelTelemetry objects created from now on track their high-water mark exactly. Off by default.
+ */
+bool track_high_water_mark();
+void set_track_high_water_mark(bool enabled);
+
+/**
+ * @brief Occupancy and backpressure counters maintained by every Channel.
+ *
+ * Item counts are updated by Channel<T> with a relaxed increment after each successful read or write, or with a plain
+ * load and store for single producer single consumer channels. Writers only touch the writer cache line and readers
+ * only the reader cache line; occupancy is derived from both when the stats are read. Wait times are recorded by the
+ * channel implementations through WaitTimer, which only reads the clock once an operation has actually failed to make
+ * progress, so reads and writes which do not block never touch the clock.
+ *
+ * By default the high-water mark is the largest occupancy seen by stats(), so peaks between two reads of the stats are
+ * missed. Telemetry created while set_track_high_water_mark(true) is in effect, or constructed with exact tracking
+ * requested, also has every write load the reader counters and update the high-water mark, which makes it exact at the
+ * cost of sharing cache lines between producers and consumers.
+ */
+class ChannelTelemetry
+{
+  public:
+    ChannelTelemetry() : ChannelTelemetry(track_high_water_mark()) {}
+    explicit ChannelTelemetry(bool track_high_water_mark) : m_track_high_water_mark(track_high_water_mark) {}
+
+    /**
+     * @brief Accumulates the time between the first call to start() and destruction into a wait counter.
+     */
+    class WaitTimer
+    {
+      public:
+        explicit WaitTimer(std::atomic<std::uint64_t>& total_ns) : m_total_ns(total_ns) {}
+
+        ~WaitTimer()
+        {
+            if (m_started)
+            {
+                auto elapsed = std::chrono::steady_clock::now() - m_start;
+                m_total_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                     std::memory_order_relaxed);
+            }
+        }
+
+        WaitTimer(const WaitTimer&)            = delete;
+        WaitTimer& operator=(const WaitTimer&) = delete;
+
+        void start()
+        {
+            if (!m_started)
+            {
+                m_start   = std::chrono::steady_clock::now();
+                m_started = true;
+            }
+        }
+
+      private:
+        std::atomic<std::uint64_t>& m_total_ns;
+        std::chrono::steady_clock::time_point m_start;
+        bool m_started{false};
+    };
+
+    /**
+     * @brief Declares that the channel has exactly one writer and one reader, allowing the counters to be bumped with a
+     * plain load and store rather than an atomic read-modify-write. Must be called before the channel is used.
+     */
+    void set_single_producer_single_consumer()
+    {
+        m_single_writer = true;
+        m_single_reader = true;
+    }
+
+    void record_write(std::size_t count)
+    {
+        auto writes = add(m_writes, count, m_single_writer);
+
+        if (m_track_high_water_mark)
+        {
+            auto removed = m_reads.load(std::memory_order_relaxed) + m_dropped.load(std::memory_order_relaxed);
+            if (writes > removed)
+            {
+                update_high_water_mark(writes - removed);
+            }
+        }
+    }
+
+    void record_read(std::size_t count)
+    {
+        add(m_reads, count, m_single_reader);
+    }
+
+    void record_drop(std::size_t count)
+    {
+        m_dropped.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    WaitTimer writer_wait()
+    {
+        return WaitTimer(m_writer_blocked_ns);
+    }
+
+    WaitTimer reader_wait()
+    {
+        return WaitTimer(m_reader_starved_ns);
+    }
+
+    ChannelStats stats() const;
+
+  private:
+    static std::uint64_t add(std::atomic<std::uint64_t>& counter, std::size_t count, bool single_writer)
+    {
+        if (single_writer)
+        {
+            auto value = counter.load(std::memory_order_relaxed) + count;
+            counter.store(value, std::memory_order_relaxed);
+            return value;
+        }
+
+        return counter.fetch_add(count, std::memory_order_relaxed) + count;
+    }
+
+    void update_high_water_mark(std::size_t occupancy) const
+    {
+        auto high_water_mark = m_high_water_mark.load(std::memory_order_relaxed);
+        while (occupancy > high_water_mark &&
+               !m_high_water_mark.compare_exchange_weak(high_water_mark, occupancy, std::memory_order_relaxed))
+        {}
+    }
+
+    alignas(64) std::atomic<std::uint64_t> m_writes{0};
+    std::atomic<std::uint64_t> m_writer_blocked_ns{0};
+    const bool m_track_high_water_mark;
+    bool m_single_writer{false};
+
+    // Written by stats() and, when tracking exactly, by writers
+    alignas(64) mutable std::atomic<std::size_t> m_high_water_mark{0};
+
+    alignas(64) std::atomic<std::uint64_t> m_reads{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_reader_starved_ns{0};
+    bool m_single_reader{false};
+};
+
+}  // namespace mrc::channel
@@ -18,6 +18,7 @@
 #pragma once
 
 #define MRC_DEFAULT_BUFFERED_CHANNEL_SIZE 128
+#define MRC_DEFAULT_SINK_READ_BATCH_SIZE 16
 #define MRC_DEFAULT_FIBER_PRIORITY 0
 #define MRC_MAX_EAGER_BUFFER_SIZE 128
 
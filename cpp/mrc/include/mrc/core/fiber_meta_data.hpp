@@ -19,6 +19,12 @@
 
 #include "mrc/constants.hpp"
 
+#include <memory>
+
+namespace mrc::system {
+class FiberSharingGroup;
+}  // namespace mrc::system
+
 namespace mrc {
 
 /**
@@ -27,6 +33,9 @@ namespace mrc {
 struct FiberMetaData
 {
     int priority{MRC_DEFAULT_FIBER_PRIORITY};
+
+    // when set, the fiber may be migrated to any task queue which is a member of the sharing group
+    std::shared_ptr<system::FiberSharingGroup> sharing_group{nullptr};
 };
 
 }  // namespace mrc
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -19,6 +19,9 @@
 
 #include "mrc/core/bitmap.hpp"
 
+#include <cstddef>
+#include <vector>
+
 namespace mrc::core {
 
 struct HostPartition
@@ -34,4 +37,11 @@ struct HostPartition
     // virtual memory::resource memory_resource() = 0;
 };
 
+/**
+ * @brief Index of the first cpu set in host_partition_cpu_sets which contains the cpu the calling thread is running on,
+ * or 0 if none does. Given the cpu sets of the host partitions, it is suitable as the domain_fn of a NUMA-local
+ * data::CachedReusablePool.
+ */
+std::size_t current_host_partition_id(const std::vector<CpuSet>& host_partition_cpu_sets);
+
 }  // namespace mrc::core
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,19 +17,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
-#include <set>
+#include <vector>
 
 namespace mrc {
 
+// MRC_TRACING_DISABLED is set by configuring with -DMRC_ENABLE_WATCHERS=OFF; all watcher hooks then compile to nothing
 #ifdef MRC_TRACING_DISABLED
     #define WATCHER_PROLOGUE(event)
     #define WATCHER_EPILOGUE(event, rc)
-    #define WATCHER_EPILOGUE(event, rc)
 #else
     #define WATCHER_PROLOGUE(event) Watchable::watcher_prologue((event), this)
     #define WATCHER_EPILOGUE(event, rc) Watchable::watcher_epilogue((event), (rc), this)
-    #define WATCHER_EPILOGUE(event, rc) Watchable::watcher_epilogue((event), (rc), this)
 #endif
 
 enum class WatchableEvent
@@ -47,44 +47,95 @@ struct WatcherInterface
     virtual void on_exit(const WatchableEvent&, bool, const void*) = 0;
 };
 
+/**
+ * @brief Calls the attached WatcherInterfaces on entry and exit of instrumented operations.
+ *
+ * The hooks are on the hot path of every channel operation, so the common case of no attached or disabled watchers
+ * costs a single, well predicted branch on one member. Adding or removing watchers is not thread safe with respect to
+ * the hooks and should happen before the owning object is in use.
+ */
 class Watchable
 {
   public:
     void add_watcher(std::shared_ptr<WatcherInterface> /*obs*/);
     void remove_watcher(std::shared_ptr<WatcherInterface> /*obs*/);
 
+    /**
+     * @brief Enable or disable calling the attached watchers without detaching them; enabled by default.
+     */
+    void set_watchers_enabled(bool enabled);
+    bool watchers_enabled() const;
+
   protected:
     inline void watcher_prologue(WatchableEvent /*op*/, const void* addr);
     inline void watcher_epilogue(WatchableEvent /*op*/, bool /*rc*/, const void* addr);
 
   private:
-    std::set<std::shared_ptr<WatcherInterface>> m_watchers;
+    void update_watching();
+
+    // true iff watchers are enabled and at least one is attached; the only state read by the hooks on the fast path
+    bool m_watching{false};
+    bool m_enabled{true};
+    std::vector<std::shared_ptr<WatcherInterface>> m_watchers;
 };
 
 inline void Watchable::add_watcher(std::shared_ptr<WatcherInterface> obs)
 {
-    m_watchers.insert(obs);
+    if (std::find(m_watchers.begin(), m_watchers.end(), obs) == m_watchers.end())
+    {
+        m_watchers.push_back(std::move(obs));
+    }
+    update_watching();
 }
 
 inline void Watchable::remove_watcher(std::shared_ptr<WatcherInterface> obs)
 {
-    m_watchers.erase(obs);
+    std::erase(m_watchers, obs);
+    update_watching();
 }
 
-inline void Watchable::watcher_prologue(WatchableEvent op, const void* addr)
+inline void Watchable::set_watchers_enabled(bool enabled)
 {
-    for (const auto& obs : m_watchers)
+    m_enabled = enabled;
+    update_watching();
+}
+
+inline bool Watchable::watchers_enabled() const
+{
+    return m_enabled;
+}
+
+inline void Watchable::update_watching()
+{
+    m_watching = m_enabled && !m_watchers.empty();
+}
+
+inline void Watchable::watcher_prologue([[maybe_unused]] WatchableEvent op, [[maybe_unused]] const void* addr)
+{
+#ifndef MRC_TRACING_DISABLED
+    if (m_watching) [[unlikely]]
     {
-        obs->on_entry(op, addr);
+        for (const auto& obs : m_watchers)
+        {
+            obs->on_entry(op, addr);
+        }
     }
+#endif
 }
 
-inline void Watchable::watcher_epilogue(WatchableEvent op, bool rc, const void* addr)
+inline void Watchable::watcher_epilogue([[maybe_unused]] WatchableEvent op,
+                                        [[maybe_unused]] bool rc,
+                                        [[maybe_unused]] const void* addr)
 {
-    for (const auto& obs : m_watchers)
+#ifndef MRC_TRACING_DISABLED
+    if (m_watching) [[unlikely]]
     {
-        obs->on_exit(op, rc, addr);
+        for (const auto& obs : m_watchers)
+        {
+            obs->on_exit(op, rc, addr);
+        }
     }
+#endif
 }
 
 }  // namespace mrc
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/coroutines/concepts/awaitable.hpp"
+#include "mrc/types.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mrc::coroutines {
+
+namespace detail {
+
+/**
+ * @brief Coroutine which starts eagerly and destroys its own frame on completion, so whoever resumes it last never has
+ * to hand it back to the caller which started it.
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        DetachedTask get_return_object() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+template <typename AwaitableT, typename ResultT>
+DetachedTask fulfill_on_completion(AwaitableT awaitable, std::shared_ptr<mrc::Promise<ResultT>> promise)
+{
+    std::exception_ptr exception;
+    std::conditional_t<std::is_void_v<ResultT>, bool, std::optional<ResultT>> result{};
+
+    try
+    {
+        // Destroy the awaitable before fulfilling the promise, so whatever it holds has been released by the time the
+        // waiting fiber resumes
+        auto local = std::move(awaitable);
+
+        if constexpr (std::is_void_v<ResultT>)
+        {
+            co_await std::move(local);
+        }
+        else
+        {
+            result.emplace(co_await std::move(local));
+        }
+    } catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    if (exception != nullptr)
+    {
+        promise->set_exception(std::move(exception));
+    }
+    else if constexpr (std::is_void_v<ResultT>)
+    {
+        promise->set_value();
+    }
+    else
+    {
+        promise->set_value(std::move(*result));
+    }
+}
+
+template <typename AwaitableT>
+struct AwaitResult
+{
+    using type = typename concepts::awaitable_traits<AwaitableT>::awaiter_return_type;
+};
+
+template <concepts::awaiter AwaiterT>
+struct AwaitResult<AwaiterT>
+{
+    using type = decltype(std::declval<AwaiterT&>().await_resume());
+};
+
+}  // namespace detail
+
+/**
+ * @brief Counterpart of sync_wait for callers running on a fiber: awaits `a` and returns its result, blocking only the
+ * calling fiber rather than the whole thread if `a` suspends, so other fibers on the same thread keep running and may
+ * be the ones to resume it. If `a` completes without suspending, no fiber switch takes place.
+ */
+template <typename AwaitableT>
+    requires concepts::awaitable<AwaitableT> || concepts::awaiter<AwaitableT>
+auto fiber_wait(AwaitableT&& a)
+{
+    using awaitable_t = std::remove_cvref_t<AwaitableT>;
+    using result_t    = std::remove_cvref_t<typename detail::AwaitResult<awaitable_t>::type>;
+
+    auto promise = std::make_shared<mrc::Promise<result_t>>();
+    auto future  = promise->get_future();
+
+    detail::fulfill_on_completion<awaitable_t, result_t>(std::forward<AwaitableT>(a), std::move(promise));
+
+    return future.get();
+}
+
+}  // namespace mrc::coroutines
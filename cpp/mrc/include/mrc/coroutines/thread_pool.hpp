@@ -49,6 +49,7 @@
 #include <deque>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <stop_token>
 #include <string>
@@ -61,6 +62,11 @@ namespace mrc::coroutines {
  * Creates a thread pool that executes arbitrary coroutine tasks in a FIFO scheduler policy.
  * The thread pool by default will create an execution thread per available core on the system.
  *
+ * With SchedulingMode::WorkStealing each executor owns a local queue. Work scheduled from inside the pool stays on the
+ * current executor, work scheduled from outside the pool goes through a shared injection queue, and idle executors
+ * steal from a randomly chosen peer. This avoids the single global lock of SchedulingMode::GlobalQueue at high
+ * thread counts at the cost of strict FIFO ordering across the pool.
+ *
  * When shutting down, either by the thread pool destructing or by manually calling shutdown()
  * the thread pool will stop accepting new tasks but will complete all tasks that were scheduled
  * prior to the shutdown request.
@@ -112,6 +118,17 @@ class ThreadPool
         // srf_OTEL_TRACE(trace::Handle<trace::Span> m_span{nullptr});
     };
 
+    /**
+     * Determines how scheduled coroutines are distributed to the executor threads.
+     */
+    enum class SchedulingMode
+    {
+        /// All executors share one FIFO queue guarded by a single mutex.
+        GlobalQueue,
+        /// Executors own local queues; coroutines scheduled from inside the pool stay on the current executor.
+        WorkStealing,
+    };
+
     struct Options
     {
         /// The number of executor threads for this thread pool.  Uses the hardware concurrency
@@ -125,6 +142,8 @@ class ThreadPool
         std::function<void(std::size_t)> on_thread_stop_functor = nullptr;
         /// Description
         std::string description;
+        /// How scheduled coroutines are distributed to the executor threads.
+        SchedulingMode scheduling_mode = SchedulingMode::GlobalQueue;
     };
 
     /**
@@ -132,7 +151,8 @@ class ThreadPool
      */
     explicit ThreadPool(Options opts = Options{.thread_count            = std::thread::hardware_concurrency(),
                                                .on_thread_start_functor = nullptr,
-                                               .on_thread_stop_functor  = nullptr});
+                                               .on_thread_stop_functor  = nullptr,
+                                               .scheduling_mode         = SchedulingMode::GlobalQueue});
 
     ThreadPool(const ThreadPool&)                    = delete;
     ThreadPool(ThreadPool&&)                         = delete;
@@ -181,7 +201,8 @@ class ThreadPool
     }
 
     /**
-     * Schedules any coroutine handle that is ready to be resumed.
+     * Schedules any coroutine handle that is ready to be resumed. In SchedulingMode::WorkStealing a handle resumed from
+     * one of this pool's executors is run next on that same executor.
      * @param handle The coroutine handle to schedule.
      */
     auto resume(std::coroutine_handle<> handle) noexcept -> void;
@@ -193,6 +214,15 @@ class ThreadPool
     template <concepts::range_of<std::coroutine_handle<>> RangeT>
     auto resume(const RangeT& handles) noexcept -> void
     {
+        if (m_opts.scheduling_mode == SchedulingMode::WorkStealing)
+        {
+            for (const auto& handle : handles)
+            {
+                resume(handle);
+            }
+            return;
+        }
+
         m_size.fetch_add(std::size(handles), std::memory_order::release);
 
         size_t null_handles{0};
@@ -261,6 +291,17 @@ class ThreadPool
     {
         // Might not be totally perfect but good enough, avoids acquiring the lock for now.
         std::atomic_thread_fence(std::memory_order::acquire);
+
+        if (m_opts.scheduling_mode == SchedulingMode::WorkStealing)
+        {
+            std::size_t count = m_queue_size.load(std::memory_order::relaxed);
+            for (std::size_t i = 0; i < m_opts.thread_count; ++i)
+            {
+                count += m_workers[i].size.load(std::memory_order::relaxed);
+            }
+            return count;
+        }
+
         return m_queue.size();
     }
 
@@ -290,6 +331,23 @@ class ThreadPool
     const std::string& description() const;
 
   private:
+    /**
+     * Per-executor state used by SchedulingMode::WorkStealing. The owning executor pushes and pops at the back of the
+     * queue, yielded coroutines and thieves use the front.
+     */
+    struct alignas(64) Worker
+    {
+        /// Guards the local queue; only contended between the owning executor and thieves.
+        std::mutex mutex;
+        /// Coroutines scheduled from the owning executor thread.
+        std::deque<std::coroutine_handle<>> queue;
+        /// Snapshot of queue.size() which can be read without taking the lock.
+        std::atomic<std::size_t> size{0};
+        /// Only touched by the owning executor.
+        std::uint32_t rng_state{0};
+        std::uint32_t tick{0};
+    };
+
     /// The configuration options.
     Options m_opts;
     /// The background executor threads.
@@ -299,8 +357,19 @@ class ThreadPool
     std::mutex m_wait_mutex;
     /// Condition variable for each executor thread to wait on when no tasks are available.
     std::condition_variable_any m_wait_cv;
-    /// FIFO queue of tasks waiting to be executed.
+    /// FIFO queue of tasks waiting to be executed. In SchedulingMode::WorkStealing this only holds tasks scheduled from
+    /// threads outside of the pool.
     std::deque<std::coroutine_handle<>> m_queue;
+
+    /// Local queues, one per executor thread. Only allocated in SchedulingMode::WorkStealing.
+    std::unique_ptr<Worker[]> m_workers;  // NOLINT(modernize-avoid-c-arrays)
+    /// Number of entries in m_queue, readable without holding m_wait_mutex. Only used in SchedulingMode::WorkStealing.
+    std::atomic<std::size_t> m_queue_size{0};
+    /// Number of executors parked, or about to park, on m_wait_cv.
+    std::atomic<std::size_t> m_sleeping{0};
+    /// Pending wake-ups for parked executors when work lands in a local queue. Guarded by m_wait_mutex.
+    std::size_t m_wakeups{0};
+
     /**
      * Each background thread runs from this function.
      * @param stop_token Token which signals when shutdown() has been called.
@@ -308,10 +377,43 @@ class ThreadPool
      */
     auto executor(std::stop_token stop_token, std::size_t idx) -> void;
 
+    /**
+     * Executor loop used by SchedulingMode::WorkStealing.
+     */
+    auto executor_work_stealing(std::stop_token stop_token, std::size_t idx) -> void;
+
+    /**
+     * Finds the next coroutine for executor `idx`: its local queue, then the injection queue, then a random peer.
+     * @return nullptr if no work was found.
+     */
+    auto next_task(std::size_t idx) -> std::coroutine_handle<>;
+
+    /**
+     * Moves a batch of coroutines from the injection queue into the local queue of executor `idx`.
+     */
+    auto pop_injected(std::size_t idx) -> std::coroutine_handle<>;
+
+    /**
+     * Steals half of the local queue of a randomly chosen peer of executor `idx`.
+     */
+    auto steal(std::size_t idx) -> std::coroutine_handle<>;
+
+    /**
+     * @return True if any local queue or the injection queue currently holds work.
+     */
+    auto has_pending_work() const noexcept -> bool;
+
+    /**
+     * Wakes one parked executor, if any, after work was pushed to a local queue.
+     */
+    auto notify_sleeper() noexcept -> void;
+
     /**
      * @param handle Schedules the given coroutine to be executed upon the first available thread.
+     * @param lifo In SchedulingMode::WorkStealing, run the handle next on the current executor rather than after the
+     * work already queued there.
      */
-    auto schedule_impl(std::coroutine_handle<> handle) noexcept -> void;
+    auto schedule_impl(std::coroutine_handle<> handle, bool lifo = false) noexcept -> void;
 
     /// The number of tasks in the queue + currently executing.
     std::atomic<std::size_t> m_size{0};
@@ -0,0 +1,613 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/types.hpp"  // for CondV & Mutex
+#include "mrc/utils/macros.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace mrc::data {
+
+/**
+ * @brief A move-only holder of an object of T that is acquired from a CachedReusablePool<T> and will be returned to
+ * the same pool when it goes out of scope or is released.
+ */
+template <typename T>
+class CachedReusable;
+
+struct CachedReusablePoolOptions
+{
+    // number of items moved between a thread cache and the shared stacks at a time. A thread cache holds up to twice
+    // this many items
+    std::size_t batch_size{16};
+
+    // number of thread caches, rounded up to a power of 2; 0 creates one per hardware thread. When there are more
+    // threads than caches, some threads share a cache and fall back to the shared stacks while the other one uses it
+    std::size_t thread_cache_count{0};
+
+    // number of shared stacks. With more than one, domain_fn returns the stack local to the calling thread, e.g. using
+    // core::current_host_partition_id(). Items are only taken from other stacks when the local one is empty
+    std::size_t domain_count{1};
+    std::function<std::size_t()> domain_fn{nullptr};
+};
+
+namespace detail {
+
+// process wide index of the calling thread, used to select its thread cache
+inline std::size_t this_thread_pool_cache_index()
+{
+    static std::atomic<std::size_t> next_index{0};
+    thread_local const std::size_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A resource pool with the same usage as ReusablePool<T>, for hot message types where the mutex and channel
+ * backing ReusablePool show up in profiles.
+ *
+ * Each thread acquires and returns items through its own cache of free items, without touching state shared with
+ * other threads. An empty cache is refilled with a batch of items popped from a shared lock-free stack, and a full
+ * cache spills its oldest batch back onto it. Only when no free item can be found in any cache or stack does
+ * await_item block the calling fiber until an item is returned. With CachedReusablePoolOptions::domain_count there is
+ * one shared stack per NUMA domain, so that batches are recycled among the threads of a domain.
+ *
+ * Unlike ReusablePool, items do not hold a reference to the pool. The pool must outlive every item acquired from it;
+ * if the last reference to the pool is released while items are still in use, an error is logged and the pool is
+ * leaked so that those items can still be returned safely.
+ *
+ * @tparam T
+ */
+template <typename T>
+class CachedReusablePool final
+{
+  public:
+    using item_t      = std::unique_ptr<T>;
+    using on_return_t = std::function<void(T&)>;
+    using options_t   = CachedReusablePoolOptions;
+
+    DELETE_COPYABILITY(CachedReusablePool);
+    DELETE_MOVEABILITY(CachedReusablePool);
+
+    static std::shared_ptr<CachedReusablePool<T>> create(std::size_t capacity, on_return_t on_return_fn = nullptr)
+    {
+        return create(capacity, options_t{}, std::move(on_return_fn));
+    }
+
+    static std::shared_ptr<CachedReusablePool<T>> create(std::size_t capacity,
+                                                          options_t options,
+                                                          on_return_t on_return_fn = nullptr)
+    {
+        if (capacity >= Null)
+        {
+            throw std::invalid_argument("CachedReusablePool capacity must be less than 2^32 - 1");
+        }
+
+        if (options.batch_size == 0 || options.domain_count == 0)
+        {
+            throw std::invalid_argument("CachedReusablePool batch_size and domain_count must be greater than 0");
+        }
+
+        if (options.domain_count > 1 && !options.domain_fn)
+        {
+            throw std::invalid_argument("CachedReusablePool requires a domain_fn when domain_count is greater than 1");
+        }
+
+        return std::shared_ptr<CachedReusablePool>(
+            new CachedReusablePool(capacity, std::move(options), std::move(on_return_fn)),
+            [](CachedReusablePool* pool) {
+                pool->destroy();
+            });
+    }
+
+    void add_item(item_t item)
+    {
+        std::lock_guard<decltype(m_add_mutex)> lock(m_add_mutex);
+
+        auto index = static_cast<std::uint32_t>(m_size.load(std::memory_order_relaxed));
+
+        if (index >= m_capacity)
+        {
+            throw std::length_error("pool capacity exceeded");
+        }
+
+        m_slots[index].item = std::move(item);
+        m_size.store(index + 1, std::memory_order_relaxed);
+
+        push_chain(this_thread_stack(), index, index);
+        notify_waiters();
+    }
+
+    template <typename... ArgsT>
+    void emplace(ArgsT&&... args)
+    {
+        add_item(std::make_unique<T>(std::forward<ArgsT>(args)...));
+    }
+
+    CachedReusable<T> await_item()
+    {
+        auto index = try_acquire();
+
+        if (index == Null)
+        {
+            index = await_acquire();
+        }
+
+        return CachedReusable<T>(*this, m_slots[index].item.get(), index);
+    }
+
+    /**
+     * @brief Number of items managed by the pool
+     */
+    std::size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr std::uint32_t Null        = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t CacheLineSize = 64;
+    static constexpr std::chrono::milliseconds WaiterRescanInterval{1};
+
+    struct Slot
+    {
+        item_t item;
+        std::atomic<std::uint32_t> next{Null};
+    };
+
+    // Treiber stack of slot indices. The lower 32 bits of head are the index of the top slot, the upper 32 bits are a
+    // tag incremented on every update so that a slot popped and pushed again in between cannot be mistaken for the
+    // original head (ABA)
+    struct alignas(CacheLineSize) SharedStack
+    {
+        std::atomic<std::uint64_t> head{Null};
+    };
+
+    // LIFO of free slot indices. Normally only used by its own thread; the lock is only contended by threads sharing
+    // the cache or by a fiber blocked in await_item collecting the items of every cache
+    struct alignas(CacheLineSize) ThreadCache
+    {
+        std::atomic<bool> locked{false};
+        std::size_t count{0};
+        std::unique_ptr<std::uint32_t[]> items;  // NOLINT
+
+        bool try_lock()
+        {
+            return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock()
+        {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    CachedReusablePool(std::size_t capacity, options_t options, on_return_t on_return_fn) :
+      m_capacity(capacity),
+      m_batch_size(options.batch_size),
+      m_cache_capacity(2 * options.batch_size),
+      m_cache_count(std::bit_ceil(options.thread_cache_count > 0 ? options.thread_cache_count
+                                                                 : std::max(1U, std::thread::hardware_concurrency()))),
+      m_domain_count(options.domain_count),
+      m_domain_fn(std::move(options.domain_fn)),
+      m_on_return_fn(std::move(on_return_fn)),
+      m_slots(std::make_unique<Slot[]>(capacity)),
+      m_stacks(std::make_unique<SharedStack[]>(m_domain_count)),
+      m_caches(std::make_unique<ThreadCache[]>(m_cache_count))
+    {
+        for (std::size_t i = 0; i < m_cache_count; ++i)
+        {
+            m_caches[i].items = std::make_unique<std::uint32_t[]>(m_cache_capacity);
+        }
+    }
+
+    ~CachedReusablePool() = default;
+
+    // Called when the last shared_ptr to the pool is released. Outstanding items hold a raw pointer to the pool, so
+    // rather than leaving them to return into freed memory the pool is leaked until the process exits
+    void destroy()
+    {
+        const auto free_items = count_free_items();
+
+        if (free_items != size())
+        {
+            LOG(ERROR) << "CachedReusablePool released while " << size() - free_items
+                       << " of its items are still in use; leaking the pool";
+            return;
+        }
+
+        delete this;
+    }
+
+    void return_item(std::uint32_t index)
+    {
+        if (m_on_return_fn)
+        {
+            m_on_return_fn(*m_slots[index].item);
+        }
+
+        auto& cache = this_thread_cache();
+
+        if (cache.try_lock())
+        {
+            if (cache.count == m_cache_capacity)
+            {
+                spill(cache, m_batch_size);
+            }
+
+            cache.items[cache.count++] = index;
+            cache.unlock();
+        }
+        else
+        {
+            push_chain(this_thread_stack(), index, index);
+        }
+
+        notify_waiters();
+    }
+
+    std::uint32_t try_acquire()
+    {
+        auto& cache = this_thread_cache();
+
+        if (!cache.try_lock())
+        {
+            return pop_any();
+        }
+
+        if (cache.count == 0)
+        {
+            refill(cache);
+        }
+
+        auto index           = cache.count > 0 ? cache.items[--cache.count] : Null;
+        const auto remaining = cache.count;
+        cache.unlock();
+
+        // a blocked await_item skips caches which are locked, so hand over any items left behind
+        if (remaining > 0)
+        {
+            notify_waiters();
+        }
+
+        return index;
+    }
+
+    // Slow path for when no free item was found. Items may still be sitting in the caches of threads which are not
+    // acquiring any, so those are collected onto the shared stacks before parking. Caches locked by their thread are
+    // skipped; that thread calls notify_waiters once it unlocks the cache.
+    //
+    // To keep fences off the fast paths, m_waiting is read with relaxed ordering and a thread can miss a waiter which
+    // has only just started waiting. Parked waiters therefore also rescan every WaiterRescanInterval.
+    std::uint32_t await_acquire()
+    {
+        std::unique_lock<Mutex> lock(m_mutex);
+
+        m_waiting.fetch_add(1, std::memory_order_relaxed);
+
+        while (true)
+        {
+            auto index = pop_any();
+
+            if (index == Null)
+            {
+                drain_caches();
+                index = pop_any();
+            }
+
+            if (index != Null)
+            {
+                m_waiting.fetch_sub(1, std::memory_order_relaxed);
+                return index;
+            }
+
+            m_item_returned.wait_for(lock, WaiterRescanInterval);
+        }
+    }
+
+    // hands the items in this thread's cache over to any fiber blocked in await_item
+    void notify_waiters()
+    {
+        if (m_waiting.load(std::memory_order_relaxed) > 0)
+        {
+            auto& cache = this_thread_cache();
+
+            if (cache.try_lock())
+            {
+                spill(cache, cache.count);
+                cache.unlock();
+            }
+
+            // Taking the lock orders us after a waiter which is between its scan and parking. Notifying after
+            // releasing it saves the woken waiter from immediately blocking on the lock again
+            {
+                std::lock_guard<Mutex> lock(m_mutex);
+            }
+
+            m_item_returned.notify_all();
+        }
+    }
+
+    // moves the items of every cache which is not currently locked onto the shared stacks
+    void drain_caches()
+    {
+        for (std::size_t i = 0; i < m_cache_count; ++i)
+        {
+            auto& cache = m_caches[i];
+
+            if (cache.try_lock())
+            {
+                spill(cache, cache.count);
+                cache.unlock();
+            }
+        }
+    }
+
+    void refill(ThreadCache& cache)
+    {
+        const auto local = this_thread_domain();
+
+        // prefer the local stack, only fall back to remote stacks when it is empty
+        for (std::size_t i = 0; i < m_domain_count && cache.count == 0; ++i)
+        {
+            auto& stack = m_stacks[(local + i) % m_domain_count];
+
+            while (cache.count < m_batch_size)
+            {
+                auto index = pop(stack);
+
+                if (index == Null)
+                {
+                    break;
+                }
+
+                cache.items[cache.count++] = index;
+            }
+        }
+    }
+
+    // pushes the count oldest items of the cache onto the local stack as a single chain
+    void spill(ThreadCache& cache, std::size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i + 1 < count; ++i)
+        {
+            m_slots[cache.items[i]].next.store(cache.items[i + 1], std::memory_order_relaxed);
+        }
+
+        push_chain(this_thread_stack(), cache.items[0], cache.items[count - 1]);
+
+        std::copy(cache.items.get() + count, cache.items.get() + cache.count, cache.items.get());
+        cache.count -= count;
+    }
+
+    std::uint32_t pop_any()
+    {
+        const auto local = this_thread_domain();
+
+        for (std::size_t i = 0; i < m_domain_count; ++i)
+        {
+            auto index = pop(m_stacks[(local + i) % m_domain_count]);
+
+            if (index != Null)
+            {
+                return index;
+            }
+        }
+
+        return Null;
+    }
+
+    // first to last must already be linked through Slot::next
+    void push_chain(SharedStack& stack, std::uint32_t first, std::uint32_t last)
+    {
+        auto head = stack.head.load(std::memory_order_relaxed);
+
+        do
+        {
+            m_slots[last].next.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        } while (!stack.head.compare_exchange_weak(
+            head, pack(first, tag(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    std::uint32_t pop(SharedStack& stack)
+    {
+        auto head = stack.head.load(std::memory_order_acquire);
+
+        while (static_cast<std::uint32_t>(head) != Null)
+        {
+            const auto index = static_cast<std::uint32_t>(head);
+            const auto next  = m_slots[index].next.load(std::memory_order_relaxed);
+
+            if (stack.head.compare_exchange_weak(
+                    head, pack(next, tag(head) + 1), std::memory_order_acquire, std::memory_order_acquire))
+            {
+                return index;
+            }
+        }
+
+        return Null;
+    }
+
+    static std::uint64_t pack(std::uint32_t index, std::uint32_t tag)
+    {
+        return (static_cast<std::uint64_t>(tag) << 32) | index;
+    }
+
+    static std::uint32_t tag(std::uint64_t head)
+    {
+        return static_cast<std::uint32_t>(head >> 32);
+    }
+
+    ThreadCache& this_thread_cache()
+    {
+        return m_caches[detail::this_thread_pool_cache_index() & (m_cache_count - 1)];
+    }
+
+    std::size_t this_thread_domain() const
+    {
+        return m_domain_count == 1 ? 0 : m_domain_fn() % m_domain_count;
+    }
+
+    SharedStack& this_thread_stack()
+    {
+        return m_stacks[this_thread_domain()];
+    }
+
+    // Only called once nothing can acquire from the pool, but outstanding items may still be returned concurrently.
+    // Holding every cache lock stops items moving from a cache onto a stack while counting, so no free item is counted
+    // twice; an item returned during the count may be missed, which only errs on the side of leaking the pool
+    std::size_t count_free_items()
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < m_cache_count; ++i)
+        {
+            while (!m_caches[i].try_lock())
+            {
+                std::this_thread::yield();
+            }
+
+            count += m_caches[i].count;
+        }
+
+        for (std::size_t i = 0; i < m_domain_count; ++i)
+        {
+            for (auto index = static_cast<std::uint32_t>(m_stacks[i].head.load()); index != Null;
+                 index      = m_slots[index].next.load())
+            {
+                ++count;
+            }
+        }
+
+        for (std::size_t i = 0; i < m_cache_count; ++i)
+        {
+            m_caches[i].unlock();
+        }
+
+        return count;
+    }
+
+    const std::size_t m_capacity;
+    const std::size_t m_batch_size;
+    const std::size_t m_cache_capacity;
+    const std::size_t m_cache_count;
+    const std::size_t m_domain_count;
+    const std::function<std::size_t()> m_domain_fn;
+    const on_return_t m_on_return_fn;
+
+    std::mutex m_add_mutex;
+    std::atomic<std::size_t> m_size{0};
+
+    std::unique_ptr<Slot[]> m_slots;           // NOLINT
+    std::unique_ptr<SharedStack[]> m_stacks;   // NOLINT
+    std::unique_ptr<ThreadCache[]> m_caches;  // NOLINT
+
+    // Slow path state, only touched when the pool has run out of free items
+    alignas(CacheLineSize) std::atomic<std::size_t> m_waiting{0};
+    Mutex m_mutex;
+    CondV m_item_returned;
+
+    friend CachedReusable<T>;
+};
+
+template <typename T>
+class CachedReusable final
+{
+    using pool_t = CachedReusablePool<T>;
+
+    CachedReusable(pool_t& pool, T* data, std::uint32_t index) : m_pool(&pool), m_data(data), m_index(index) {}
+
+  public:
+    CachedReusable() = default;
+
+    CachedReusable(CachedReusable&& other) noexcept :
+      m_pool(std::exchange(other.m_pool, nullptr)),
+      m_data(std::exchange(other.m_data, nullptr)),
+      m_index(other.m_index)
+    {}
+
+    CachedReusable& operator=(CachedReusable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_pool  = std::exchange(other.m_pool, nullptr);
+            m_data  = std::exchange(other.m_data, nullptr);
+            m_index = other.m_index;
+        }
+        return *this;
+    }
+
+    DELETE_COPYABILITY(CachedReusable);
+
+    ~CachedReusable()
+    {
+        release();
+    }
+
+    T& operator*()
+    {
+        CHECK(m_data);
+        return *m_data;
+    }
+
+    T* operator->()
+    {
+        CHECK(m_data);
+        return m_data;
+    }
+
+    void release()
+    {
+        if (m_data)
+        {
+            m_data = nullptr;
+            std::exchange(m_pool, nullptr)->return_item(m_index);
+        }
+    }
+
+  private:
+    pool_t* m_pool{nullptr};
+    T* m_data{nullptr};
+    std::uint32_t m_index{0};
+
+    friend pool_t;
+};
+
+}  // namespace mrc::data
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -37,8 +37,15 @@ class DeferredWritableMultiEdgeBase : public IMultiWritableAcceptorBase<std::siz
   public:
     using determine_indices_fn_t = std::function<std::vector<std::size_t>(DeferredWritableMultiEdgeBase&)>;
 
+    // Selects the single downstream for the value being written, passed as a pointer to the edge's value type. Takes
+    // precedence over the indices function and, unlike it, may be replaced and have downstreams connected while other
+    // threads are writing to the edge
+    using determine_index_for_value_fn_t = std::function<std::size_t(DeferredWritableMultiEdgeBase&, const void*)>;
+
     virtual void set_indices_fn(determine_indices_fn_t indices_fn) = 0;
 
+    virtual void set_index_for_value_fn(determine_index_for_value_fn_t index_fn) = 0;
+
     virtual size_t edge_connection_count() const                  = 0;
     virtual std::vector<std::size_t> edge_connection_keys() const = 0;
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -25,13 +25,18 @@
 #include "mrc/edge/edge_writable.hpp"
 #include "mrc/edge/forward.hpp"  // IWYU pragma: keep
 #include "mrc/type_traits.hpp"
+#include "mrc/utils/string_utils.hpp"
 #include "mrc/utils/type_utils.hpp"
 
 #include <glog/logging.h>
 
+#include <atomic>
 #include <cstddef>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <typeindex>
 #include <utility>
 #include <vector>
@@ -303,12 +308,26 @@ class DeferredWritableMultiEdge : public MultiEdgeHolder<std::size_t, T>,
         // Set a connector to check that the indices function has been set
         this->add_connector([this]() {
             // Ensure that the indices function is properly set
-            CHECK(this->m_indices_fn) << "Must set indices function before connecting edge";
+            CHECK(this->m_indices_fn || this->m_index_for_value_fn)
+                << "Must set indices function before connecting edge";
         });
     }
 
     channel::Status await_write(T&& data) override
     {
+        if (const auto* routes = m_routes.load(std::memory_order_acquire))
+        {
+            auto index = routes->index_for_value_fn(*this, &data);
+            auto found = routes->edges.find(index);
+
+            if (found == routes->edges.end())
+            {
+                throw std::runtime_error(MRC_CONCAT_STR("Could not find edge pair for key: " << index));
+            }
+
+            return found->second->await_write(std::move(data));
+        }
+
         auto indices = this->determine_indices_for_value(data);
 
         // First, handle the situation where there is more than one connection to push to
@@ -353,6 +372,13 @@ class DeferredWritableMultiEdge : public MultiEdgeHolder<std::size_t, T>,
         m_indices_fn = std::move(indices_fn);
     }
 
+    void set_index_for_value_fn(determine_index_for_value_fn_t index_fn) override
+    {
+        std::unique_lock lock(m_mutex);
+        m_index_for_value_fn = std::move(index_fn);
+        publish_routes();
+    }
+
     size_t edge_connection_count() const override
     {
         return MultiEdgeHolder<std::size_t, T>::edge_connection_count();
@@ -374,16 +400,54 @@ class DeferredWritableMultiEdge : public MultiEdgeHolder<std::size_t, T>,
     }
 
   private:
+    // Immutable snapshot of everything the route by value path needs to pick and write to a downstream
+    struct RouteTable
+    {
+        determine_index_for_value_fn_t index_for_value_fn;
+        std::map<std::size_t, std::shared_ptr<IEdgeWritable<T>>> edges;
+    };
+
     void set_writable_edge_handle(std::size_t key, std::shared_ptr<WritableEdgeHandle> ingress) override
     {
         // Do any conversion to the correct type here
         auto adapted_ingress = EdgeBuilder::adapt_writable_edge<T>(ingress);
 
+        std::unique_lock lock(m_mutex);
         MultiEdgeHolder<std::size_t, T>::make_edge_connection(key, adapted_ingress);
+
+        if (m_index_for_value_fn)
+        {
+            publish_routes();
+        }
+    }
+
+    // must be called with m_mutex held
+    void publish_routes()
+    {
+        auto routes = std::make_unique<RouteTable>();
+
+        routes->index_for_value_fn = m_index_for_value_fn;
+        for (const auto& key : MultiEdgeHolder<std::size_t, T>::edge_connection_keys())
+        {
+            routes->edges.emplace(key, this->get_writable_edge(key));
+        }
+
+        m_routes.store(routes.get(), std::memory_order_release);
+        m_route_tables.push_back(std::move(routes));
     }
 
     bool m_deep_copy{false};
     determine_indices_fn_t m_indices_fn{};
+    determine_index_for_value_fn_t m_index_for_value_fn{};
+
+    // Writers on the route by value path only load m_routes. A table is republished whenever the index function or
+    // the connections change; since that is rare and a writer may still be using the previous table, every published
+    // table is kept until the edge is destroyed
+    std::atomic<const RouteTable*> m_routes{nullptr};
+    std::vector<std::unique_ptr<const RouteTable>> m_route_tables;
+
+    // guards the connections, m_index_for_value_fn and m_route_tables
+    std::mutex m_mutex;
 };
 
 template <typename T>
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -21,7 +21,10 @@
 #include "mrc/edge/edge_writable.hpp"
 #include "mrc/edge/forward.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace mrc::edge {
 
@@ -44,6 +47,16 @@ class EdgeChannelReader : public IEdgeReadable<T>
         return m_channel->await_read(t);
     }
 
+    channel::Status await_read_n(std::vector<T>& data, std::size_t max_count) override
+    {
+        return m_channel->await_read_n(data, max_count);
+    }
+
+    channel::Status await_read_until(T& t, const channel::time_point_t& tp) override
+    {
+        return m_channel->await_read_until(t, tp);
+    }
+
   private:
     EdgeChannelReader(std::shared_ptr<mrc::channel::Channel<T>> channel) : m_channel(std::move(channel)) {}
 
@@ -71,6 +84,11 @@ class EdgeChannelWriter : public IEdgeWritable<T>
         return m_channel->await_write(std::move(t));
     }
 
+    channel::Status await_write_n(std::span<T> data) override
+    {
+        return m_channel->await_write_n(data);
+    }
+
   private:
     EdgeChannelWriter(std::shared_ptr<mrc::channel::Channel<T>> channel) : m_channel(std::move(channel)) {}
 
@@ -101,6 +119,16 @@ class EdgeChannel
         return std::shared_ptr<EdgeChannelWriter<T>>(new EdgeChannelWriter<T>(m_channel));
     }
 
+    [[nodiscard]] std::shared_ptr<const channel::ChannelTelemetry> telemetry() const
+    {
+        return m_channel->telemetry();
+    }
+
+    [[nodiscard]] bool is_single_producer_single_consumer() const
+    {
+        return m_channel->is_single_producer_single_consumer();
+    }
+
   private:
     std::shared_ptr<mrc::channel::Channel<T>> m_channel;
 };
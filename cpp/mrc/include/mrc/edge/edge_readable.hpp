@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,6 +20,7 @@
 #include "mrc/channel/channel.hpp"
 #include "mrc/channel/egress.hpp"
 #include "mrc/channel/ingress.hpp"
+#include "mrc/channel/types.hpp"
 #include "mrc/edge/edge.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/node/forward.hpp"
@@ -62,6 +63,35 @@ class IEdgeReadable : public virtual Edge<T>, public IEdgeReadableBase
     }
 
     virtual channel::Status await_read(T& t) = 0;
+
+    /**
+     * @brief Block until at least one item is available and append it to `data`. Edges backed by a channel override
+     * this to also append up to `max_count` (> 0) items which are immediately available without blocking further.
+     */
+    virtual channel::Status await_read_n(std::vector<T>& data, std::size_t /*max_count*/)
+    {
+        T item;
+        auto rc = this->await_read(item);
+
+        if (rc == channel::Status::success)
+        {
+            data.push_back(std::move(item));
+        }
+
+        return rc;
+    }
+
+    /**
+     * @brief Block until an item is available or the deadline `tp` passes, returning Status::timeout in the latter
+     * case. Only edges which can honor the deadline implement this, i.e. those backed by a channel and the converting
+     * edges in front of them; all others throw rather than silently blocking past the deadline.
+     */
+    virtual channel::Status await_read_until(T& /*t*/, const channel::time_point_t& /*tp*/)
+    {
+        LOG(ERROR) << "await_read_until is not supported by this edge. Only edges backed by a channel can be read with "
+                      "a deadline";
+        throw exceptions::MrcRuntimeError("await_read_until is not supported by this edge");
+    }
 };
 
 template <typename InputT, typename OutputT = InputT>
@@ -110,6 +140,40 @@ class ConvertingEdgeReadable<InputT, OutputT, std::enable_if_t<std::is_convertib
 
         return ret_val;
     }
+
+    channel::Status await_read_n(std::vector<OutputT>& data, std::size_t max_count) override
+    {
+        if constexpr (std::is_same_v<InputT, OutputT>)
+        {
+            return this->upstream().await_read_n(data, max_count);
+        }
+        else
+        {
+            std::vector<InputT> source_data;
+            auto ret_val = this->upstream().await_read_n(source_data, max_count);
+
+            // Convert to the sink type
+            for (auto& item : source_data)
+            {
+                data.emplace_back(std::move(item));
+            }
+
+            return ret_val;
+        }
+    }
+
+    channel::Status await_read_until(OutputT& data, const channel::time_point_t& tp) override
+    {
+        InputT source_data;
+        auto ret_val = this->upstream().await_read_until(source_data, tp);
+
+        if (ret_val == channel::Status::success)
+        {
+            data = std::move(source_data);
+        }
+
+        return ret_val;
+    }
 };
 
 template <typename InputT, typename OutputT>
@@ -137,6 +201,33 @@ class LambdaConvertingEdgeReadable : public ConvertingEdgeReadableBase<InputT, O
         return ret_val;
     }
 
+    channel::Status await_read_n(std::vector<output_t>& data, std::size_t max_count) override
+    {
+        std::vector<input_t> source_data;
+        auto ret_val = this->upstream().await_read_n(source_data, max_count);
+
+        // Convert to the sink type
+        for (auto& item : source_data)
+        {
+            data.push_back(m_lambda_fn(std::move(item)));
+        }
+
+        return ret_val;
+    }
+
+    channel::Status await_read_until(output_t& data, const channel::time_point_t& tp) override
+    {
+        input_t source_data;
+        auto ret_val = this->upstream().await_read_until(source_data, tp);
+
+        if (ret_val == channel::Status::success)
+        {
+            data = m_lambda_fn(std::move(source_data));
+        }
+
+        return ret_val;
+    }
+
   private:
     lambda_fn_t m_lambda_fn{};
 };
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/status.hpp"
+#include "mrc/coroutines/closable_ring_buffer.hpp"
+#include "mrc/coroutines/fiber_wait.hpp"
+#include "mrc/edge/edge_writable.hpp"
+
+#include <glog/logging.h>
+
+#include <memory>
+#include <utility>
+
+namespace mrc::edge {
+
+/**
+ * @brief Writable edge into a ClosableRingBuffer. Coroutines which hold this edge can write to buffer() directly; all
+ * other writers go through await_write, which suspends only the calling fiber while the buffer is full. The buffer is
+ * closed when the last holder of the edge lets go of it.
+ */
+template <typename T>
+class EdgeRingBufferWriter : public IEdgeWritable<T>
+{
+  public:
+    using buffer_t = coroutines::ClosableRingBuffer<T>;
+
+    EdgeRingBufferWriter(std::shared_ptr<buffer_t> buffer) : m_buffer(std::move(buffer))
+    {
+        CHECK(m_buffer) << "Cannot create an EdgeRingBufferWriter from an empty pointer";
+    }
+
+    ~EdgeRingBufferWriter() override
+    {
+        if (this->is_connected())
+        {
+            VLOG(10) << "Closing ring buffer from EdgeRingBufferWriter";
+        }
+
+        m_buffer->close();
+    }
+
+    channel::Status await_write(T&& t) override
+    {
+        auto status = coroutines::fiber_wait(m_buffer->write(std::move(t)));
+
+        return status == coroutines::RingBufferOpStatus::Success ? channel::Status::success : channel::Status::closed;
+    }
+
+    buffer_t& buffer() const
+    {
+        return *m_buffer;
+    }
+
+  private:
+    std::shared_ptr<buffer_t> m_buffer;
+};
+
+}  // namespace mrc::edge
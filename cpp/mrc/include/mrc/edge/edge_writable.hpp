@@ -36,6 +36,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <typeindex>
@@ -70,6 +71,25 @@ class IEdgeWritable : public virtual Edge<T>, public virtual IEdgeWritableBase
     {
         return await_write(std::move(data));
     }
+
+    /**
+     * @brief Write each element of `data` in order, moving it out of the span. Returns the first non-success status.
+     * Edges backed by a channel override this to write the whole batch with a single call into the channel.
+     */
+    virtual channel::Status await_write_n(std::span<T> data)
+    {
+        for (auto& item : data)
+        {
+            auto rc = this->await_write(std::move(item));
+
+            if (rc != channel::Status::success)
+            {
+                return rc;
+            }
+        }
+
+        return channel::Status::success;
+    }
 };
 
 template <typename InputT, typename OutputT = InputT>
@@ -112,6 +132,26 @@ class ConvertingEdgeWritable<InputT, OutputT, std::enable_if_t<std::is_convertib
     {
         return this->downstream().await_write(std::move(data));
     }
+
+    channel::Status await_write_n(std::span<input_t> data) override
+    {
+        if constexpr (std::is_same_v<input_t, output_t>)
+        {
+            return this->downstream().await_write_n(data);
+        }
+        else
+        {
+            std::vector<output_t> converted;
+            converted.reserve(data.size());
+
+            for (auto& item : data)
+            {
+                converted.emplace_back(std::move(item));
+            }
+
+            return this->downstream().await_write_n(converted);
+        }
+    }
 };
 
 template <typename InputT, typename OutputT>
@@ -133,6 +173,19 @@ class LambdaConvertingEdgeWritable : public ConvertingEdgeWritableBase<InputT, O
         return this->downstream().await_write(m_lambda_fn(std::move(data)));
     }
 
+    channel::Status await_write_n(std::span<input_t> data) override
+    {
+        std::vector<output_t> converted;
+        converted.reserve(data.size());
+
+        for (auto& item : data)
+        {
+            converted.push_back(m_lambda_fn(std::move(item)));
+        }
+
+        return this->downstream().await_write_n(converted);
+    }
+
   private:
     lambda_fn_t m_lambda_fn{};
 };
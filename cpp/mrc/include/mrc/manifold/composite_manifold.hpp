@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -33,16 +33,12 @@ class CompositeManifold : public Manifold
 
   public:
     CompositeManifold(PortName port_name, runnable::IRunnableResources& resources) :
-      Manifold(std::move(port_name), resources)
+      CompositeManifold(std::move(port_name), resources, DeferLink{})
     {
-        // construct IngressT and EgressT on the NUMA node / memory domain in which the object will run
+        // Then link them together
         this->resources()
             .main()
             .enqueue([this] {
-                m_ingress = std::make_unique<IngressT>();
-                m_egress  = std::make_unique<EgressT>();
-
-                // Then link them together
                 mrc::make_edge(*m_ingress, *m_egress);
             })
             .get();
@@ -60,6 +56,23 @@ class CompositeManifold : public Manifold
     }
 
   protected:
+    struct DeferLink
+    {};
+
+    // Leaves the ingress and egress unlinked; used by manifolds which place a stage of their own between the two
+    CompositeManifold(PortName port_name, runnable::IRunnableResources& resources, DeferLink /*unused*/) :
+      Manifold(std::move(port_name), resources)
+    {
+        // construct IngressT and EgressT on the NUMA node / memory domain in which the object will run
+        this->resources()
+            .main()
+            .enqueue([this] {
+                m_ingress = std::make_unique<IngressT>();
+                m_egress  = std::make_unique<EgressT>();
+            })
+            .get();
+    }
+
     IngressT& ingress()
     {
         CHECK(m_ingress);
@@ -93,6 +106,14 @@ class CompositeManifold : public Manifold
         });
     }
 
+    void set_routing_policy(RoutingPolicy policy) final
+    {
+        // the egress may already be routing, so change the policy along with the other input updates
+        m_input_updates.push_back([this, policy] {
+            m_egress->set_routing_policy(policy);
+        });
+    }
+
     void update(std::vector<std::function<void()>>& updates)
     {
         resources()
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,17 +17,26 @@
 
 #pragma once
 
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/edge/edge_builder.hpp"
 #include "mrc/manifold/interface.hpp"
+#include "mrc/manifold/routing_policy.hpp"
 #include "mrc/node/operators/muxer.hpp"
 #include "mrc/node/operators/router.hpp"
+#include "mrc/node/sink_channel_owner.hpp"
 #include "mrc/node/sink_properties.hpp"
 #include "mrc/node/source_properties.hpp"
 #include "mrc/types.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <random>
+#include <vector>
 
 namespace mrc::manifold {
 
@@ -35,6 +44,9 @@ struct EgressDelegate
 {
     virtual ~EgressDelegate()                                                                        = default;
     virtual void add_output(const SegmentAddress& address, edge::IWritableProviderBase* output_sink) = 0;
+
+    // Egresses which do not choose between downstream segments ignore the policy
+    virtual void set_routing_policy(RoutingPolicy policy) {}
 };
 
 template <typename T>
@@ -52,42 +64,156 @@ class TypedEgress : public EgressDelegate
     virtual void do_add_output(const SegmentAddress& address, edge::IWritableProvider<T>* output_sink) = 0;
 };
 
+/**
+ * @brief Routes each message to one downstream segment instance according to a RoutingPolicy, round robin by default.
+ */
 template <typename T>
 class RoundRobinEgress : public node::Router<SegmentAddress, T>, public TypedEgress<T>
 {
+  public:
+    // may be called while messages are being routed; each message sees either the old or the new policy
+    void set_routing_policy(RoutingPolicy policy) final
+    {
+        m_policy.store(policy, std::memory_order_relaxed);
+    }
+
+    RoutingPolicy routing_policy() const
+    {
+        return m_policy.load(std::memory_order_relaxed);
+    }
+
   protected:
+    channel::Status on_next(T&& data) override
+    {
+        auto& target = pick_target();
+
+        // writes which have not returned yet count towards the target's load, this covers a full ingress channel
+        // whose occupancy can no longer grow
+        target.pending.fetch_add(1, std::memory_order_relaxed);
+        auto rc = node::MultiSourceProperties<SegmentAddress, T>::get_writable_edge(target.address)
+                      ->await_write(std::move(data));
+        target.pending.fetch_sub(1, std::memory_order_relaxed);
+
+        return rc;
+    }
+
     SegmentAddress determine_key_for_value(const T& t) override
     {
-        CHECK_LT(m_next, m_pick_list.size());
-        auto next = m_next++;
-        // roll counter before await_write which could yield
-        if (m_next == m_pick_list.size())
+        return pick_target().address;
+    }
+
+  private:
+    struct Target
+    {
+        Target(SegmentAddress addr, std::shared_ptr<const channel::ChannelTelemetry> ingress) :
+          address(addr),
+          telemetry(std::move(ingress))
+        {}
+
+        // occupancy of the downstream ingress channel, 0 if the ingress does not own a channel
+        std::size_t queue_depth() const
         {
-            m_next = 0;
+            return telemetry ? telemetry->stats().occupancy : 0;
         }
 
-        return m_pick_list[next];
-    }
+        std::size_t load() const
+        {
+            return queue_depth() + pending.load(std::memory_order_relaxed);
+        }
+
+        SegmentAddress address;
+        std::shared_ptr<const channel::ChannelTelemetry> telemetry;
+        std::atomic<std::size_t> pending{0};
+    };
 
-  private:
     void do_add_output(const SegmentAddress& address, edge::IWritableProvider<T>* sink) override
     {
         mrc::make_edge(*this->get_source(address), *sink);
-        update_pick_list();
+
+        std::shared_ptr<const channel::ChannelTelemetry> telemetry;
+        if (auto* channel_owner = dynamic_cast<node::SinkChannelOwner<T>*>(sink))
+        {
+            telemetry = channel_owner->sink_channel_telemetry();
+        }
+
+        m_targets.push_back(std::make_unique<Target>(address, std::move(telemetry)));
+        shuffle_targets();
     }
 
-    void update_pick_list()
+    void shuffle_targets()
     {
-        // Make a copy of the keys
-        m_pick_list = this->edge_connection_keys();
-
-        // Shuffle the keys
-        std::shuffle(m_pick_list.begin(), m_pick_list.end(), std::mt19937(std::random_device()()));
+        // Shuffle the targets
+        std::shuffle(m_targets.begin(), m_targets.end(), std::mt19937(std::random_device()()));
         m_next = 0;
     }
 
-    std::size_t m_next{0};
-    std::vector<SegmentAddress> m_pick_list;
+    Target& pick_target()
+    {
+        const auto count = m_targets.size();
+        CHECK_GT(count, 0) << "no downstream segments attached to the egress";
+
+        // rolling the counter is the only state change, so the await_write which follows may yield
+        const auto start = m_next.fetch_add(1, std::memory_order_relaxed) % count;
+
+        switch (m_policy.load(std::memory_order_relaxed))
+        {
+        case RoutingPolicy::least_loaded:
+            return min_target(start, &Target::load);
+        case RoutingPolicy::lowest_queue_depth:
+            return min_target(start, &Target::queue_depth);
+        case RoutingPolicy::power_of_two_choices:
+            return power_of_two_target(start);
+        case RoutingPolicy::round_robin:
+            break;
+        }
+
+        return *m_targets[start];
+    }
+
+    Target& min_target(std::size_t start, std::size_t (Target::*measure)() const)
+    {
+        const auto count = m_targets.size();
+
+        Target* best      = m_targets[start].get();
+        std::size_t least = (best->*measure)();
+
+        for (std::size_t i = 1; i < count && least > 0; ++i)
+        {
+            auto* target = m_targets[(start + i) % count].get();
+            auto value   = (target->*measure)();
+            if (value < least)
+            {
+                best  = target;
+                least = value;
+            }
+        }
+
+        return *best;
+    }
+
+    Target& power_of_two_target(std::size_t start)
+    {
+        const auto count = m_targets.size();
+        if (count == 1)
+        {
+            return *m_targets[0];
+        }
+
+        // xorshift; the choices only need to be cheap and uncorrelated between threads, not uniform to the last bit
+        thread_local std::uint64_t state = std::random_device()() | 1;
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        auto& first  = *m_targets[start];
+        auto& second = *m_targets[(start + 1 + state % (count - 1)) % count];
+
+        return (second.load() < first.load()) ? second : first;
+    }
+
+    std::atomic<RoutingPolicy> m_policy{RoutingPolicy::round_robin};
+    std::atomic<std::size_t> m_next{0};
+    std::vector<std::unique_ptr<Target>> m_targets;
 };
 
 }  // namespace mrc::manifold
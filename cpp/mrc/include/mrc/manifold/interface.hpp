@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "mrc/edge/forward.hpp"
+#include "mrc/manifold/routing_policy.hpp"
 #include "mrc/types.hpp"
 
 namespace mrc::manifold {
@@ -41,6 +42,9 @@ struct Interface
     // this ensures downstream segments have started and are immediately capaable of handling data
     virtual void update_inputs()  = 0;
     virtual void update_outputs() = 0;
+
+    // applied with the next input update; manifolds which do not route between downstream segments ignore the policy
+    virtual void set_routing_policy(RoutingPolicy policy) = 0;
 };
 
 }  // namespace mrc::manifold
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,97 +17,136 @@
 
 #pragma once
 
+#include "mrc/channel/status.hpp"
 #include "mrc/core/addresses.hpp"
 #include "mrc/edge/edge_builder.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/manifold/composite_manifold.hpp"
+#include "mrc/manifold/egress.hpp"
+#include "mrc/manifold/ingress.hpp"
 #include "mrc/manifold/interface.hpp"
 #include "mrc/node/generic_sink.hpp"
 #include "mrc/node/operators/muxer.hpp"
 #include "mrc/node/rx_sink.hpp"
-#include "mrc/node/source_channel_owner.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
-#include "mrc/runnable/launchable.hpp"
+#include "mrc/runnable/launcher.hpp"
 #include "mrc/runnable/runnable_resources.hpp"
-#include "mrc/runnable/types.hpp"
+#include "mrc/runnable/runner.hpp"
 #include "mrc/types.hpp"
 
+#include <glog/logging.h>
+
+#include <cstddef>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 
 namespace mrc::manifold {
 
 namespace detail {
 
+/**
+ * @brief Progress engines of the LoadBalancer. Every engine drains the shared input channel and forwards each item to
+ * the egress, so a downstream write which blocks only stalls the engine which issued it.
+ */
 template <typename T>
-class Balancer : public node::GenericSink<T>
+class Balancer : public node::GenericSink<T>, public node::WritableAcceptor<T>
 {
   public:
-    Balancer(RoundRobinEgress<T>& state) : m_state(state) {}
+    Balancer()
+    {
+        // items are handed out one at a time, otherwise the first engines to wake claim the whole backlog
+        this->set_read_batch_size(1);
+    }
 
   private:
     void on_data(T&& data) final
     {
-        // LOG(INFO) << "balancer node: " << data;
-        m_state.await_write(std::move(data));
+        auto rc = node::SourceProperties<T>::get_writable_edge()->await_write(std::move(data));
+        if (rc != channel::Status::success)
+        {
+            LOG(ERROR) << "load-balancer failed to write to the egress; status: " << static_cast<int>(rc);
+            throw exceptions::MrcRuntimeError("load-balancer failed to write to the egress");
+        }
     }
 
     void will_complete() final
     {
-        DVLOG(10) << "shutdown load-balancer - clear output channels";
-        // m_state.clear();
-    };
-
-    RoundRobinEgress<T>& m_state;
+        // executed once all engines have drained the input; completes every downstream segment attached to the egress
+        DVLOG(10) << "shutdown load-balancer - release egress";
+        node::WritableAcceptor<T>::release_edge_connection();
+    }
 };
 
 }  // namespace detail
 
+/**
+ * @brief Manifold which spreads the messages of all upstream segments over the downstream segments.
+ *
+ * Upstream segments write into a single channel owned by the balancer, which is drained by launch_options().pe_count *
+ * launch_options().engines_per_pe progress engines; each engine writes its items to the RoundRobinEgress. The engines
+ * are launched by the first call to start() and complete once every upstream segment has released its edge, at which
+ * point the downstream segments are completed and join() returns.
+ */
 template <typename T>
 class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<T>>
 {
     using base_t = CompositeManifold<MuxedIngress<T>, RoundRobinEgress<T>>;
 
   public:
-    LoadBalancer(PortName port_name, runnable::IRunnableResources& resources) : base_t(std::move(port_name), resources)
+    static constexpr std::size_t DefaultEnginesPerPe = 8;
+
+    LoadBalancer(PortName port_name, runnable::IRunnableResources& resources) :
+      base_t(std::move(port_name), resources, typename base_t::DeferLink{})
     {
         m_launch_options.engine_factory_name = "main";
         m_launch_options.pe_count            = 1;
-        m_launch_options.engines_per_pe      = 8;
-
-        // // construct any resources
-        // this->resources()
-        //     .main()
-        //     .enqueue([this] {
-        //         m_balancer = std::make_shared<detail::Balancer<T>>(this->egress());
-        //         mrc::make_edge(this->ingress().source(), *m_balancer);
-        //     })
-        //     .get();
+        m_launch_options.engines_per_pe      = DefaultEnginesPerPe;
+
+        // construct any resources
+        this->resources()
+            .main()
+            .enqueue([this] {
+                m_balancer = std::make_unique<detail::Balancer<T>>();
+                mrc::make_edge(this->ingress(), *m_balancer);
+                mrc::make_edge(*m_balancer, this->egress());
+            })
+            .get();
     }
 
     void start() final
     {
-        // this->resources()
-        //     .main()
-        //     .enqueue([this] {
-        //         if (m_runner)
-        //         {
-        //             // todo(#179) - validate this fix and improve test coverage
-        //             // this will be handled now by the default behavior of SourceChannelOwner::no_channel method
-        //             // CHECK(!this->egress().output_channels().empty()) << "no egress channels on manifold";
-        //             return;
-        //         }
-        //         CHECK(m_balancer);
-        //         m_runner = this->resources()
-        //                        .launch_control()
-        //                        .prepare_launcher(launch_options(), std::move(m_balancer))
-        //                        ->ignition();
-        //     })
-        //     .get();
+        this->resources()
+            .main()
+            .enqueue([this] {
+                if (m_runner)
+                {
+                    return;
+                }
+                CHECK(m_balancer);
+                m_runner = this->resources()
+                               .launch_control()
+                               .prepare_launcher(launch_options(), std::move(m_balancer))
+                               ->ignition();
+            })
+            .get();
     }
 
     void join() final
     {
-        // m_runner->await_join();
+        if (m_runner)
+        {
+            m_runner->await_join();
+        }
+    }
+
+    /**
+     * @brief Options used to launch the balancer engines; changes only take effect if made before start().
+     */
+    runnable::LaunchOptions& launch_options()
+    {
+        return m_launch_options;
     }
 
     const runnable::LaunchOptions& launch_options() const
@@ -119,8 +158,8 @@ class LoadBalancer : public CompositeManifold<MuxedIngress<T>, RoundRobinEgress<
     // launch options
     runnable::LaunchOptions m_launch_options;
 
-    // // this is the progress engine that will drive the load balancer
-    // std::shared_ptr<node::GenericSink<T>> m_balancer;
+    // this is the progress engine that will drive the load balancer, ownership moves to the runner on start()
+    std::unique_ptr<detail::Balancer<T>> m_balancer;
 
     // runner
     std::unique_ptr<runnable::Runner> m_runner{nullptr};
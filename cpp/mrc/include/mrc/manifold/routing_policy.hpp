@@ -0,0 +1,43 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace mrc::manifold {
+
+/**
+ * @brief Selects how a manifold egress distributes messages between the downstream segment instances of a port.
+ *
+ * round_robin           - rotate through the downstream instances in a fixed, shuffled order (default)
+ * least_loaded          - the instance with the smallest ingress channel occupancy plus the number of writes from this
+ *                         egress still waiting on it; O(n) per message
+ * power_of_two_choices  - two randomly sampled instances, the less loaded of the pair by the least_loaded measure;
+ *                         O(1) per message and nearly as balanced as least_loaded for many instances
+ * lowest_queue_depth    - the instance with the smallest ingress channel occupancy; O(n) per message
+ *
+ * The load aware policies read the occupancy from the channel telemetry of the downstream ingress port. Ties are
+ * broken in round robin order so idle instances still share the work evenly.
+ */
+enum class RoutingPolicy
+{
+    round_robin,
+    least_loaded,
+    power_of_two_choices,
+    lowest_queue_depth,
+};
+
+}  // namespace mrc::manifold
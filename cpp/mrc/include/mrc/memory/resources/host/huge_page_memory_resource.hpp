@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/memory/resources/memory_resource.hpp"
+
+#include <glog/logging.h>
+#include <sys/mman.h>
+
+#include <cstddef>
+#include <new>
+
+namespace mrc::memory {
+
+/**
+ * @brief Host memory resource backed by 2 MiB huge pages.
+ *
+ * Allocations are rounded up to a multiple of the huge page size and mapped with MAP_HUGETLB. If no huge pages have
+ * been reserved with the kernel, the mapping falls back to regular anonymous memory advised with MADV_HUGEPAGE so it
+ * may still be backed by transparent huge pages.
+ */
+class huge_page_memory_resource final : public memory_resource
+{
+  public:
+    static constexpr std::size_t huge_page_size = 2UL << 20;
+
+  private:
+    static std::size_t round_up(std::size_t bytes)
+    {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+    void* do_allocate(std::size_t bytes) final
+    {
+        if (0 == bytes)
+        {
+            return nullptr;
+        }
+
+        bytes = round_up(bytes);
+
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED)
+            {
+                throw std::bad_alloc{};
+            }
+            if (madvise(ptr, bytes, MADV_HUGEPAGE) != 0)
+            {
+                VLOG(1) << "madvise(MADV_HUGEPAGE) failed; allocation will use regular pages";
+            }
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes) final
+    {
+        CHECK_EQ(munmap(ptr, round_up(bytes)), 0);
+    }
+
+    memory_kind do_kind() const final
+    {
+        return memory_kind::host;
+    }
+};
+
+}  // namespace mrc::memory
@@ -0,0 +1,47 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace prometheus {
+class Gauge;
+}
+
+namespace mrc::metrics {
+
+class Gauge
+{
+  public:
+    explicit Gauge(prometheus::Gauge*);
+
+    Gauge(const Gauge&)            = default;
+    Gauge& operator=(const Gauge&) = default;
+
+    Gauge(Gauge&&) noexcept            = default;
+    Gauge& operator=(Gauge&&) noexcept = default;
+
+    void set(double value);
+    void increment(double value = 1.0);
+    void decrement(double value = 1.0);
+
+    double value() const;
+
+  private:
+    prometheus::Gauge* m_gauge;
+};
+
+}  // namespace mrc::metrics
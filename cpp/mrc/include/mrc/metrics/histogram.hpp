@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/benchmarking/latency_histogram.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::metrics {
+
+/**
+ * @brief Storage behind a Histogram handle, owned by the Registry. Values are bucketed with the log-linear layout of
+ * benchmarking::LatencyHistogram. Each thread records into one of Stripes cache-line aligned copies of the buckets
+ * with relaxed atomic adds, so observe() never takes a lock and threads rarely share a cache line; snapshot() merges
+ * the stripes.
+ */
+class HistogramStorage
+{
+  public:
+    static constexpr std::size_t Stripes = 8;
+
+    void observe(std::uint64_t value);
+
+    benchmarking::LatencyHistogram snapshot() const;
+    std::uint64_t sum() const;
+
+  private:
+    struct alignas(64) Stripe
+    {
+        std::array<std::atomic<std::uint64_t>, benchmarking::LatencyHistogram::BucketCount> buckets{};
+        std::atomic<std::uint64_t> sum{0};
+    };
+
+    std::array<Stripe, Stripes> m_stripes;
+};
+
+class Histogram
+{
+  public:
+    explicit Histogram(HistogramStorage*);
+
+    Histogram(const Histogram&)            = default;
+    Histogram& operator=(const Histogram&) = default;
+
+    Histogram(Histogram&&) noexcept            = default;
+    Histogram& operator=(Histogram&&) noexcept = default;
+
+    void observe(std::uint64_t value);
+    void observe(std::chrono::nanoseconds duration);
+
+  private:
+    HistogramStorage* m_histogram;
+};
+
+}  // namespace mrc::metrics
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/core/watcher.hpp"
+#include "mrc/metrics/histogram.hpp"
+
+#include <cstdint>
+
+namespace mrc::metrics {
+
+/**
+ * @brief Watcher attached to the sink side of a node which records how long each element spends in on_data. The call
+ * for an element ends when the progress engine next touches its input channel, either to hand over the next element
+ * of the current batch or to await a new batch, so sinks and filtering nodes are measured as well as nodes that emit.
+ *
+ * Start times are kept per fiber, so each progress engine of the node is timed independently even when several share
+ * a thread.
+ */
+class NodeLatencyWatcher final : public WatcherInterface
+{
+  public:
+    explicit NodeLatencyWatcher(Histogram on_data_latency);
+
+    void on_entry(const WatchableEvent& e, const void* data) override;
+    void on_exit(const WatchableEvent& e, bool rc, const void* data) override;
+
+  private:
+    void finish_on_data();
+
+    const std::uint64_t m_id;
+    Histogram m_on_data_latency;
+};
+
+}  // namespace mrc::metrics
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,11 +17,15 @@
 
 #pragma once
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/histogram.hpp"
 
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +34,7 @@
 
 namespace prometheus {
 class Registry;
+struct MetricFamily;
 template <typename T>
 class Family;
 class Counter;
@@ -49,16 +54,64 @@ class Registry
 {
   public:
     Registry();
+    ~Registry();
 
     Counter make_counter(std::string name, std::map<std::string, std::string> labels);
     Counter make_throughput_counter(std::string);
+    Gauge make_gauge(std::string name, std::map<std::string, std::string> labels);
+
+    /**
+     * @brief Histogram of non-negative integer observations, e.g. latencies in nanoseconds. Requesting the same name
+     * and labels twice returns a handle to the same histogram.
+     */
+    Histogram make_histogram(std::string name, std::map<std::string, std::string> labels);
+
+    /**
+     * @brief Report the occupancy, high-water mark, item counts and wait times of a channel as the mrc_channel_*
+     * metrics. The telemetry is sampled on every to_text(); registering the same labels again replaces the channel.
+     */
+    void register_channel_telemetry(std::map<std::string, std::string> labels,
+                                    std::shared_ptr<const channel::ChannelTelemetry> telemetry);
 
     std::vector<CounterReport> collect_throughput_counters() const;
 
+    /**
+     * @brief Render every metric in this registry using the Prometheus text exposition format. Histograms are reported
+     * with one bucket per power of two.
+     */
+    std::string to_text() const;
+
+    /**
+     * @brief Text exposition of every live Registry in the process, with the metrics of identically named families
+     * merged under a single HELP/TYPE header. Allows the metrics of running pipelines to be scraped or dumped locally
+     * without starting a network facing exporter.
+     */
+    static std::string all_to_text();
+
+    /**
+     * @brief When enabled, segment builders attach on_data latency histograms to every node and sink they create.
+     */
+    void enable_node_metrics(bool flag);
+    bool node_metrics_enabled() const;
+
   protected:
   private:
+    std::vector<prometheus::MetricFamily> collect_families() const;
+
+    struct HistogramSeries
+    {
+        std::map<std::string, std::string> labels;
+        std::unique_ptr<HistogramStorage> storage;
+    };
+
     std::shared_ptr<prometheus::Registry> m_registry;
     prometheus::Family<prometheus::Counter>& m_throughput_counters;
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::vector<HistogramSeries>> m_histograms;
+    std::vector<std::pair<std::map<std::string, std::string>, std::shared_ptr<const channel::ChannelTelemetry>>>
+        m_channels;
+    bool m_node_metrics_enabled{false};
 };
 
 }  // namespace mrc::metrics
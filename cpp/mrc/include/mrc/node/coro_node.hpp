@@ -0,0 +1,366 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/coroutines/async_generator.hpp"
+#include "mrc/coroutines/closable_ring_buffer.hpp"
+#include "mrc/coroutines/fiber_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/edge/edge_ring_buffer.hpp"
+#include "mrc/edge/edge_writable.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <glog/logging.h>
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace mrc::node {
+
+/**
+ * @brief Awaitable writer handed to the body of a CoroSource or CoroNode.
+ *
+ * When the downstream edge is the ring buffer of another coroutine node, `co_await write(value)` goes straight into
+ * that buffer and suspends the calling coroutine while it is full, so a chain of coroutine nodes hands items along
+ * without rxcpp or fibers. Any other downstream is written with its blocking await_write, which blocks the thread
+ * running the coroutine while the downstream applies backpressure.
+ */
+template <typename T>
+class CoroWriter
+{
+    using buffer_t = coroutines::ClosableRingBuffer<T>;
+
+  public:
+    class WriteOperation
+    {
+      public:
+        WriteOperation(const CoroWriter& writer, T value) : m_writer(writer), m_value(std::move(value)) {}
+
+        bool await_ready()
+        {
+            if (m_writer.m_buffer == nullptr)
+            {
+                m_status = m_writer.m_edge->await_write(std::move(m_value));
+                return true;
+            }
+
+            m_buffer_write.emplace(*m_writer.m_buffer, std::move(m_value));
+            return m_buffer_write->await_ready();
+        }
+
+        bool await_suspend(std::coroutine_handle<> awaiting_coroutine)
+        {
+            return m_buffer_write->await_suspend(awaiting_coroutine);
+        }
+
+        channel::Status await_resume()
+        {
+            if (m_buffer_write)
+            {
+                return m_buffer_write->await_resume() == coroutines::RingBufferOpStatus::Success
+                           ? channel::Status::success
+                           : channel::Status::closed;
+            }
+
+            return m_status;
+        }
+
+      private:
+        const CoroWriter& m_writer;
+        T m_value;
+        std::optional<typename buffer_t::WriteOperation> m_buffer_write;
+        channel::Status m_status{channel::Status::error};
+    };
+
+    explicit CoroWriter(std::shared_ptr<edge::IEdgeWritable<T>> edge) : m_edge(std::move(edge))
+    {
+        CHECK(m_edge) << "Cannot create a CoroWriter without a downstream edge";
+
+        if (auto* ring_edge = dynamic_cast<edge::EdgeRingBufferWriter<T>*>(m_edge.get()))
+        {
+            m_buffer = &ring_edge->buffer();
+        }
+    }
+
+    /**
+     * @brief Writes `value` downstream; resolves to Status::success, or Status::closed once the downstream is gone
+     */
+    [[nodiscard]] WriteOperation write(T value) const
+    {
+        return WriteOperation(*this, std::move(value));
+    }
+
+  private:
+    std::shared_ptr<edge::IEdgeWritable<T>> m_edge;
+    buffer_t* m_buffer{nullptr};
+};
+
+/**
+ * @brief Input half of the coroutine nodes: accepts writes into a ClosableRingBuffer and presents its contents to the
+ * body as an AsyncGenerator. Upstream writers on fibers wait on a full buffer with fiber_wait.
+ */
+template <typename T>
+class CoroSinkBase : public WritableProvider<T>
+{
+  protected:
+    explicit CoroSinkBase(std::size_t capacity)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("CoroSinkBase capacity must be greater than 0");
+        }
+
+        m_buffer = std::make_shared<coroutines::ClosableRingBuffer<T>>(
+            typename coroutines::ClosableRingBuffer<T>::Options{.capacity = capacity});
+
+        WritableProvider<T>::init_owned_edge(std::make_shared<edge::EdgeRingBufferWriter<T>>(m_buffer));
+    }
+
+    /**
+     * @brief Yields each item written to this node until every upstream has released its edge. When `thread_pool` is
+     * given, a read which had to wait for an upstream write resumes on the pool rather than inline on the writer.
+     */
+    coroutines::AsyncGenerator<T> input(coroutines::ThreadPool* thread_pool = nullptr) const
+    {
+        return read_input(m_buffer, thread_pool);
+    }
+
+    /**
+     * @brief Wakes any suspended reader or writer of the input buffer and fails all further reads and writes
+     */
+    void stop_input()
+    {
+        m_buffer->notify_waiters();
+    }
+
+  private:
+    static coroutines::AsyncGenerator<T> read_input(std::shared_ptr<coroutines::ClosableRingBuffer<T>> buffer,
+                                                    coroutines::ThreadPool* thread_pool)
+    {
+        while (true)
+        {
+            auto read = buffer->read();
+            if (thread_pool != nullptr)
+            {
+                read.resume_on(thread_pool);
+            }
+
+            auto item = co_await read;
+
+            if (!item)
+            {
+                co_return;
+            }
+
+            co_yield std::move(*item);
+        }
+    }
+
+    std::shared_ptr<coroutines::ClosableRingBuffer<T>> m_buffer;
+};
+
+/**
+ * @brief Common runnable for the coroutine nodes. Each engine awaits its own instance of the body with fiber_wait;
+ * when a ThreadPool is given the body is first scheduled onto it and every read of the input which had to wait
+ * resumes on it again, otherwise it starts on the engine and is resumed by whichever thread completes the operation it
+ * suspended on.
+ */
+template <typename ContextT>
+class CoroRunnable : public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    /**
+     * @brief Runs the body on `thread_pool` instead of the engines of the node. Must be set before the node is started.
+     */
+    void set_thread_pool(std::shared_ptr<coroutines::ThreadPool> thread_pool)
+    {
+        m_thread_pool = std::move(thread_pool);
+    }
+
+  protected:
+    coroutines::ThreadPool* thread_pool() const
+    {
+        return m_thread_pool.get();
+    }
+
+    void await_body(coroutines::Task<void> body)
+    {
+        coroutines::fiber_wait(this->launch(std::move(body)));
+    }
+
+    void on_state_update(const runnable::Runnable::State& state) override
+    {
+        if (state == runnable::Runnable::State::Kill)
+        {
+            this->on_kill();
+        }
+    }
+
+  private:
+    coroutines::Task<void> launch(coroutines::Task<void> body)
+    {
+        if (m_thread_pool)
+        {
+            co_await m_thread_pool->schedule();
+        }
+
+        co_await std::move(body);
+    }
+
+    virtual void on_kill() {}
+
+    std::shared_ptr<coroutines::ThreadPool> m_thread_pool;
+};
+
+/**
+ * @brief Source whose body is a coroutine `Task<void>(CoroWriter<T>)`. The output edge is released once the body of
+ * every engine has returned.
+ */
+template <typename T, typename ContextT = runnable::Context>
+class CoroSource : public WritableAcceptor<T>, public CoroRunnable<ContextT>
+{
+  public:
+    using body_fn_t = std::function<coroutines::Task<void>(CoroWriter<T>)>;
+
+    explicit CoroSource(body_fn_t body_fn) : m_body_fn(std::move(body_fn)) {}
+
+  private:
+    void run(ContextT& ctx) final
+    {
+        std::exception_ptr exception;
+
+        try
+        {
+            this->await_body(m_body_fn(CoroWriter<T>(SourceProperties<T>::get_writable_edge())));
+        } catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            SourceProperties<T>::release_edge_connection();
+        }
+
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    body_fn_t m_body_fn;
+};
+
+/**
+ * @brief Sink whose body is a coroutine `Task<void>(AsyncGenerator<T>)` reading from a ClosableRingBuffer of
+ * `capacity` items.
+ */
+template <typename T, typename ContextT = runnable::Context>
+class CoroSink : public CoroSinkBase<T>, public CoroRunnable<ContextT>
+{
+  public:
+    using body_fn_t = std::function<coroutines::Task<void>(coroutines::AsyncGenerator<T>)>;
+
+    explicit CoroSink(body_fn_t body_fn, std::size_t capacity = channel::default_channel_size()) :
+      CoroSinkBase<T>(capacity),
+      m_body_fn(std::move(body_fn))
+    {}
+
+  private:
+    void run(ContextT& ctx) final
+    {
+        this->await_body(m_body_fn(this->input(this->thread_pool())));
+    }
+
+    void on_kill() final
+    {
+        this->stop_input();
+    }
+
+    body_fn_t m_body_fn;
+};
+
+/**
+ * @brief Node whose body is a coroutine `Task<void>(AsyncGenerator<InputT>, CoroWriter<OutputT>)`.
+ *
+ * The input is a ClosableRingBuffer of `capacity` items; the generator ends once every upstream has released its edge.
+ * Connected to other coroutine nodes, items move between bodies by stackless suspension on the ring buffers instead
+ * of through rxcpp subscribers and fiber channels. Connected to any other node, the edges behave like channel edges.
+ * Can be created with `IBuilder::make_node<InputT, OutputT, node::CoroNode>(name, body)`.
+ */
+template <typename InputT, typename OutputT = InputT, typename ContextT = runnable::Context>
+class CoroNode : public CoroSinkBase<InputT>, public WritableAcceptor<OutputT>, public CoroRunnable<ContextT>
+{
+  public:
+    using body_fn_t =
+        std::function<coroutines::Task<void>(coroutines::AsyncGenerator<InputT>, CoroWriter<OutputT>)>;
+
+    explicit CoroNode(body_fn_t body_fn, std::size_t capacity = channel::default_channel_size()) :
+      CoroSinkBase<InputT>(capacity),
+      m_body_fn(std::move(body_fn))
+    {}
+
+  private:
+    void run(ContextT& ctx) final
+    {
+        std::exception_ptr exception;
+
+        try
+        {
+            this->await_body(
+                m_body_fn(this->input(this->thread_pool()),
+                          CoroWriter<OutputT>(SourceProperties<OutputT>::get_writable_edge())));
+        } catch (...)
+        {
+            exception = std::current_exception();
+        }
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            SourceProperties<OutputT>::release_edge_connection();
+        }
+
+        if (exception != nullptr)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void on_kill() final
+    {
+        this->stop_input();
+    }
+
+    body_fn_t m_body_fn;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,285 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/types.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/node/operators/node_component.hpp"
+#include "mrc/node/sink_channel_owner.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_channel_owner.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/runnable/context.hpp"
+#include "mrc/runnable/runnable.hpp"
+
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+/**
+ * @brief Free list of emptied std::vector<T> batch buffers shared between a Batch and the nodes consuming its batches.
+ *
+ * Buffers handed back via release() are cleared but keep their capacity, so once the pipeline reaches a steady state a
+ * Batch fills recycled buffers rather than allocating a new one per batch. At most `max_buffers` buffers are retained;
+ * anything released beyond that is freed. The free list is guarded by a fiber mutex, so a contended acquire or release
+ * yields to other fibers rather than blocking the thread.
+ */
+template <typename T>
+class BatchBufferPool
+{
+  public:
+    static constexpr std::size_t DefaultMaxBuffers = 64;
+
+    explicit BatchBufferPool(std::size_t max_buffers = DefaultMaxBuffers) : m_max_buffers(max_buffers) {}
+
+    /**
+     * @brief Returns an empty buffer with room for at least `reserve` items, recycled if one is available
+     */
+    std::vector<T> acquire(std::size_t reserve)
+    {
+        std::vector<T> buffer;
+
+        {
+            std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+            if (!m_buffers.empty())
+            {
+                buffer = std::move(m_buffers.back());
+                m_buffers.pop_back();
+            }
+        }
+
+        buffer.reserve(reserve);
+        return buffer;
+    }
+
+    void release(std::vector<T>&& buffer)
+    {
+        if (buffer.capacity() == 0)
+        {
+            return;
+        }
+
+        buffer.clear();
+
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        if (m_buffers.size() < m_max_buffers)
+        {
+            m_buffers.push_back(std::move(buffer));
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<decltype(m_mutex)> lock(m_mutex);
+        return m_buffers.size();
+    }
+
+  private:
+    const std::size_t m_max_buffers;
+    mutable boost::fibers::mutex m_mutex;
+    std::vector<std::vector<T>> m_buffers;
+};
+
+/**
+ * @brief Runnable node which groups its input into std::vector<T> batches.
+ *
+ * A batch is emitted once it holds `max_batch_size` items, or once `max_delay` has passed since its first item was
+ * read, whichever comes first; a partial batch is emitted when the input completes. The delay is enforced with a
+ * deadline read on the input channel, so the time trigger is driven by the scheduler of the engine running the node
+ * rather than by a separate timer. With a `max_delay` of zero, whatever is immediately available is emitted without
+ * waiting for more. Each engine of the node fills its own batch.
+ *
+ * Batch buffers are taken from a BatchBufferPool, which downstream nodes such as Unbatch return drained buffers to.
+ */
+template <typename T, typename ContextT = runnable::Context>
+class Batch : public WritableProvider<T>,
+              public ReadableAcceptor<T>,
+              public SinkChannelOwner<T>,
+              public WritableAcceptor<std::vector<T>>,
+              public ReadableProvider<std::vector<T>>,
+              public SourceChannelOwner<std::vector<T>>,
+              public runnable::RunnableWithContext<ContextT>
+{
+  public:
+    using batch_t = std::vector<T>;
+
+    Batch(std::size_t max_batch_size,
+          std::chrono::microseconds max_delay,
+          std::shared_ptr<BatchBufferPool<T>> pool = nullptr) :
+      m_max_batch_size(max_batch_size),
+      m_max_delay(max_delay),
+      m_pool(pool ? std::move(pool) : std::make_shared<BatchBufferPool<T>>())
+    {
+        if (m_max_batch_size == 0)
+        {
+            throw std::invalid_argument("max_batch_size must be greater than 0");
+        }
+
+        if (m_max_delay.count() < 0)
+        {
+            throw std::invalid_argument("max_delay must not be negative");
+        }
+
+        SinkChannelOwner<T>::set_channel(std::make_unique<mrc::channel::BufferedChannel<T>>());
+        SourceChannelOwner<batch_t>::set_channel(std::make_unique<mrc::channel::BufferedChannel<batch_t>>());
+    }
+
+    ~Batch() override = default;
+
+    std::size_t max_batch_size() const
+    {
+        return m_max_batch_size;
+    }
+
+    std::chrono::microseconds max_delay() const
+    {
+        return m_max_delay;
+    }
+
+    /**
+     * @brief The pool batches are taken from; pass it to the consumers of the batches to recycle their buffers
+     */
+    const std::shared_ptr<BatchBufferPool<T>>& pool() const
+    {
+        return m_pool;
+    }
+
+  private:
+    void run(ContextT& ctx) final
+    {
+        auto input  = SinkProperties<T>::get_readable_edge();
+        auto output = SourceProperties<batch_t>::get_writable_edge();
+
+        ctx.barrier();
+
+        auto batch = m_pool->acquire(m_max_batch_size);
+        channel::time_point_t deadline;
+
+        while (this->state() != runnable::Runnable::State::Kill)
+        {
+            channel::Status status;
+
+            if (batch.empty())
+            {
+                // Nothing is pending, so block for the first item, then take whatever else is already available
+                status   = input->await_read_n(batch, m_max_batch_size);
+                deadline = channel::clock_t::now() + m_max_delay;
+            }
+            else
+            {
+                T item;
+                status = input->await_read_until(item, deadline);
+
+                if (status == channel::Status::success)
+                {
+                    batch.push_back(std::move(item));
+                }
+            }
+
+            if (status == channel::Status::success)
+            {
+                if (batch.size() >= m_max_batch_size)
+                {
+                    emit(*output, batch);
+                }
+            }
+            else if (status == channel::Status::timeout)
+            {
+                emit(*output, batch);
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (!batch.empty())
+        {
+            emit(*output, batch);
+        }
+        m_pool->release(std::move(batch));
+
+        ctx.barrier();
+        if (ctx.rank() == 0)
+        {
+            DVLOG(10) << ctx.info() << " releasing source channel";
+            SourceProperties<batch_t>::release_edge_connection();
+        }
+        ctx.barrier();
+    }
+
+    void emit(edge::IEdgeWritable<batch_t>& output, batch_t& batch)
+    {
+        if (output.await_write(std::move(batch)) != channel::Status::success)
+        {
+            LOG(ERROR) << "Batch failed to write a batch downstream";
+            throw exceptions::MrcRuntimeError("Batch failed to write a batch downstream");
+        }
+
+        batch = m_pool->acquire(m_max_batch_size);
+    }
+
+    const std::size_t m_max_batch_size;
+    const std::chrono::microseconds m_max_delay;
+    std::shared_ptr<BatchBufferPool<T>> m_pool;
+};
+
+/**
+ * @brief Inverse of Batch: writes every item of each incoming std::vector<T> downstream in order.
+ *
+ * When constructed with the BatchBufferPool of the upstream Batch, drained buffers are handed back to it.
+ */
+template <typename T>
+class Unbatch : public NodeComponent<std::vector<T>, T>
+{
+  public:
+    Unbatch(std::shared_ptr<BatchBufferPool<T>> pool = nullptr) : m_pool(std::move(pool)) {}
+
+    ~Unbatch() override = default;
+
+  protected:
+    channel::Status on_next(std::vector<T>&& batch) override
+    {
+        auto status = this->get_writable_edge()->await_write_n(std::span<T>(batch));
+
+        if (m_pool)
+        {
+            m_pool->release(std::move(batch));
+        }
+
+        return status;
+    }
+
+  private:
+    std::shared_ptr<BatchBufferPool<T>> m_pool;
+};
+
+}  // namespace mrc::node
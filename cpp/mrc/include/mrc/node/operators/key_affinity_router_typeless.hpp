@@ -0,0 +1,307 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/edge/deferred_edge.hpp"
+#include "mrc/edge/edge_writable.hpp"
+#include "mrc/utils/type_utils.hpp"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+/**
+ * @brief Typeless router which sends every message with the same key to the same downstream, so state a downstream
+ * keeps per key is never shared with the other downstreams and needs no locking.
+ *
+ * The key of each message is taken by the extractor registered with set_key_extractor<T>() for the type T of the
+ * upstream edge and hashed once per message. The hash is placed on a consistent hash ring on which every downstream
+ * owns `virtual_nodes` points. Connecting a downstream, or removing one with remove_downstream(), rebuilds the ring,
+ * which only moves the keys owned by that downstream, and may be done while messages are flowing.
+ */
+class KeyAffinityRouterTypeless : public edge::IWritableProviderBase, public edge::IWritableAcceptorBase
+{
+    using key_hash_fn_t = std::function<std::uint64_t(const void*)>;
+
+    class HashRing
+    {
+      public:
+        HashRing(const std::vector<std::size_t>& members, std::size_t virtual_nodes)
+        {
+            m_points.reserve(members.size() * virtual_nodes);
+
+            for (auto member : members)
+            {
+                for (std::size_t i = 0; i < virtual_nodes; ++i)
+                {
+                    // points only depend on the member and replica, so they do not move when other members come and go
+                    m_points.emplace_back(mix((std::uint64_t(member) << 32) | i), member);
+                }
+            }
+
+            std::sort(m_points.begin(), m_points.end());
+        }
+
+        std::size_t lookup(std::uint64_t hash) const
+        {
+            CHECK(!m_points.empty()) << "KeyAffinityRouterTypeless has no downstream edges";
+
+            auto point = std::lower_bound(m_points.begin(),
+                                          m_points.end(),
+                                          hash,
+                                          [](const std::pair<std::uint64_t, std::size_t>& point, std::uint64_t hash) {
+                                              return point.first < hash;
+                                          });
+
+            return point == m_points.end() ? m_points.front().second : point->second;
+        }
+
+      private:
+        std::vector<std::pair<std::uint64_t, std::size_t>> m_points;
+    };
+
+    struct Upstream
+    {
+        std::weak_ptr<edge::DeferredWritableMultiEdgeBase> edge;
+        key_hash_fn_t key_hash_fn;
+    };
+
+  public:
+    static constexpr std::size_t DefaultVirtualNodes = 64;
+
+    KeyAffinityRouterTypeless(std::size_t virtual_nodes = DefaultVirtualNodes) :
+      m_virtual_nodes(virtual_nodes),
+      m_ring(std::make_shared<const HashRing>(std::vector<std::size_t>{}, virtual_nodes))
+    {
+        if (virtual_nodes == 0)
+        {
+            throw std::invalid_argument("KeyAffinityRouterTypeless virtual_nodes must be greater than 0");
+        }
+    }
+
+    /**
+     * @brief Registers how messages of type T are keyed; must be called before an upstream edge of type T connects.
+     * @param key_fn Callable taking a const T& and returning a key for which std::hash is specialized.
+     */
+    template <typename T, typename KeyFnT>
+    void set_key_extractor(KeyFnT key_fn)
+    {
+        using key_t = std::decay_t<std::invoke_result_t<KeyFnT&, const T&>>;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_key_hash_fns[typeid(T)] = [key_fn = std::move(key_fn)](const void* value) {
+            return mix(std::hash<key_t>{}(key_fn(*static_cast<const T*>(value))));
+        };
+    }
+
+    /**
+     * @brief Number of downstreams messages are currently routed to.
+     */
+    std::size_t downstream_count() const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_downstream_handles.size();
+    }
+
+    /**
+     * @brief Stops routing messages to a downstream; its keys move to the remaining downstreams. The downstream edge
+     * itself stays connected, and is completed along with the others once every upstream edge has been released.
+     * @param index Position of the downstream in the order downstreams were connected, counting removed downstreams.
+     */
+    void remove_downstream(std::size_t index)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (m_downstream_handles.erase(index) == 0)
+        {
+            throw std::out_of_range("KeyAffinityRouterTypeless has no downstream at index " + std::to_string(index));
+        }
+
+        rebuild_ring();
+    }
+
+    std::shared_ptr<edge::WritableEdgeHandle> get_writable_edge_handle() const override
+    {
+        auto* self = const_cast<KeyAffinityRouterTypeless*>(this);
+
+        // Create a new upstream edge. On connection, have it attach to any downstreams
+        auto deferred_ingress = std::make_shared<edge::DeferredWritableEdgeHandle>(
+            [self](std::shared_ptr<edge::DeferredWritableMultiEdgeBase> deferred_edge) {
+                // Lock whenever working on the handles
+                std::unique_lock<std::mutex> lock(self->m_mutex);
+
+                // The deferred edge now has the type of the upstream, which selects the key extractor
+                auto type  = deferred_edge->get_type().full_type();
+                auto found = self->m_key_hash_fns.find(type);
+
+                CHECK(found != self->m_key_hash_fns.end())
+                    << "KeyAffinityRouterTypeless has no key extractor for type: " << type_name(type);
+
+                auto key_hash_fn = found->second;
+
+                deferred_edge->set_index_for_value_fn(make_index_fn(self->m_ring, key_hash_fn));
+
+                // Need to work with weak ptr here otherwise we will keep it from closing
+                std::weak_ptr<edge::DeferredWritableMultiEdgeBase> weak_deferred_edge = deferred_edge;
+
+                // Use a connector here in case the object never gets set to an edge
+                deferred_edge->add_connector([self, weak_deferred_edge, key_hash_fn]() {
+                    // Lock whenever working on the handles
+                    std::unique_lock<std::mutex> lock(self->m_mutex);
+
+                    // Save to the upstream handles
+                    self->m_upstreams.push_back({weak_deferred_edge, key_hash_fn});
+
+                    auto deferred_edge = weak_deferred_edge.lock();
+
+                    CHECK(deferred_edge) << "Edge was destroyed before making connection.";
+
+                    for (const auto& [index, downstream] : self->m_downstream_handles)
+                    {
+                        // Connect
+                        deferred_edge->set_writable_edge_handle(index, downstream);
+                    }
+
+                    // The ring may have changed since the edge was deferred
+                    deferred_edge->set_index_for_value_fn(make_index_fn(self->m_ring, key_hash_fn));
+
+                    // Now add a disconnector that will remove it from the list
+                    deferred_edge->add_disconnector([self]() {
+                        // Need to lock here since this could be driven by different progress engines
+                        std::unique_lock<std::mutex> lock(self->m_mutex);
+
+                        // Cull all expired ptrs from the list
+                        std::erase_if(self->m_upstreams, [](const Upstream& upstream) {
+                            return upstream.edge.expired();
+                        });
+
+                        // If there are no more upstream handles, then delete the downstream
+                        if (self->m_upstreams.empty())
+                        {
+                            self->m_downstream_handles.clear();
+                        }
+                    });
+                });
+            });
+
+        return deferred_ingress;
+    }
+
+    edge::EdgeTypeInfo writable_provider_type() const override
+    {
+        return edge::EdgeTypeInfo::create_deferred();
+    }
+
+    void set_writable_edge_handle(std::shared_ptr<edge::WritableEdgeHandle> ingress) override
+    {
+        // Lock whenever working on the handles
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // We have a new downstream object. Hold onto it
+        auto index = m_next_index++;
+        m_downstream_handles.emplace(index, ingress);
+
+        // If we have an upstream object, connect it before any message can be routed to the new downstream
+        for (auto& upstream : m_upstreams)
+        {
+            auto upstream_edge = upstream.edge.lock();
+
+            CHECK(upstream_edge) << "Upstream edge went out of scope before downstream edges were connected";
+
+            upstream_edge->set_writable_edge_handle(index, ingress);
+        }
+
+        rebuild_ring();
+    }
+
+    edge::EdgeTypeInfo writable_acceptor_type() const override
+    {
+        return edge::EdgeTypeInfo::create_deferred();
+    }
+
+  private:
+    // splitmix64 finalizer, spreads the low entropy results of std::hash (the identity for integers) over the ring
+    static std::uint64_t mix(std::uint64_t value)
+    {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    static edge::DeferredWritableMultiEdgeBase::determine_index_for_value_fn_t make_index_fn(
+        std::shared_ptr<const HashRing> ring,
+        key_hash_fn_t key_hash_fn)
+    {
+        return [ring = std::move(ring), key_hash_fn = std::move(key_hash_fn)](edge::DeferredWritableMultiEdgeBase&,
+                                                                              const void* value) {
+            return ring->lookup(key_hash_fn(value));
+        };
+    }
+
+    // must be called with m_mutex held
+    void rebuild_ring()
+    {
+        std::vector<std::size_t> members;
+        members.reserve(m_downstream_handles.size());
+
+        for (const auto& [index, _] : m_downstream_handles)
+        {
+            members.push_back(index);
+        }
+
+        m_ring = std::make_shared<const HashRing>(members, m_virtual_nodes);
+
+        for (auto& upstream : m_upstreams)
+        {
+            if (auto upstream_edge = upstream.edge.lock())
+            {
+                upstream_edge->set_index_for_value_fn(make_index_fn(m_ring, upstream.key_hash_fn));
+            }
+        }
+    }
+
+    const std::size_t m_virtual_nodes;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::type_index, key_hash_fn_t> m_key_hash_fns;
+    std::shared_ptr<const HashRing> m_ring;
+    std::size_t m_next_index{0};
+    std::vector<Upstream> m_upstreams;
+    std::map<std::size_t, std::shared_ptr<edge::WritableEdgeHandle>> m_downstream_handles;
+};
+
+}  // namespace mrc::node
@@ -0,0 +1,332 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "mrc/channel/channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/channel/telemetry.hpp"
+#include "mrc/core/userspace_threads.hpp"
+#include "mrc/edge/edge_builder.hpp"
+#include "mrc/edge/edge_writable.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/types.hpp"
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mrc::node {
+
+/**
+ * @brief What a QueuedBroadcast does with a message for a downstream whose queue is full.
+ *
+ * block - the writer waits until the downstream has made room, bounding how far any downstream can lag
+ * drop  - the oldest queued message of that downstream is dropped to make room, as RecentChannel does
+ * spill - the message is queued past the capacity; the queue of a lagging downstream grows without bound
+ */
+enum class LagPolicy
+{
+    block,
+    drop,
+    spill,
+};
+
+/**
+ * @brief Broadcast which wraps each message once in an immutable std::shared_ptr<const T> envelope and hands the same
+ * envelope to every downstream, rather than copying the message for each downstream as Broadcast does.
+ *
+ * Every downstream has its own queue of up to `capacity` envelopes drained by a dedicated fiber, so a slow downstream
+ * only holds up its own queue; what happens once that queue is full is set by the LagPolicy. The fibers are launched
+ * on the thread of the first write, so all downstream edges must be connected before then. Once every upstream edge
+ * has been released, the queues are drained and the downstream edges are released.
+ */
+template <typename T>
+class QueuedBroadcast : public WritableProvider<T>, public edge::IWritableAcceptor<std::shared_ptr<const T>>
+{
+  public:
+    using envelope_t = std::shared_ptr<const T>;
+
+  private:
+    class Lane
+    {
+      public:
+        Lane(std::size_t capacity, LagPolicy policy, std::shared_ptr<channel::ChannelTelemetry> telemetry) :
+          m_capacity(capacity),
+          m_policy(policy),
+          m_telemetry(std::move(telemetry))
+        {}
+
+        void push(const envelope_t& envelope)
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+
+            if (m_queue.size() >= m_capacity && !m_closed)
+            {
+                switch (m_policy)
+                {
+                case LagPolicy::block: {
+                    auto timer = m_telemetry->writer_wait();
+                    timer.start();
+                    m_space_cv.wait(lock, [this] {
+                        return m_queue.size() < m_capacity || m_closed;
+                    });
+                    break;
+                }
+                case LagPolicy::drop:
+                    m_queue.pop_front();
+                    m_telemetry->record_drop(1);
+                    break;
+                case LagPolicy::spill:
+                    break;
+                }
+            }
+
+            // a downstream which failed a write no longer receives anything
+            if (m_closed)
+            {
+                return;
+            }
+
+            m_queue.push_back(envelope);
+            m_telemetry->record_write(1);
+            m_data_cv.notify_one();
+        }
+
+        bool pop(envelope_t& envelope)
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+
+            if (m_queue.empty() && !m_closed)
+            {
+                auto timer = m_telemetry->reader_wait();
+                timer.start();
+                m_data_cv.wait(lock, [this] {
+                    return !m_queue.empty() || m_closed;
+                });
+            }
+
+            // drains the queue after close
+            if (m_queue.empty())
+            {
+                return false;
+            }
+
+            envelope = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_telemetry->record_read(1);
+            m_space_cv.notify_one();
+
+            return true;
+        }
+
+        void close()
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_closed = true;
+            m_data_cv.notify_all();
+            m_space_cv.notify_all();
+        }
+
+        void discard()
+        {
+            std::unique_lock<Mutex> lock(m_mutex);
+            m_telemetry->record_drop(m_queue.size());
+            m_queue.clear();
+            m_closed = true;
+            m_space_cv.notify_all();
+        }
+
+      private:
+        const std::size_t m_capacity;
+        const LagPolicy m_policy;
+        std::shared_ptr<channel::ChannelTelemetry> m_telemetry;
+
+        Mutex m_mutex;
+        CondV m_data_cv;
+        CondV m_space_cv;
+        std::deque<envelope_t> m_queue;
+        bool m_closed{false};
+    };
+
+    class QueuedBroadcastEdge : public edge::IEdgeWritable<T>, public MultiSourceProperties<std::size_t, envelope_t>
+    {
+      public:
+        QueuedBroadcastEdge(QueuedBroadcast& parent, std::size_t capacity, LagPolicy policy) :
+          m_parent(parent),
+          m_capacity(capacity),
+          m_policy(policy)
+        {}
+
+        ~QueuedBroadcastEdge()
+        {
+            for (auto& lane : m_lanes)
+            {
+                lane->close();
+            }
+
+            for (auto& worker : m_workers)
+            {
+                worker.get();
+            }
+
+            this->release_edge_connections();
+
+            m_parent.on_complete();
+        }
+
+        channel::Status await_write(T&& data) override
+        {
+            std::call_once(m_started, [this] {
+                start_workers();
+            });
+
+            auto envelope = std::make_shared<const T>(std::move(data));
+
+            for (auto& lane : m_lanes)
+            {
+                lane->push(envelope);
+            }
+
+            return channel::Status::success;
+        }
+
+        void add_downstream(std::shared_ptr<edge::WritableEdgeHandle> downstream,
+                            std::shared_ptr<channel::ChannelTelemetry> telemetry)
+        {
+            CHECK(m_workers.empty()) << "QueuedBroadcast downstream edges must be connected before the first write";
+
+            auto edge_count = this->edge_connection_count();
+
+            this->make_edge_connection(edge_count, edge::EdgeBuilder::adapt_writable_edge<envelope_t>(downstream));
+            m_lanes.push_back(std::make_unique<Lane>(m_capacity, m_policy, std::move(telemetry)));
+        }
+
+      private:
+        void start_workers()
+        {
+            CHECK(!m_lanes.empty()) << "QueuedBroadcast has no downstream edges";
+
+            for (std::size_t i = 0; i < m_lanes.size(); ++i)
+            {
+                m_workers.push_back(userspace_threads::async(
+                    [lane = m_lanes[i].get()](std::shared_ptr<edge::IEdgeWritable<envelope_t>> downstream) {
+                        envelope_t envelope;
+
+                        while (lane->pop(envelope))
+                        {
+                            if (downstream->await_write(std::move(envelope)) != channel::Status::success)
+                            {
+                                LOG(ERROR) << "QueuedBroadcast downstream write failed; detaching the downstream";
+                                lane->discard();
+                                break;
+                            }
+                        }
+                    },
+                    this->get_writable_edge(i)));
+            }
+        }
+
+        QueuedBroadcast& m_parent;
+        const std::size_t m_capacity;
+        const LagPolicy m_policy;
+
+        std::once_flag m_started;
+        std::vector<std::unique_ptr<Lane>> m_lanes;
+        std::vector<Future<void>> m_workers;
+    };
+
+  public:
+    using source_type_t = envelope_t;
+    using sink_type_t   = T;
+
+    /**
+     * @param capacity Number of envelopes each downstream may have queued before the LagPolicy applies.
+     * @param policy What to do with a message for a downstream whose queue is full.
+     */
+    QueuedBroadcast(std::size_t capacity = channel::default_channel_size(), LagPolicy policy = LagPolicy::block)
+    {
+        if (capacity == 0)
+        {
+            throw std::invalid_argument("QueuedBroadcast capacity must be greater than 0");
+        }
+
+        auto edge = std::make_shared<QueuedBroadcastEdge>(*this, capacity, policy);
+
+        // Save to avoid casting
+        m_edge = edge;
+
+        WritableProvider<T>::init_owned_edge(edge);
+    }
+
+    ~QueuedBroadcast()
+    {
+        VLOG(10) << "Destroying QueuedBroadcast";
+    }
+
+    void set_writable_edge_handle(std::shared_ptr<edge::WritableEdgeHandle> ingress) override
+    {
+        if (auto e = m_edge.lock())
+        {
+            // lanes update their counters under the lane mutex, so tracking the high water mark exactly is free
+            auto telemetry = std::make_shared<channel::ChannelTelemetry>(true);
+            e->add_downstream(std::move(ingress), telemetry);
+            m_downstream_telemetry.push_back(std::move(telemetry));
+        }
+        else
+        {
+            LOG(ERROR) << "Edge was destroyed";
+        }
+    }
+
+    /**
+     * @brief Occupancy and backpressure of each downstream queue, in the order the downstreams were connected. Writer
+     * wait time is only accrued under LagPolicy::block and drops only under LagPolicy::drop. The high water mark is
+     * always tracked exactly for these queues, so one above the capacity shows how far a downstream spilled under
+     * LagPolicy::spill.
+     */
+    std::vector<channel::ChannelStats> downstream_stats() const
+    {
+        std::vector<channel::ChannelStats> stats;
+        stats.reserve(m_downstream_telemetry.size());
+
+        for (const auto& telemetry : m_downstream_telemetry)
+        {
+            stats.push_back(telemetry->stats());
+        }
+
+        return stats;
+    }
+
+    void on_complete()
+    {
+        VLOG(10) << "QueuedBroadcast completed";
+    }
+
+  private:
+    std::weak_ptr<QueuedBroadcastEdge> m_edge;
+    std::vector<std::shared_ptr<const channel::ChannelTelemetry>> m_downstream_telemetry;
+};
+
+}  // namespace mrc::node
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -34,6 +34,7 @@
 #include <rxcpp/rx.hpp>
 
 #include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 
@@ -63,6 +64,17 @@ class RxNode : public RxSinkBase<InputT>,
         make_stream([=](auto start) {
             return (start | ... | ops);
         });
+
+        // The operator types are known here, so also build a subscription which feeds the channel reader through the
+        // operators into the output channel without any type erased observable or observer in between
+        m_static_subscribe = [this, ops...](rxcpp::composite_subscription& subscription) {
+            auto observable_in = rxcpp::observable<>::create<InputT>([this](auto s) {
+                this->progress_engine(s);
+            });
+
+            (observable_in | ... | ops).subscribe(subscription, RxSourceBase<OutputT>::make_static_observer());
+        };
+
         return *this;
     }
 
@@ -82,6 +94,9 @@ class RxNode : public RxSinkBase<InputT>,
     // m_stream works like an operator. It is a function taking an observable and returning an observable. Allows
     // delayed construction of the observable chain for prologue/epilogue
     stream_fn_t m_stream;
+
+    // set by pipe(); used in place of m_stream when no prologue or epilogue taps have been added
+    std::function<void(rxcpp::composite_subscription&)> m_static_subscribe;
 };
 
 template <typename InputT, typename OutputT, typename ContextT>
@@ -102,12 +117,19 @@ RxNode<InputT, OutputT, ContextT>::RxNode(OpsT&&... ops)
 template <typename InputT, typename OutputT, typename ContextT>
 void RxNode<InputT, OutputT, ContextT>::make_stream(stream_fn_t fn)
 {
-    m_stream = std::move(fn);
+    m_stream           = std::move(fn);
+    m_static_subscribe = nullptr;
 }
 
 template <typename InputT, typename OutputT, typename ContextT>
 void RxNode<InputT, OutputT, ContextT>::do_subscribe(rxcpp::composite_subscription& subscription)
 {
+    if (m_static_subscribe && !this->has_prologue_taps() && !this->has_epilogue_taps())
+    {
+        m_static_subscribe(subscription);
+        return;
+    }
+
     // Start with the base sinke observable
     auto observable_in = RxSinkBase<InputT>::observable();
 
@@ -176,15 +198,75 @@ class EdgeRxSubscriber : public edge::IEdgeWritable<T>
     subscriber_t m_subscriber;
 };
 
+/**
+ * @brief Type erased view of an RxNodeComponent used by the segment builder to fuse linear chains of components into a
+ * single observable chain.
+ */
+class RxNodeComponentBase
+{
+  public:
+    virtual ~RxNodeComponentBase() = default;
+
+    /**
+     * @brief Component this one writes into, if the two can be fused. That requires the downstream to be an
+     * RxNodeComponent connected without a type adapter, with this component as its only upstream, and both
+     * components to have a stream.
+     * @return RxNodeComponentBase* or nullptr if there is nothing to fuse into
+     */
+    virtual RxNodeComponentBase* fusable_downstream() const = 0;
+
+    /**
+     * @brief Hands this component's stream to fusable_downstream(), which then subscribes to it in place of its own
+     * input subject, and drops the edge between the two. Items then pass from this component's operators straight
+     * into the downstream's operators. The component must not be given a new stream afterwards.
+     */
+    virtual void fuse_into_downstream() = 0;
+
+    virtual bool has_stream() const = 0;
+};
+
+template <typename T>
+class RxNodeComponentInput : public RxNodeComponentBase
+{
+  public:
+    /**
+     * @brief Replaces the input subject as the head of this component's stream and resubscribes.
+     */
+    virtual void fuse_upstream(rxcpp::observable<T> upstream) = 0;
+};
+
+/**
+ * @brief Input edge of an RxNodeComponent, which lets an upstream component find the component behind it.
+ */
+template <typename T>
+class EdgeRxNodeComponentInput : public EdgeRxSubscriber<T>
+{
+  public:
+    EdgeRxNodeComponentInput(rxcpp::subscriber<T> subscriber, RxNodeComponentInput<T>& component) :
+      EdgeRxSubscriber<T>(std::move(subscriber)),
+      m_component(component)
+    {}
+
+    RxNodeComponentInput<T>& component() const
+    {
+        return m_component;
+    }
+
+  private:
+    RxNodeComponentInput<T>& m_component;
+};
+
 template <typename InputT, typename OutputT>
-class RxNodeComponent : public WritableProvider<InputT>, public WritableAcceptor<OutputT>
+class RxNodeComponent : public WritableProvider<InputT>,
+                        public WritableAcceptor<OutputT>,
+                        public RxNodeComponentInput<InputT>
 {
   public:
     using stream_fn_t = std::function<rxcpp::observable<OutputT>(const rxcpp::observable<InputT>&)>;
 
-    RxNodeComponent()
+    RxNodeComponent() : m_stream_in(m_subject.get_observable())
     {
-        auto edge = std::make_shared<EdgeRxSubscriber<InputT>>(m_subject.get_subscriber());
+        auto edge = std::make_shared<EdgeRxNodeComponentInput<InputT>>(m_subject.get_subscriber(), *this);
 
         WritableProvider<InputT>::init_owned_edge(edge);
     }
@@ -203,33 +285,122 @@ class RxNodeComponent : public WritableProvider<InputT>, public WritableAcceptor
     template <typename... OpsT>
     RxNodeComponent& pipe(OpsT&&... ops)
     {
-        make_stream([=](auto start) {
-            return (start | ... | ops);
-        });
+        // The operator types are known here. Subscribing through m_subscribe_fn keeps the operator chain and the
+        // output observer statically typed, the type erased m_stream_fn is only used when fusing into a downstream
+        auto subscribe_fn = [this, ops...](const rxcpp::observable<InputT>& start) {
+            return (start | ... | ops).subscribe(this->make_output_observer());
+        };
+
+        this->make_stream(
+            [=](auto start) {
+                return (start | ... | ops);
+            },
+            std::move(subscribe_fn));
+
         return *this;
     }
 
     void make_stream(stream_fn_t fn)
     {
+        this->make_stream(std::move(fn), nullptr);
+    }
+
+    bool has_stream() const override
+    {
+        return static_cast<bool>(m_stream_fn);
+    }
+
+    RxNodeComponentBase* fusable_downstream() const override
+    {
+        return this->fusable_downstream_input();
+    }
+
+    void fuse_into_downstream() override
+    {
+        auto* downstream = this->fusable_downstream_input();
+
+        CHECK(downstream != nullptr) << "RxNodeComponent has no downstream it can be fused into";
+
         if (m_subject_subscription.is_subscribed())
         {
             m_subject_subscription.unsubscribe();
         }
 
-        // Start with the base sinke observable
-        auto observable_in = m_subject.get_observable();
+        downstream->fuse_upstream(m_stream_fn(m_stream_in));
+
+        m_fused_into_downstream = true;
+
+        // Nothing writes into the downstream's input edge anymore. Completion now flows through the fused stream
+        WritableAcceptor<OutputT>::release_edge_connection();
+    }
+
+    void fuse_upstream(rxcpp::observable<InputT> upstream) override
+    {
+        m_stream_in = std::move(upstream);
+
+        this->subscribe_stream();
+    }
+
+  private:
+    using subscribe_fn_t = std::function<rxcpp::subscription(const rxcpp::observable<InputT>&)>;
+
+    void make_stream(stream_fn_t fn, subscribe_fn_t subscribe_fn)
+    {
+        if (m_fused_into_downstream)
+        {
+            LOG(ERROR) << "Cannot set the stream of an RxNodeComponent which has been fused into its downstream";
+            throw exceptions::MrcRuntimeError("RxNodeComponent has been fused into its downstream");
+        }
+
+        m_stream_fn    = std::move(fn);
+        m_subscribe_fn = std::move(subscribe_fn);
+
+        this->subscribe_stream();
+    }
+
+    RxNodeComponentInput<OutputT>* fusable_downstream_input() const
+    {
+        if (m_fused_into_downstream || !this->has_stream())
+        {
+            return nullptr;
+        }
+
+        const auto& edge = SourceProperties<OutputT>::get_connected_edge();
+        auto* input      = dynamic_cast<EdgeRxNodeComponentInput<OutputT>*>(edge.get());
+
+        // Any other holder of the edge is either another upstream or an adapter wrapping it
+        if (input == nullptr || edge.use_count() != 1 || !input->component().has_stream())
+        {
+            return nullptr;
+        }
+
+        return &input->component();
+    }
 
-        // // Apply prologue taps
-        // observable_in = this->apply_prologue_taps(observable_in);
+    void subscribe_stream()
+    {
+        if (m_subject_subscription.is_subscribed())
+        {
+            m_subject_subscription.unsubscribe();
+        }
 
-        // Apply the specified stream
-        auto observable_out = fn(observable_in);
+        // The stream is applied to either the input subject or, once fused, the upstream component's stream
+        if (m_subscribe_fn)
+        {
+            m_subject_subscription = m_subscribe_fn(m_stream_in);
+            return;
+        }
 
-        // // Apply epilogue taps
-        // observable_out = this->apply_epilogue_taps(observable_out);
+        auto observable_out = m_stream_fn(m_stream_in);
 
         // Subscribe to the observer
-        m_subject_subscription = observable_out.subscribe(rxcpp::make_observer_dynamic<OutputT>(
+        m_subject_subscription = observable_out.subscribe(
+            rxcpp::make_observer_dynamic<OutputT>(this->make_output_observer()));
+    }
+
+    auto make_output_observer()
+    {
+        return rxcpp::make_observer<OutputT>(
             [this](OutputT message) {
                 // Forward to the writable edge
                 this->get_writable_edge()->await_write(std::move(message));
@@ -241,12 +412,15 @@ class RxNodeComponent : public WritableProvider<InputT>, public WritableAcceptor
             [this]() {
                 // On completion, release connections
                 WritableAcceptor<OutputT>::release_edge_connection();
-            }));
+            });
     }
 
-  private:
     rxcpp::subjects::subject<InputT> m_subject;
+    rxcpp::observable<InputT> m_stream_in;
+    stream_fn_t m_stream_fn;
+    subscribe_fn_t m_subscribe_fn;
     rxcpp::subscription m_subject_subscription;
+    bool m_fused_into_downstream{false};
 };
 
 }  // namespace mrc::node
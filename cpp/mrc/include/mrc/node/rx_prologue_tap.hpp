@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -35,6 +35,11 @@ class RxPrologueTap
     }
 
   protected:
+    bool has_prologue_taps() const
+    {
+        return !m_taps.empty();
+    }
+
     rxcpp::observable<T> apply_prologue_taps(rxcpp::observable<T> observable)
     {
         rxcpp::observable<T> obs = observable;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -40,6 +40,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
 
 namespace mrc::node {
 
@@ -93,13 +94,18 @@ class RxSink : public RxSinkBase<T>, public RxRunnable<ContextT>, public RxProlo
         set_observer(std::forward<ArgsT>(args)...);
     }
 
+    /**
+     * @brief Sets a type erased observer. Every item is dispatched to it through a virtual call.
+     */
     void set_observer(observer_t observer);
 
+    /**
+     * @brief Sets the observer from a statically typed observer or from on_next, on_error and on_completed
+     * callables. Unless prologue taps have been added, items are passed from the channel to the observer without any
+     * type erased observer in between.
+     */
     template <typename... ArgsT>
-    void set_observer(ArgsT&&... args)
-    {
-        set_observer(rxcpp::make_observer_dynamic<T>(std::forward<ArgsT>(args)...));
-    }
+    void set_observer(ArgsT&&... args);
 
   private:
     // the following methods are moved to private from their original scopes to prevent access from deriving classes
@@ -111,37 +117,90 @@ class RxSink : public RxSinkBase<T>, public RxRunnable<ContextT>, public RxProlo
     void on_stop(const rxcpp::subscription& subscription) final;
     void on_kill(const rxcpp::subscription& subscription) final;
 
+    // wraps the observer pointed to by `observer` with the runtime context error handling shared by both
+    // subscription paths. The observer is referenced, not copied, so all subscriptions share one instance
+    template <typename ObserverPtrT>
+    auto make_context_observer(ObserverPtrT observer);
+
     observer_t m_observer;
+
+    // set when the observer's type was known in set_observer; subscribes without type erasing the observer
+    std::function<void(rxcpp::composite_subscription&)> m_static_subscribe;
 };
 
 template <typename T, typename ContextT>
 void RxSink<T, ContextT>::set_observer(rxcpp::observer<T> observer)
 {
-    m_observer = std::move(observer);
+    m_observer         = std::move(observer);
+    m_static_subscribe = nullptr;
 }
 
 template <typename T, typename ContextT>
-void RxSink<T, ContextT>::do_subscribe(rxcpp::composite_subscription& subscription)
+template <typename... ArgsT>
+void RxSink<T, ContextT>::set_observer(ArgsT&&... args)
 {
-    auto observable = RxPrologueTap<T>::apply_prologue_taps(RxSinkBase<T>::observable());
+    // A single observer instance is shared by every subscription, i.e. by every progress engine, the same as a type
+    // erased observer whose copies all share one implementation. Stateful callables are therefore never duplicated.
+    using static_observer_t = decltype(rxcpp::make_observer<T>(std::declval<ArgsT>()...));
+
+    auto observer = std::make_shared<static_observer_t>(rxcpp::make_observer<T>(std::forward<ArgsT>(args)...));
+
+    // The type erased observer is kept for subscriptions which have prologue taps applied
+    m_observer = rxcpp::make_observer_dynamic<T>(
+        [observer](T data) {
+            observer->on_next(std::move(data));
+        },
+        [observer](std::exception_ptr ptr) {
+            observer->on_error(std::move(ptr));
+        },
+        [observer] {
+            observer->on_completed();
+        });
+
+    m_static_subscribe = [this, observer](rxcpp::composite_subscription& subscription) {
+        auto observable = rxcpp::observable<>::create<T>([this](auto s) {
+            this->progress_engine(s);
+        });
 
-    auto default_error_handler = rxcpp::make_observer_dynamic<T>(
-        [this](T data) {
-            m_observer.on_next(std::move(data));
+        observable.subscribe(subscription, this->make_context_observer(observer));
+    };
+}
+
+template <typename T, typename ContextT>
+template <typename ObserverPtrT>
+auto RxSink<T, ContextT>::make_context_observer(ObserverPtrT observer)
+{
+    return rxcpp::make_observer<T>(
+        [observer](T data) {
+            observer->on_next(std::move(data));
         },
-        [this](std::exception_ptr ptr) {
+        [observer](std::exception_ptr ptr) {
             runnable::Context::get_runtime_context().set_exception(std::move(std::current_exception()));
             try
             {
-                m_observer.on_error(std::move(ptr));
+                observer->on_error(std::move(ptr));
             } catch (...)
             {
                 runnable::Context::get_runtime_context().set_exception(std::move(std::current_exception()));
             }
         },
-        [this] {
-            m_observer.on_completed();
+        [observer] {
+            observer->on_completed();
         });
+}
+
+template <typename T, typename ContextT>
+void RxSink<T, ContextT>::do_subscribe(rxcpp::composite_subscription& subscription)
+{
+    if (m_static_subscribe && !this->has_prologue_taps())
+    {
+        m_static_subscribe(subscription);
+        return;
+    }
+
+    auto observable = RxPrologueTap<T>::apply_prologue_taps(RxSinkBase<T>::observable());
+
+    auto default_error_handler = rxcpp::make_observer_dynamic<T>(this->make_context_observer(&m_observer));
 
     observable.subscribe(subscription, default_error_handler);
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -31,11 +31,14 @@
 #include <glog/logging.h>
 #include <rxcpp/rx.hpp>
 
+#include <cstddef>
 #include <exception>
 #include <iomanip>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace mrc::node {
 
@@ -46,18 +49,41 @@ class RxSinkBase : public WritableProvider<T>, public ReadableAcceptor<T>, publi
     void sink_add_watcher(std::shared_ptr<WatcherInterface> watcher);
     void sink_remove_watcher(std::shared_ptr<WatcherInterface> watcher);
 
+    /**
+     * @brief Maximum number of items the progress engine drains from the channel with a single read. Larger batches
+     * amortize channel synchronization, smaller batches spread items more evenly across multiple progress engines
+     * reading the same channel. A value of 1 reads one item at a time.
+     *
+     * Items are removed from the channel when their batch is read. If the subscriber unsubscribes part way through a
+     * batch, the items of that batch which were not yet passed to it are dropped and a warning is logged; no further
+     * batch is read. Larger batches can therefore lose more items on unsubscribe than reading one item at a time.
+     */
+    void set_read_batch_size(std::size_t read_batch_size);
+
   protected:
     RxSinkBase();
     ~RxSinkBase() override = default;
 
     const rxcpp::observable<T>& observable() const;
 
-  private:
-    // this is our channel reader progress engine
-    void progress_engine(rxcpp::subscriber<T>& s);
+    // this is our channel reader progress engine. Templated on the subscriber so that derived classes with a
+    // statically typed subscriber can drive it without going through the type erased observable()
+    template <typename SubscriberT>
+    void progress_engine(SubscriberT& s);
 
+    /**
+     * @brief Called by the progress engine on its own thread before and after the items of each batch read from the
+     * channel are passed to the subscriber. Allows derived nodes to hold a resource across a whole batch rather than
+     * acquiring it for every item. Not called while the progress engine is blocked on the channel.
+     */
+    virtual void on_read_batch_begin() {}
+    virtual void on_read_batch_end() {}
+
+  private:
     // observable
     rxcpp::observable<T> m_observable;
+
+    std::size_t m_read_batch_size{MRC_DEFAULT_SINK_READ_BATCH_SIZE};
 };
 
 template <typename T>
@@ -77,20 +103,62 @@ const rxcpp::observable<T>& RxSinkBase<T>::observable() const
 }
 
 template <typename T>
-void RxSinkBase<T>::progress_engine(rxcpp::subscriber<T>& s)
+template <typename SubscriberT>
+void RxSinkBase<T>::progress_engine(SubscriberT& s)
 {
-    T data;
-    this->watcher_prologue(WatchableEvent::channel_read, &data);
-    while (s.is_subscribed() && (this->get_readable_edge()->await_read(data) == channel::Status::success))
+    auto edge = this->get_readable_edge();
+
+    std::vector<T> batch;
+    batch.reserve(m_read_batch_size);
+
+    // Watchers see one channel_read prologue/epilogue pair per item, all carrying &batch. The first item of a batch
+    // accounts for the time spent waiting in await_read_n, the remaining items were already buffered.
+    this->watcher_prologue(WatchableEvent::channel_read, &batch);
+    while (s.is_subscribed() && (edge->await_read_n(batch, m_read_batch_size) == channel::Status::success))
     {
-        this->watcher_epilogue(WatchableEvent::channel_read, true, &data);
-        this->watcher_prologue(WatchableEvent::sink_on_data, &data);
-        s.on_next(std::move(data));
-        this->watcher_prologue(WatchableEvent::channel_read, &data);
+        this->on_read_batch_begin();
+        Unwinder batch_end([this] {
+            this->on_read_batch_end();
+        });
+
+        std::size_t delivered = 0;
+
+        for (std::size_t i = 0; i < batch.size() && s.is_subscribed(); ++i)
+        {
+            if (i > 0)
+            {
+                this->watcher_prologue(WatchableEvent::channel_read, &batch);
+            }
+
+            this->watcher_epilogue(WatchableEvent::channel_read, true, &batch);
+            this->watcher_prologue(WatchableEvent::sink_on_data, &batch[i]);
+            s.on_next(std::move(batch[i]));
+            ++delivered;
+        }
+
+        if (delivered < batch.size())
+        {
+            LOG(WARNING) << "Sink unsubscribed part way through a batch read from its channel, dropping "
+                         << batch.size() - delivered << " of " << batch.size() << " items";
+        }
+
+        batch.clear();
+        this->watcher_prologue(WatchableEvent::channel_read, &batch);
     }
     s.on_completed();
 }
 
+template <typename T>
+void RxSinkBase<T>::set_read_batch_size(std::size_t read_batch_size)
+{
+    if (read_batch_size == 0)
+    {
+        throw std::invalid_argument("read_batch_size must be greater than 0");
+    }
+
+    m_read_batch_size = read_batch_size;
+}
+
 template <typename T>
 void RxSinkBase<T>::sink_add_watcher(std::shared_ptr<WatcherInterface> watcher)
 {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -60,6 +60,21 @@ class RxSourceBase : public ReadableProvider<T>,
 
     const rxcpp::observer<T>& observer() const;
 
+    // statically typed equivalent of observer(), for subscriptions whose observable type is known at compile time
+    auto make_static_observer()
+    {
+        return rxcpp::make_observer<T>(
+            [this](T data) {
+                this->watcher_epilogue(WatchableEvent::sink_on_data, true, &data);
+                this->watcher_prologue(WatchableEvent::channel_write, &data);
+                this->get_writable_edge()->await_write(std::move(data));
+                this->watcher_epilogue(WatchableEvent::channel_write, true, &data);
+            },
+            [](std::exception_ptr ptr) {
+                runnable::Context::get_runtime_context().set_exception(std::move(ptr));
+            });
+    }
+
   private:
     // // the following methods are moved to private from their original scopes to prevent access from deriving classes
     // using SourceChannelOwner<T>::await_write;
@@ -68,17 +83,7 @@ class RxSourceBase : public ReadableProvider<T>,
 };
 
 template <typename T>
-RxSourceBase<T>::RxSourceBase() :
-  m_observer(rxcpp::make_observer_dynamic<T>(
-      [this](T data) {
-          this->watcher_epilogue(WatchableEvent::sink_on_data, true, &data);
-          this->watcher_prologue(WatchableEvent::channel_write, &data);
-          this->get_writable_edge()->await_write(std::move(data));
-          this->watcher_epilogue(WatchableEvent::channel_write, true, &data);
-      },
-      [](std::exception_ptr ptr) {
-          runnable::Context::get_runtime_context().set_exception(std::move(ptr));
-      }))
+RxSourceBase<T>::RxSourceBase() : m_observer(rxcpp::make_observer_dynamic<T>(make_static_observer()))
 {
     // Set the default channel
     this->set_channel(std::make_unique<mrc::channel::BufferedChannel<T>>());
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -21,6 +21,7 @@
 #include "mrc/node/forward.hpp"
 #include "mrc/node/sink_properties.hpp"
 
+#include <memory>
 #include <mutex>
 
 namespace mrc::node {
@@ -41,6 +42,31 @@ class SinkChannelOwner : public virtual SinkProperties<T>
         this->do_set_channel(edge_channel);
     }
 
+    /**
+     * @brief Occupancy and backpressure counters of the owned channel, or nullptr if no channel has been set
+     */
+    std::shared_ptr<const channel::ChannelTelemetry> sink_channel_telemetry() const
+    {
+        return m_channel_telemetry;
+    }
+
+    /**
+     * @brief True if the owned channel only allows a single writer and a single reader, i.e. ChannelType::ring_spsc.
+     * The reader is this node, so it must be launched with a single engine.
+     */
+    bool sink_channel_is_spsc() const
+    {
+        return m_channel_is_spsc;
+    }
+
+    /**
+     * @brief True once an upstream edge has been connected to the owned channel
+     */
+    bool sink_channel_is_connected() const
+    {
+        return m_channel_is_connected;
+    }
+
   protected:
     SinkChannelOwner() = default;
 
@@ -51,7 +77,13 @@ class SinkChannelOwner : public virtual SinkProperties<T>
         auto channel_reader = edge_channel.get_reader();
         auto channel_writer = edge_channel.get_writer();
 
+        m_channel_telemetry    = edge_channel.telemetry();
+        m_channel_is_spsc      = edge_channel.is_single_producer_single_consumer();
+        m_channel_is_connected = false;
+
         channel_writer->add_connector([this, channel_reader]() {
+            m_channel_is_connected = true;
+
             // Finally, set the other half as the connected edge to allow readers the ability to pull from the channel.
             // Only do this after a full connection has been made to avoid reading from a channel that will never be
             // written to
@@ -60,6 +92,11 @@ class SinkChannelOwner : public virtual SinkProperties<T>
 
         SinkProperties<T>::init_owned_edge(channel_writer);
     }
+
+  private:
+    std::shared_ptr<const channel::ChannelTelemetry> m_channel_telemetry;
+    bool m_channel_is_spsc{false};
+    bool m_channel_is_connected{false};
 };
 
 }  // namespace mrc::node
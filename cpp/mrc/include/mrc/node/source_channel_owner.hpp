@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -43,6 +43,31 @@ class SourceChannelOwner : public virtual SourceProperties<T>
         this->do_set_channel(edge_channel);
     }
 
+    /**
+     * @brief Occupancy and backpressure counters of the owned channel, or nullptr if no channel has been set
+     */
+    std::shared_ptr<const channel::ChannelTelemetry> source_channel_telemetry() const
+    {
+        return m_channel_telemetry;
+    }
+
+    /**
+     * @brief True if the owned channel only allows a single writer and a single reader, i.e. ChannelType::ring_spsc.
+     * The writer is this node, so it must be launched with a single engine.
+     */
+    bool source_channel_is_spsc() const
+    {
+        return m_channel_is_spsc;
+    }
+
+    /**
+     * @brief True once a downstream edge has been connected to the owned channel
+     */
+    bool source_channel_is_connected() const
+    {
+        return m_channel_is_connected;
+    }
+
   protected:
     SourceChannelOwner() = default;
 
@@ -53,7 +78,13 @@ class SourceChannelOwner : public virtual SourceProperties<T>
         auto channel_reader = edge_channel.get_reader();
         auto channel_writer = edge_channel.get_writer();
 
+        m_channel_telemetry    = edge_channel.telemetry();
+        m_channel_is_spsc      = edge_channel.is_single_producer_single_consumer();
+        m_channel_is_connected = false;
+
         channel_reader->add_connector([this, channel_writer]() {
+            m_channel_is_connected = true;
+
             // Finally, set the other half as the connected edge to allow writers the ability to push to the channel.
             // Only do this after a full connection has been made to avoid writing to a channel that will never be
             // read from.
@@ -62,6 +93,11 @@ class SourceChannelOwner : public virtual SourceProperties<T>
 
         SourceProperties<T>::init_owned_edge(channel_reader);
     }
+
+  private:
+    std::shared_ptr<const channel::ChannelTelemetry> m_channel_telemetry;
+    bool m_channel_is_spsc{false};
+    bool m_channel_is_connected{false};
 };
 
 }  // namespace mrc::node
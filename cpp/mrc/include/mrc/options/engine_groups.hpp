@@ -52,6 +52,12 @@ struct EngineFactoryOptions
     // intersection with the union of all other groups is the nullset.
     // if true, the CpuSet assigned to this group can have full or partial overlap with other groups
     bool allow_overlap{false};
+
+    // work sharing - only applies to fiber engines. if true, ready fibers launched by this group are shared among the
+    // task queues of the group's CpuSet, so an idle core in the group can run fibers launched on a busy one. fibers
+    // may change threads whenever they yield or block; runnables relying on thread local state should opt out via
+    // LaunchOptions::allow_work_sharing
+    bool work_sharing{false};
 };
 
 /**
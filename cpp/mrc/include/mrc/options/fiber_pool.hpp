@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -39,14 +39,22 @@ class FiberPoolOptions
      **/
     FiberPoolOptions& enable_tracing_scheduler(bool default_false);
 
+    /**
+     * @brief collect per priority pick counts and ready times in each fiber task queue's scheduler; costs two clock
+     * reads per fiber context switch
+     **/
+    FiberPoolOptions& enable_scheduler_stats(bool default_false);
+
     [[nodiscard]] bool enable_memory_binding() const;
     [[nodiscard]] bool enable_thread_binding() const;
     [[nodiscard]] bool enable_tracing_scheduler() const;
+    [[nodiscard]] bool enable_scheduler_stats() const;
 
   private:
     bool m_enable_memory_binding{true};
     bool m_enable_thread_binding{true};
     bool m_enable_tracing_scheduler{false};
+    bool m_enable_scheduler_stats{false};
 };
 
 }  // namespace mrc
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -47,6 +47,7 @@ class Options
 
     void architect_url(std::string url);
     void enable_server(bool default_false);
+    void enable_node_metrics(bool default_false);
     void server_port(std::uint16_t port);
     void config_request(std::string config);
 
@@ -60,6 +61,7 @@ class Options
     [[nodiscard]] const std::string& architect_url() const;
     [[nodiscard]] const std::string& config_request() const;
     [[nodiscard]] bool enable_server() const;
+    [[nodiscard]] bool enable_node_metrics() const;
     [[nodiscard]] std::uint16_t server_port() const;
 
   private:
@@ -72,6 +74,7 @@ class Options
 
     std::string m_architect_url;
     bool m_enable_server{false};
+    bool m_enable_node_metrics{false};
     std::uint16_t m_server_port{13337};
     std::string m_config_request{"*:1:*"};
 };
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -38,6 +38,11 @@ struct LaunchOptions
     std::size_t pe_count{1};
     std::size_t engines_per_pe{1};
     std::string engine_factory_name{default_engine_factory_name()};
+
+    // if true, fibers launched with these options may migrate between the threads of an engine group which has work
+    // sharing enabled. Off by default since many nodes rely on thread local state; node types which can never migrate
+    // declare `static constexpr bool requires_thread_affinity = true` and ignore this flag
+    bool allow_work_sharing{false};
 };
 
 struct ServiceLaunchOptions : public LaunchOptions
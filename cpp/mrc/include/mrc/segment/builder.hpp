@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,12 +18,15 @@
 #pragma once
 
 #include "mrc/benchmarking/trace_statistics.hpp"
+#include "mrc/channel/factory.hpp"
 #include "mrc/edge/edge_builder.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/node/rx_node.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
-#include "mrc/node/sink_properties.hpp"    // IWYU pragma: keep
+#include "mrc/node/sink_channel_owner.hpp"
+#include "mrc/node/sink_properties.hpp"  // IWYU pragma: keep
+#include "mrc/node/source_channel_owner.hpp"
 #include "mrc/node/source_properties.hpp"  // IWYU pragma: keep
 #include "mrc/runnable/context.hpp"
 #include "mrc/runnable/runnable.hpp"  // IWYU pragma: keep
@@ -42,6 +45,7 @@
 #include <nlohmann/json.hpp>
 #include <rxcpp/rx.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -111,6 +115,21 @@ void add_stats_watcher_if_rx_sink(T& thing, std::string name)
         },
         [name]([[maybe_unused]] auto&& object) {})(thing);
 }
+
+template <typename T, typename MakeWatcherT>
+void add_watcher_if_rx_sink(T& thing, MakeWatcherT&& make_watcher)
+{
+    return hana::if_(
+        has_sink_add_watcher<T>(thing),
+        [&make_watcher](auto&& object) {
+            std::shared_ptr<mrc::WatcherInterface> watcher = make_watcher();
+            if (watcher)
+            {
+                std::forward<decltype(object)>(object).sink_add_watcher(std::move(watcher));
+            }
+        },
+        []([[maybe_unused]] auto&& object) {})(thing);
+}
 }  // namespace
 
 namespace mrc::segment {
@@ -321,6 +340,31 @@ class IBuilder
               MRCObjectProxy SinkObjectT>
     void make_edge(SourceObjectT source, SinkObjectT sink);
 
+    /**
+     * Create an edge between two things that are convertible to ObjectProperties, backing the edge with a channel of
+     * the requested type. The channel replaces the one owned by the sink (writable provider) or the source (readable
+     * provider) and must be set before either side has been connected.
+     * @tparam SourceNodeTypeT Type hint for the source node -- optional
+     * @tparam SinkNodeTypeT Type hint for the sink node -- optional
+     * @tparam SourceObjectT Concept conforming type of the source object
+     * @tparam SinkObjectT Concept conforming type of the sink object
+     * @param source Edge source
+     * @param sink Edge Sink
+     * @param channel_type Channel implementation to use for this edge. `ring_spsc` requires that the edge has exactly
+     * one writer and one reader, i.e. both endpoints run on a single engine and no other edge is connected to the
+     * channel owner. This is checked when the edge is made, when later edges are made to the same channel owner and
+     * when the owner is launched; a violation throws.
+     * @param channel_size Capacity of the channel, must be a power of 2
+     */
+    template <typename SourceNodeTypeT = void,
+              typename SinkNodeTypeT   = SourceNodeTypeT,
+              MRCObjectProxy SourceObjectT,
+              MRCObjectProxy SinkObjectT>
+    void make_edge(SourceObjectT source,
+                   SinkObjectT sink,
+                   channel::ChannelType channel_type,
+                   std::size_t channel_size = channel::default_channel_size());
+
     /**
      *
      * @tparam EdgeDataTypeT
@@ -351,14 +395,25 @@ class IBuilder
     void add_throughput_counter(std::shared_ptr<Object<ObjectT>> segment_object, CallableT&& callable);
 
   private:
-    virtual ObjectProperties& find_object(const std::string& name)                             = 0;
-    virtual void add_object(const std::string& name, std::shared_ptr<ObjectProperties> object) = 0;
-    virtual std::shared_ptr<IngressPortBase> get_ingress_base(const std::string& name)         = 0;
-    virtual std::shared_ptr<EgressPortBase> get_egress_base(const std::string& name)           = 0;
-    virtual std::function<void(std::int64_t)> make_throughput_counter(const std::string& name) = 0;
+    virtual ObjectProperties& find_object(const std::string& name)                               = 0;
+    virtual void add_object(const std::string& name, std::shared_ptr<ObjectProperties> object)   = 0;
+    virtual std::shared_ptr<IngressPortBase> get_ingress_base(const std::string& name)           = 0;
+    virtual std::shared_ptr<EgressPortBase> get_egress_base(const std::string& name)             = 0;
+    virtual std::function<void(std::int64_t)> make_throughput_counter(const std::string& name)   = 0;
+    virtual std::shared_ptr<WatcherInterface> make_node_metrics_watcher(const std::string& name) = 0;
 
     template <MRCObjectProxy ObjectReprT>
     ObjectProperties& to_object_properties(ObjectReprT& repr);
+
+    // Number of engines a runnable object will be launched with. Anything else runs in the context of its caller
+    static std::size_t engine_count(ObjectProperties& object);
+
+    // Throws if the edge would give a ChannelType::ring_spsc channel more than one writer or reader
+    static void check_spsc_edge(ObjectProperties& source_object, ObjectProperties& sink_object, bool is_connected);
+
+    // Runs check_spsc_edge if the channel owned by either endpoint is a ChannelType::ring_spsc channel
+    template <typename SourceNodeTypeT, typename SinkNodeTypeT>
+    static void check_single_producer_single_consumer(ObjectProperties& source_object, ObjectProperties& sink_object);
 };
 
 template <typename ObjectT, typename... ArgsT>
@@ -391,6 +446,11 @@ std::shared_ptr<Object<ObjectT>> IBuilder::make_object(std::string name, std::un
     ::add_stats_watcher_if_rx_source(segment_object->object(), segment_object->name());
     ::add_stats_watcher_if_rx_sink(segment_object->object(), segment_object->name());
 
+    // Returns nullptr unless node metrics have been enabled in the Options
+    ::add_watcher_if_rx_sink(segment_object->object(), [this, &segment_object]() {
+        return this->make_node_metrics_watcher(segment_object->name());
+    });
+
     return segment_object;
 }
 
@@ -477,6 +537,8 @@ void IBuilder::make_edge(SourceObjectT source, SinkObjectT sink)
     VLOG(2) << "Deduced source type: " << mrc::type_name<deduced_source_type_t>() << std::endl;
     VLOG(2) << "Deduced sink type: " << mrc::type_name<deduced_sink_type_t>() << std::endl;
 
+    check_single_producer_single_consumer<deduced_source_type_t, deduced_sink_type_t>(source_object, sink_object);
+
     if (source_object.is_writable_acceptor() && sink_object.is_writable_provider())
     {
         mrc::make_edge(source_object.template writable_acceptor_typed<deduced_source_type_t>(),
@@ -494,6 +556,128 @@ void IBuilder::make_edge(SourceObjectT source, SinkObjectT sink)
     LOG(ERROR) << "Incompatible node types";
 }
 
+template <typename SourceNodeTypeT, typename SinkNodeTypeT, MRCObjectProxy SourceObjectT, MRCObjectProxy SinkObjectT>
+void IBuilder::make_edge(SourceObjectT source,
+                         SinkObjectT sink,
+                         channel::ChannelType channel_type,
+                         std::size_t channel_size)
+{
+    using source_sp_type_t = typename mrc_object_sptr_type_t<SourceObjectT>::source_type_t;  // Might be void
+    using sink_sp_type_t   = typename mrc_object_sptr_type_t<SinkObjectT>::sink_type_t;      // Might be void
+
+    auto& source_object = to_object_properties(source);
+    auto& sink_object   = to_object_properties(sink);
+
+    using deduced_source_type_t =
+        first_non_void_type_t<source_sp_type_t, SourceNodeTypeT, sink_sp_type_t, SinkNodeTypeT>;
+    using deduced_sink_type_t =
+        first_non_void_type_t<sink_sp_type_t, SinkNodeTypeT, source_sp_type_t, SourceNodeTypeT>;
+
+    if (channel_type == channel::ChannelType::ring_spsc)
+    {
+        // Validate before replacing the channel, connections made afterwards are checked by make_edge
+        check_spsc_edge(source_object, sink_object, false);
+    }
+
+    if (source_object.is_writable_acceptor() && sink_object.is_writable_provider())
+    {
+        // The channel lives with the sink
+        auto* owner = dynamic_cast<node::SinkChannelOwner<deduced_sink_type_t>*>(
+            &sink_object.template writable_provider_typed<deduced_sink_type_t>());
+
+        if (owner == nullptr)
+        {
+            throw exceptions::MrcRuntimeError("Sink '" + sink_object.name() +
+                                              "' does not own a channel. Cannot set the channel type for this edge");
+        }
+
+        owner->set_channel(channel::make_channel<deduced_sink_type_t>(channel_type, channel_size));
+    }
+    else if (source_object.is_readable_provider() && sink_object.is_readable_acceptor())
+    {
+        // The channel lives with the source
+        auto* owner = dynamic_cast<node::SourceChannelOwner<deduced_source_type_t>*>(
+            &source_object.template readable_provider_typed<deduced_source_type_t>());
+
+        if (owner == nullptr)
+        {
+            throw exceptions::MrcRuntimeError("Source '" + source_object.name() +
+                                              "' does not own a channel. Cannot set the channel type for this edge");
+        }
+
+        owner->set_channel(channel::make_channel<deduced_source_type_t>(channel_type, channel_size));
+    }
+    else
+    {
+        LOG(ERROR) << "Incompatible node types. Cannot form an edge between '" << source_object.name() << "' and '"
+                   << sink_object.name() << "'";
+        throw exceptions::MrcRuntimeError("Incompatible node types. Cannot set the channel type for this edge");
+    }
+
+    this->make_edge<SourceNodeTypeT, SinkNodeTypeT>(source, sink);
+}
+
+inline std::size_t IBuilder::engine_count(ObjectProperties& object)
+{
+    if (!object.is_runnable())
+    {
+        return 1;
+    }
+
+    const auto& options = object.launch_options();
+    return options.pe_count * options.engines_per_pe;
+}
+
+template <typename SourceNodeTypeT, typename SinkNodeTypeT>
+void IBuilder::check_single_producer_single_consumer(ObjectProperties& source_object, ObjectProperties& sink_object)
+{
+    bool is_spsc      = false;
+    bool is_connected = false;
+
+    if (source_object.is_writable_acceptor() && sink_object.is_writable_provider())
+    {
+        if (auto* owner = dynamic_cast<node::SinkChannelOwner<SinkNodeTypeT>*>(&sink_object.writable_provider_base()))
+        {
+            is_spsc      = owner->sink_channel_is_spsc();
+            is_connected = owner->sink_channel_is_connected();
+        }
+    }
+    else if (source_object.is_readable_provider() && sink_object.is_readable_acceptor())
+    {
+        if (auto* owner = dynamic_cast<node::SourceChannelOwner<SourceNodeTypeT>*>(
+                &source_object.readable_provider_base()))
+        {
+            is_spsc      = owner->source_channel_is_spsc();
+            is_connected = owner->source_channel_is_connected();
+        }
+    }
+
+    if (is_spsc)
+    {
+        check_spsc_edge(source_object, sink_object, is_connected);
+    }
+}
+
+inline void IBuilder::check_spsc_edge(ObjectProperties& source_object, ObjectProperties& sink_object, bool is_connected)
+{
+    if (is_connected)
+    {
+        LOG(ERROR) << "Cannot connect '" << source_object.name() << "' to '" << sink_object.name()
+                   << "': the edge is backed by a ring_spsc channel which already has a connection";
+        throw exceptions::MrcRuntimeError(
+            "A ring_spsc channel only supports a single writer and a single reader. Use ChannelType::ring_mpmc");
+    }
+
+    if (engine_count(source_object) > 1 || engine_count(sink_object) > 1)
+    {
+        LOG(ERROR) << "Cannot connect '" << source_object.name() << "' (" << engine_count(source_object)
+                   << " engines) to '" << sink_object.name() << "' (" << engine_count(sink_object)
+                   << " engines) with a ring_spsc channel";
+        throw exceptions::MrcRuntimeError(
+            "A ring_spsc channel only supports a single writer and a single reader. Use ChannelType::ring_mpmc");
+    }
+}
+
 template <typename EdgeDataTypeT,
           MRCObjectProxy SourceObjectT,
           MRCObjectProxy SinkObjectT,
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -21,6 +21,7 @@
 #include "mrc/manifold/connectable.hpp"
 #include "mrc/manifold/factory.hpp"
 #include "mrc/manifold/interface.hpp"
+#include "mrc/manifold/routing_policy.hpp"
 #include "mrc/node/forward.hpp"
 #include "mrc/node/generic_sink.hpp"
 #include "mrc/node/operators/muxer.hpp"
@@ -58,9 +59,12 @@ class EgressPort final : public Object<node::RxSinkBase<T>>,
     // })
 
   public:
-    EgressPort(SegmentAddress address, PortName name) :
+    EgressPort(SegmentAddress address,
+               PortName name,
+               manifold::RoutingPolicy routing_policy = manifold::RoutingPolicy::round_robin) :
       m_segment_address(address),
       m_port_name(std::move(name)),
+      m_routing_policy(routing_policy),
       m_sink(std::make_unique<node::RxNode<T>>())
     {}
 
@@ -91,12 +95,14 @@ class EgressPort final : public Object<node::RxSinkBase<T>>,
         DCHECK_EQ(manifold->port_name(), m_port_name);
         CHECK(m_sink);
         CHECK(!m_manifold_connected);
+        manifold->set_routing_policy(m_routing_policy);
         manifold->add_input(m_segment_address, m_sink.get());
         m_manifold_connected = true;
     }
 
     SegmentAddress m_segment_address;
     PortName m_port_name;
+    manifold::RoutingPolicy m_routing_policy;
     std::unique_ptr<node::RxNode<T>> m_sink;
     bool m_manifold_connected{false};
     runnable::LaunchOptions m_launch_options;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,9 +17,18 @@
 
 #pragma once
 
+#include "mrc/exceptions/runtime_error.hpp"
+#include "mrc/manifold/routing_policy.hpp"
 #include "mrc/segment/egress_port.hpp"
 #include "mrc/segment/ports.hpp"
 
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace mrc::segment {
 
 struct EgressPortsBase : public Ports<EgressPortBase>
@@ -32,14 +41,32 @@ struct EgressPorts : public EgressPortsBase
 {
     using port_builder_fn_t = typename EgressPortsBase::port_builder_fn_t;
 
-    EgressPorts(std::vector<std::string> names) : EgressPortsBase(std::move(names), get_builders()) {}
+    EgressPorts(std::vector<std::string> names) : EgressPortsBase(std::move(names), get_builders({})) {}
+
+    /**
+     * @param names Unique name of each port
+     * @param routing_policies How the manifold of each port distributes messages between the downstream segment
+     * instances; one per port, or empty for round robin on every port
+     */
+    EgressPorts(std::vector<std::string> names, std::vector<manifold::RoutingPolicy> routing_policies) :
+      EgressPortsBase(std::move(names), get_builders(std::move(routing_policies)))
+    {}
 
   private:
-    static std::vector<port_builder_fn_t> get_builders()
+    static std::vector<port_builder_fn_t> get_builders(std::vector<manifold::RoutingPolicy> routing_policies)
     {
+        if (!routing_policies.empty() && routing_policies.size() != sizeof...(TypesT))
+        {
+            LOG(ERROR) << "expected " << sizeof...(TypesT) << " routing policies; got " << routing_policies.size();
+            throw exceptions::MrcRuntimeError("invalid number of routing policies");
+        }
+
+        routing_policies.resize(sizeof...(TypesT), manifold::RoutingPolicy::round_robin);
+
         std::vector<port_builder_fn_t> builders;
-        (builders.push_back([](const SegmentAddress& address, const PortName& name) {
-            return std::make_shared<EgressPort<TypesT>>(address, name);
+        std::size_t index = 0;
+        (builders.push_back([policy = routing_policies[index++]](const SegmentAddress& address, const PortName& name) {
+            return std::make_shared<EgressPort<TypesT>>(address, name, policy);
         }),
          ...);
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "mrc/channel/ingress.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/edge/edge_builder.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/node/forward.hpp"
@@ -28,6 +29,7 @@
 #include "mrc/runnable/runnable.hpp"
 #include "mrc/segment/forward.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -74,6 +76,12 @@ struct ObjectProperties
 
     virtual runnable::LaunchOptions& launch_options()             = 0;
     virtual const runnable::LaunchOptions& launch_options() const = 0;
+
+    /**
+     * @brief Telemetry of the channels owned by this object, keyed by "input" for a SinkChannelOwner and "output" for
+     * a SourceChannelOwner. Empty if the object owns no channels or has already been moved to the executor.
+     */
+    virtual std::map<std::string, std::shared_ptr<const channel::ChannelTelemetry>> channel_telemetry() = 0;
 };
 
 inline ObjectProperties::~ObjectProperties() = default;
@@ -198,6 +206,8 @@ class Object : public virtual ObjectProperties
         return m_launch_options;
     }
 
+    std::map<std::string, std::shared_ptr<const channel::ChannelTelemetry>> channel_telemetry() final;
+
   protected:
     // Move to protected to allow only the IBuilder to set the name
     void set_name(const std::string& name) override;
@@ -355,4 +365,34 @@ edge::IReadableProviderBase& Object<ObjectT>::readable_provider_base()
     CHECK(base);
     return *base;
 }
+
+template <typename ObjectT>
+std::map<std::string, std::shared_ptr<const channel::ChannelTelemetry>> Object<ObjectT>::channel_telemetry()
+{
+    std::map<std::string, std::shared_ptr<const channel::ChannelTelemetry>> telemetry;
+
+    auto* node = get_object();
+    if (node == nullptr)
+    {
+        return telemetry;
+    }
+
+    if constexpr (requires(ObjectT& obj) { obj.sink_channel_telemetry(); })
+    {
+        if (auto input = node->sink_channel_telemetry())
+        {
+            telemetry["input"] = std::move(input);
+        }
+    }
+
+    if constexpr (requires(ObjectT& obj) { obj.source_channel_telemetry(); })
+    {
+        if (auto output = node->source_channel_telemetry())
+        {
+            telemetry["output"] = std::move(output);
+        }
+    }
+
+    return telemetry;
+}
 }  // namespace mrc::segment
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/runnable/launch_control.hpp"
 #include "mrc/runnable/launch_options.hpp"
 #include "mrc/runnable/launchable.hpp"
@@ -64,8 +65,40 @@ std::unique_ptr<runnable::Launcher> Runnable<NodeT>::prepare_launcher(runnable::
 {
     if constexpr (std::is_base_of_v<runnable::Runnable, NodeT>)
     {
+        // A ring_spsc channel owned by this node is read (sink) or written (source) by every engine of the node
+        bool owns_spsc_channel = false;
+
+        if constexpr (requires(NodeT& node) { node.sink_channel_is_spsc(); })
+        {
+            owns_spsc_channel = owns_spsc_channel || m_node->sink_channel_is_spsc();
+        }
+
+        if constexpr (requires(NodeT& node) { node.source_channel_is_spsc(); })
+        {
+            owns_spsc_channel = owns_spsc_channel || m_node->source_channel_is_spsc();
+        }
+
+        if (owns_spsc_channel && this->launch_options().pe_count * this->launch_options().engines_per_pe > 1)
+        {
+            LOG(ERROR) << "Node '" << this->name() << "' owns a ring_spsc channel and cannot be launched with more "
+                       << "than one engine";
+            throw exceptions::MrcRuntimeError("A ring_spsc channel only supports a single writer and a single reader");
+        }
+
+        auto launch_options = this->launch_options();
+
+        if constexpr (requires { NodeT::requires_thread_affinity; })
+        {
+            if (NodeT::requires_thread_affinity && launch_options.allow_work_sharing)
+            {
+                LOG(WARNING) << "Node '" << this->name() << "' depends on thread local state and cannot migrate "
+                             << "between threads; ignoring allow_work_sharing";
+                launch_options.allow_work_sharing = false;
+            }
+        }
+
         DVLOG(10) << "Preparing launcher for " << this->type_name() << " in segment";
-        return launch_control.prepare_launcher_with_wrapped_context<segment::Context>(this->launch_options(),
+        return launch_control.prepare_launcher_with_wrapped_context<segment::Context>(launch_options,
                                                                                       std::move(m_node),
                                                                                       this->name());
     }
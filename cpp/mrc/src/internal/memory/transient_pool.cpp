@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,22 +17,357 @@
 
 #include "internal/memory/transient_pool.hpp"
 
+#include "mrc/memory/literals.hpp"
+#include "mrc/memory/memory_kind.hpp"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
 #include <ostream>
+#include <vector>
 
 #define MRC_DEBUG 1
 
 namespace mrc::memory {
 
+using namespace literals;
+
+namespace detail {
+
+/**
+ * @brief A block checked out of the block pool and carved into equal sized slots of a single size class.
+ *
+ * All members other than the slot reference counts are guarded by the mutex of the owning size class.
+ */
+struct SlabBlock
+{
+    enum class List
+    {
+        full,
+        partial,
+        empty,
+    };
+
+    SlabBlock(std::shared_ptr<SlabArena> arena,
+              std::size_t size_class,
+              std::size_t slot_bytes,
+              mrc::data::Reusable<mrc::memory::buffer> block) :
+      m_arena(std::move(arena)),
+      m_size_class(size_class),
+      m_slot_bytes(slot_bytes),
+      m_slot_count(block->bytes() / slot_bytes),
+      m_base(static_cast<std::byte*>(block->data())),
+      m_refs(std::make_unique<std::atomic<std::uint32_t>[]>(m_slot_count)),
+      m_block(std::move(block))
+    {
+        m_free.reserve(m_slot_count);
+        for (std::size_t i = m_slot_count; i > 0; i--)
+        {
+            m_free.push_back(i - 1);
+        }
+    }
+
+    ~SlabBlock();
+
+    std::shared_ptr<SlabArena> m_arena;
+    const std::size_t m_size_class;
+    const std::size_t m_slot_bytes;
+    const std::size_t m_slot_count;
+    std::byte* const m_base;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_refs;
+    std::vector<std::uint32_t> m_free;
+    List m_list{List::full};
+    std::size_t m_index{0};
+    std::uint64_t m_retired_epoch{0};
+    mrc::data::Reusable<mrc::memory::buffer> m_block;
+};
+
+/**
+ * @brief Per size class free lists of slab blocks.
+ *
+ * The arena is shared by the TransientPool and every SlabBlock it has checked out, so outstanding TransientBuffers may
+ * safely outlive the pool; close() releases the empty blocks and any remaining block is released with its last slot.
+ */
+class SlabArena final : public std::enable_shared_from_this<SlabArena>
+{
+  public:
+    SlabArena(std::size_t block_size,
+              std::size_t block_count,
+              std::shared_ptr<mrc::data::ReusablePool<mrc::memory::buffer>> pool,
+              std::shared_ptr<TransientPoolCounters> counters,
+              const TransientPoolOptions& options) :
+      m_block_count(block_count),
+      m_recycle_epochs(options.recycle_epochs),
+      m_pool(std::move(pool)),
+      m_counters(std::move(counters))
+    {
+        CHECK(std::has_single_bit(options.min_class_bytes)) << "min_class_bytes must be a power of two";
+        CHECK_LE(options.min_class_bytes, block_size);
+        CHECK_LE(block_size / options.min_class_bytes, std::numeric_limits<std::uint32_t>::max());
+
+        m_min_class_shift = std::countr_zero(options.min_class_bytes);
+        for (std::size_t slot_bytes = options.min_class_bytes; slot_bytes < block_size; slot_bytes <<= 1)
+        {
+            m_classes.push_back(std::make_unique<SizeClass>(slot_bytes));
+        }
+        m_classes.push_back(std::make_unique<SizeClass>(block_size));
+    }
+
+    DELETE_COPYABILITY(SlabArena);
+    DELETE_MOVEABILITY(SlabArena);
+
+    TransientBuffer await_buffer(std::size_t bytes)
+    {
+        auto size_class = class_index(bytes);
+        auto& sc        = *m_classes[size_class];
+
+        {
+            std::lock_guard lock(sc.mutex);
+            // prefer partially used blocks so empty blocks can age out and be recycled
+            auto& list = !sc.partial.empty() ? sc.partial : sc.empty;
+            if (!list.empty())
+            {
+                return take_slot(sc, *list.back(), bytes);
+            }
+        }
+
+        // no free slot in this class; advance the epoch and return stale empty blocks of every class to the block
+        // pool before drawing a fresh block. if the pool is exhausted, every empty block is returned regardless of
+        // its age and blocks are returned as soon as they empty, otherwise await_item could wait indefinitely on
+        // blocks retained by other size classes
+        auto epoch     = m_epoch.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto exhausted = m_blocks_held.fetch_add(1) + 1 > m_block_count;
+        recycle(epoch, exhausted);
+
+        auto item = m_pool->await_item();
+        m_counters->pinned_bytes.fetch_add(item->bytes(), std::memory_order_relaxed);
+        auto* block = new SlabBlock(shared_from_this(), size_class, sc.slot_bytes, std::move(item));
+
+        std::lock_guard lock(sc.mutex);
+        return take_slot(sc, *block, bytes);
+    }
+
+    /**
+     * @brief Return every empty block to the block pool; blocks with outstanding slots are returned as they empty.
+     */
+    void close()
+    {
+        std::vector<std::unique_ptr<SlabBlock>> released;
+        for (auto& sc : m_classes)
+        {
+            std::lock_guard lock(sc->mutex);
+            sc->closed = true;
+            while (!sc->empty.empty())
+            {
+                auto* block = sc->empty.back();
+                unlink(*sc, *block);
+                released.emplace_back(block);
+            }
+        }
+    }
+
+    static void retain(SlabBlock* block, std::uint32_t slot)
+    {
+        block->m_refs[slot].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void release(SlabBlock* block, std::uint32_t slot)
+    {
+        if (block->m_refs[slot].fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+
+        // releasing the last block may destroy the arena, so it must happen after the size class is unlocked
+        std::unique_ptr<SlabBlock> released;
+        {
+            auto& arena = *block->m_arena;
+            auto& sc    = *arena.m_classes[block->m_size_class];
+
+            std::lock_guard lock(sc.mutex);
+            block->m_free.push_back(slot);
+
+            if (block->m_free.size() < block->m_slot_count)
+            {
+                if (block->m_list == SlabBlock::List::full)
+                {
+                    link(sc.partial, *block, SlabBlock::List::partial);
+                }
+                return;
+            }
+
+            unlink(sc, *block);
+            if (sc.closed || arena.m_blocks_held.load() >= arena.m_block_count)
+            {
+                released.reset(block);
+                return;
+            }
+
+            block->m_retired_epoch = arena.m_epoch.load(std::memory_order_relaxed);
+            link(sc.empty, *block, SlabBlock::List::empty);
+        }
+    }
+
+  private:
+    struct SizeClass
+    {
+        explicit SizeClass(std::size_t bytes) : slot_bytes(bytes) {}
+
+        std::mutex mutex;
+        const std::size_t slot_bytes;
+        std::vector<SlabBlock*> partial;
+        std::vector<SlabBlock*> empty;
+        bool closed{false};
+    };
+
+    static void link(std::vector<SlabBlock*>& list, SlabBlock& block, SlabBlock::List id)
+    {
+        block.m_list  = id;
+        block.m_index = list.size();
+        list.push_back(&block);
+    }
+
+    static void unlink(SizeClass& sc, SlabBlock& block)
+    {
+        if (block.m_list == SlabBlock::List::full)
+        {
+            return;
+        }
+
+        auto& list = (block.m_list == SlabBlock::List::partial ? sc.partial : sc.empty);
+        DCHECK_EQ(list[block.m_index], &block);
+        list[block.m_index]          = list.back();
+        list[block.m_index]->m_index = block.m_index;
+        list.pop_back();
+        block.m_list = SlabBlock::List::full;
+    }
+
+    std::size_t class_index(std::size_t bytes) const
+    {
+        auto shift = static_cast<std::size_t>(std::bit_width(bytes > 1 ? bytes - 1 : 0));
+        return std::min(shift > m_min_class_shift ? shift - m_min_class_shift : 0, m_classes.size() - 1);
+    }
+
+    TransientBuffer take_slot(SizeClass& sc, SlabBlock& block, std::size_t bytes)
+    {
+        DCHECK(!block.m_free.empty());
+        auto slot = block.m_free.back();
+        block.m_free.pop_back();
+        block.m_refs[slot].store(1, std::memory_order_relaxed);
+
+        if (block.m_free.empty())
+        {
+            unlink(sc, block);
+        }
+        else if (block.m_list != SlabBlock::List::partial)
+        {
+            unlink(sc, block);
+            link(sc.partial, block, SlabBlock::List::partial);
+        }
+
+        m_counters->allocations.fetch_add(1, std::memory_order_relaxed);
+        m_counters->allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+        return {block.m_base + slot * block.m_slot_bytes, bytes, &block, slot, m_counters.get()};
+    }
+
+    void recycle(std::uint64_t epoch, bool force)
+    {
+        std::vector<std::unique_ptr<SlabBlock>> released;
+        for (auto& sc : m_classes)
+        {
+            std::lock_guard lock(sc->mutex);
+            for (std::size_t i = sc->empty.size(); i > 0; i--)
+            {
+                auto* block = sc->empty[i - 1];
+                if (force || block->m_retired_epoch + m_recycle_epochs <= epoch)
+                {
+                    unlink(*sc, *block);
+                    released.emplace_back(block);
+                }
+            }
+        }
+    }
+
+    const std::size_t m_block_count;
+    const std::size_t m_recycle_epochs;
+    std::size_t m_min_class_shift{0};
+    std::vector<std::unique_ptr<SizeClass>> m_classes;
+    std::atomic<std::uint64_t> m_epoch{0};
+    std::atomic<std::size_t> m_blocks_held{0};
+    const std::shared_ptr<mrc::data::ReusablePool<mrc::memory::buffer>> m_pool;
+    const std::shared_ptr<TransientPoolCounters> m_counters;
+
+    friend SlabBlock;
+};
+
+SlabBlock::~SlabBlock()
+{
+    m_arena->m_blocks_held.fetch_sub(1);
+}
+
+static void advise_huge_pages(mrc::memory::buffer& block)
+{
+    if (block.kind() != memory_kind::host)
+    {
+        LOG(WARNING) << "huge pages requested for a transient pool backed by "
+                     << mrc::memory::kind_string(block.kind()) << " memory; ignoring";
+        return;
+    }
+
+    // madvise requires a page aligned range; only the huge page aligned interior of the block can be promoted
+    constexpr std::size_t HugePageBytes = 2_MiB;
+
+    auto begin = reinterpret_cast<std::uintptr_t>(block.data());
+    auto end   = begin + block.bytes();
+    begin      = (begin + HugePageBytes - 1) & ~(HugePageBytes - 1);
+    end        = end & ~(HugePageBytes - 1);
+
+    if (end > begin && madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) != 0)
+    {
+        LOG(WARNING) << "madvise(MADV_HUGEPAGE) failed: " << std::strerror(errno);
+    }
+}
+
+}  // namespace detail
+
 TransientBuffer::TransientBuffer(void* addr, std::size_t bytes, mrc::data::SharedReusable<mrc::memory::buffer> buffer) :
   m_addr(addr),
   m_bytes(bytes),
   m_buffer(std::move(buffer))
 {}
 
+TransientBuffer::TransientBuffer(void* addr,
+                                 std::size_t bytes,
+                                 mrc::data::SharedReusable<mrc::memory::buffer> buffer,
+                                 detail::TransientPoolCounters* counters) :
+  m_addr(addr),
+  m_bytes(bytes),
+  m_buffer(std::move(buffer)),
+  m_counters(counters)
+{}
+
+TransientBuffer::TransientBuffer(void* addr,
+                                 std::size_t bytes,
+                                 detail::SlabBlock* slab,
+                                 std::uint32_t slot,
+                                 detail::TransientPoolCounters* counters) :
+  m_addr(addr),
+  m_bytes(bytes),
+  m_slab(slab),
+  m_slot(slot),
+  m_counters(counters)
+{}
+
 TransientBuffer::TransientBuffer(void* addr, std::size_t bytes, const TransientBuffer& buffer) :
   m_addr(addr),
   m_bytes(bytes),
-  m_buffer(buffer.m_buffer)
+  m_buffer(buffer.m_buffer),
+  m_slab(buffer.m_slab),
+  m_slot(buffer.m_slot)
 {
     auto* c = static_cast<std::byte*>(addr);
     auto* b = static_cast<std::byte*>(const_cast<void*>(buffer.data()));
@@ -40,6 +375,11 @@ TransientBuffer::TransientBuffer(void* addr, std::size_t bytes, const TransientB
     c += bytes;
     b += buffer.bytes();
     CHECK_LE(c, b);
+
+    if (m_slab != nullptr)
+    {
+        detail::SlabArena::retain(m_slab, m_slot);
+    }
 }
 
 TransientBuffer::~TransientBuffer()
@@ -50,14 +390,21 @@ TransientBuffer::~TransientBuffer()
 TransientBuffer::TransientBuffer(TransientBuffer&& other) noexcept :
   m_addr(std::exchange(other.m_addr, nullptr)),
   m_bytes(std::exchange(other.m_bytes, 0UL)),
-  m_buffer(std::move(other.m_buffer))
+  m_buffer(std::move(other.m_buffer)),
+  m_slab(std::exchange(other.m_slab, nullptr)),
+  m_slot(other.m_slot),
+  m_counters(std::exchange(other.m_counters, nullptr))
 {}
 
 TransientBuffer& TransientBuffer::operator=(TransientBuffer&& other) noexcept
 {
-    m_addr   = std::exchange(other.m_addr, nullptr);
-    m_bytes  = std::exchange(other.m_bytes, 0UL);
-    m_buffer = std::move(other.m_buffer);
+    release();
+    m_addr     = std::exchange(other.m_addr, nullptr);
+    m_bytes    = std::exchange(other.m_bytes, 0UL);
+    m_buffer   = std::move(other.m_buffer);
+    m_slab     = std::exchange(other.m_slab, nullptr);
+    m_slot     = other.m_slot;
+    m_counters = std::exchange(other.m_counters, nullptr);
     return *this;
 }
 
@@ -80,24 +427,62 @@ void TransientBuffer::release()
 {
     if (m_addr != nullptr)
     {
+        // the counters are kept alive by the block pool or slab arena, so they must be updated before either is
+        // released
+        if (m_counters != nullptr)
+        {
+            m_counters->allocated_bytes.fetch_sub(m_bytes, std::memory_order_relaxed);
+            m_counters = nullptr;
+        }
+
         m_addr  = nullptr;
         m_bytes = 0;
         m_buffer.release();
+
+        if (m_slab != nullptr)
+        {
+            detail::SlabArena::release(std::exchange(m_slab, nullptr), m_slot);
+        }
     }
 }
 
 TransientPool::TransientPool(std::size_t block_size,
                              std::size_t block_count,
                              std::shared_ptr<mrc::memory::memory_resource> mr,
-                             std::size_t capacity) :
+                             std::size_t capacity,
+                             TransientPoolOptions options) :
   m_block_size(block_size),
-  m_pool(mrc::data::ReusablePool<mrc::memory::buffer>::create(capacity))
+  m_counters(std::make_shared<detail::TransientPoolCounters>()),
+  m_pool(mrc::data::ReusablePool<mrc::memory::buffer>::create(
+      capacity,
+      [counters = m_counters](mrc::memory::buffer& block) {
+          counters->pinned_bytes.fetch_sub(block.bytes(), std::memory_order_relaxed);
+      })),
+  m_stats_time(std::chrono::steady_clock::now())
 {
     CHECK(m_pool);
     CHECK_LT(block_count, capacity);
     for (int i = 0; i < block_count; i++)
     {
-        m_pool->emplace(block_size, mr);
+        auto block = std::make_unique<mrc::memory::buffer>(block_size, mr);
+        if (options.huge_pages)
+        {
+            detail::advise_huge_pages(*block);
+        }
+        m_pool->add_item(std::move(block));
+    }
+
+    if (options.size_classes)
+    {
+        m_slabs = std::make_shared<detail::SlabArena>(block_size, block_count, m_pool, m_counters, options);
+    }
+}
+
+TransientPool::~TransientPool()
+{
+    if (m_slabs)
+    {
+        m_slabs->close();
     }
 }
 
@@ -109,9 +494,18 @@ TransientBuffer TransientPool::await_buffer(std::size_t bytes)
         throw std::bad_alloc{};
     }
 
+    if (m_slabs)
+    {
+        return m_slabs->await_buffer(bytes);
+    }
+
     if (m_remaining < bytes)
     {
+        // release the previous block before waiting on the pool, otherwise it stays pinned by the pool itself
+        m_buffer.release();
+
         auto buffer = m_pool->await_item();
+        m_counters->pinned_bytes.fetch_add(buffer->bytes(), std::memory_order_relaxed);
         m_addr      = static_cast<std::byte*>(buffer->data());
         m_remaining = buffer->bytes();
         m_buffer    = std::move(buffer);
@@ -122,7 +516,35 @@ TransientBuffer TransientPool::await_buffer(std::size_t bytes)
     m_addr += bytes;
     m_remaining -= bytes;
 
-    return {addr, bytes, m_buffer};
+    m_counters->allocations.fetch_add(1, std::memory_order_relaxed);
+    m_counters->allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    return {addr, bytes, m_buffer, m_counters.get()};
+}
+
+TransientPoolStats TransientPool::stats() const
+{
+    TransientPoolStats stats;
+    stats.pinned_bytes    = m_counters->pinned_bytes.load(std::memory_order_relaxed);
+    stats.allocated_bytes = m_counters->allocated_bytes.load(std::memory_order_relaxed);
+    stats.allocations     = m_counters->allocations.load(std::memory_order_relaxed);
+
+    if (stats.pinned_bytes > 0)
+    {
+        auto allocated      = std::min(stats.allocated_bytes, stats.pinned_bytes);
+        stats.fragmentation = 1.0 - static_cast<double>(allocated) / static_cast<double>(stats.pinned_bytes);
+    }
+
+    std::lock_guard lock(m_stats_mutex);
+    auto now     = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration<double>(now - m_stats_time).count();
+    if (elapsed > 0)
+    {
+        stats.allocations_per_second = static_cast<double>(stats.allocations - m_stats_allocations) / elapsed;
+    }
+    m_stats_time        = now;
+    m_stats_allocations = stats.allocations;
+
+    return stats;
 }
 
 }  // namespace mrc::memory
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -23,8 +23,12 @@
 
 #include <glog/logging.h>
 
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <utility>
 
@@ -34,6 +38,22 @@ struct memory_resource;
 
 namespace mrc::memory {
 
+class TransientPool;
+
+namespace detail {
+
+struct TransientPoolCounters
+{
+    std::atomic<std::size_t> pinned_bytes{0};
+    std::atomic<std::size_t> allocated_bytes{0};
+    std::atomic<std::uint64_t> allocations{0};
+};
+
+class SlabArena;
+struct SlabBlock;
+
+}  // namespace detail
+
 /**
  * @brief A short-lived buffer based on a portion of a data::SharedResable<memory::buffer>
  *
@@ -78,9 +98,25 @@ class TransientBuffer
     void release();
 
   private:
+    TransientBuffer(void* addr,
+                    std::size_t bytes,
+                    mrc::data::SharedReusable<mrc::memory::buffer> buffer,
+                    detail::TransientPoolCounters* counters);
+    TransientBuffer(void* addr,
+                    std::size_t bytes,
+                    detail::SlabBlock* slab,
+                    std::uint32_t slot,
+                    detail::TransientPoolCounters* counters);
+
     void* m_addr{nullptr};
     std::size_t m_bytes{0};
     mrc::data::SharedReusable<mrc::memory::buffer> m_buffer;
+    detail::SlabBlock* m_slab{nullptr};
+    std::uint32_t m_slot{0};
+    detail::TransientPoolCounters* m_counters{nullptr};
+
+    friend TransientPool;
+    friend detail::SlabArena;
 };
 
 /**
@@ -151,6 +187,32 @@ class Transient final : private TransientBuffer
     T* m_data;
 };
 
+struct TransientPoolOptions
+{
+    // carve blocks into power-of-two size classes rather than bump allocating across the whole block
+    bool size_classes{false};
+
+    // smallest size class; must be a power of two
+    std::size_t min_class_bytes{256};
+
+    // number of epochs an empty block is retained by its size class before it is returned to the block pool
+    std::size_t recycle_epochs{2};
+
+    // advise the kernel to back host memory blocks with transparent huge pages. Blocks are still allocated from the
+    // pool's memory resource, so only the 2 MiB aligned interior of each block is advised and whether it is promoted is
+    // up to the kernel; construct the pool with a huge_page_memory_resource for blocks fully backed by huge pages
+    bool huge_pages{false};
+};
+
+struct TransientPoolStats
+{
+    std::size_t pinned_bytes{0};     // bytes of blocks checked out of the block pool
+    std::size_t allocated_bytes{0};  // bytes requested by outstanding buffers
+    double fragmentation{0.0};       // fraction of pinned_bytes not backing an outstanding buffer
+    std::uint64_t allocations{0};
+    double allocations_per_second{0.0};
+};
+
 /**
  * @brief ReusablePool of memory::buffers that are used as reusable reference-counted monotonic memory resources
  *
@@ -162,7 +224,12 @@ class Transient final : private TransientBuffer
  * Allocation of Transisent object should be incredibly fast; even faster than the Reusable/SharedResuable on which they
  * are based, since a single Reusable<memory::buffer> might back 10s-1000s of allocations dependending on size.
  *
- * It is critical that all Transient object allocated from a pool have similar life cycles
+ * It is critical that all Transient object allocated from a pool have similar life cycles. When that cannot be
+ * guaranteed, e.g. a single long-lived message would pin an entire block, enable size classes via
+ * TransientPoolOptions. In that mode each block is assigned to a single power-of-two size class and carved into fixed
+ * size slots; a released slot is immediately reusable by the next allocation of the same class, so a long-lived buffer
+ * pins only its own slot. A block whose slots are all free is kept by its class for a few epochs, where an epoch
+ * advances each time any class draws a fresh block, before it is returned to the block pool for use by any class.
  */
 class TransientPool
 {
@@ -170,7 +237,13 @@ class TransientPool
     TransientPool(std::size_t block_size,
                   std::size_t block_count,
                   std::shared_ptr<mrc::memory::memory_resource> mr,
-                  std::size_t capacity = 64);
+                  std::size_t capacity         = 64,
+                  TransientPoolOptions options = {});
+
+    ~TransientPool();
+
+    DELETE_COPYABILITY(TransientPool);
+    DELETE_MOVEABILITY(TransientPool);
 
     /**
      * @brief Acquire a TransientBuffer of size bytes.
@@ -197,12 +270,25 @@ class TransientPool
         return Transient<T>(std::move(buffer), std::forward<ArgsT>(args)...);
     }
 
+    /**
+     * @brief Pinned bytes, fragmentation and allocation rate of the pool.
+     *
+     * allocations_per_second is measured over the interval since the previous call to stats().
+     */
+    TransientPoolStats stats() const;
+
   private:
     const std::size_t m_block_size;
+    const std::shared_ptr<detail::TransientPoolCounters> m_counters;
     const std::shared_ptr<mrc::data::ReusablePool<mrc::memory::buffer>> m_pool;
+    std::shared_ptr<detail::SlabArena> m_slabs;
     std::byte* m_addr{nullptr};
     std::size_t m_remaining{0};
     mrc::data::SharedReusable<mrc::memory::buffer> m_buffer;
+
+    mutable std::mutex m_stats_mutex;
+    mutable std::chrono::steady_clock::time_point m_stats_time;
+    mutable std::uint64_t m_stats_allocations{0};
 };
 
 }  // namespace mrc::memory
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,7 +17,11 @@
 
 #include "internal/pipeline/pipeline_resources.hpp"
 
+#include "internal/resources/manager.hpp"
+#include "internal/system/system.hpp"
+
 #include "mrc/metrics/registry.hpp"
+#include "mrc/options/options.hpp"
 
 #include <glog/logging.h>
 
@@ -26,7 +30,9 @@ namespace mrc::pipeline {
 PipelineResources::PipelineResources(resources::Manager& resources) :
   m_resources(resources),
   m_metrics_registry(std::make_unique<metrics::Registry>())
-{}
+{
+    m_metrics_registry->enable_node_metrics(resources.system().options().enable_node_metrics());
+}
 
 PipelineResources::~PipelineResources() = default;
 
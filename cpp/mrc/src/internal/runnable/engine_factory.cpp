@@ -20,10 +20,12 @@
 #include "internal/runnable/fiber_engines.hpp"
 #include "internal/runnable/thread_engines.hpp"
 #include "internal/system/fiber_pool.hpp"
+#include "internal/system/fiber_priority_scheduler.hpp"
 #include "internal/system/threading_resources.hpp"
 
 #include "mrc/constants.hpp"
 #include "mrc/core/bitmap.hpp"
+#include "mrc/core/fiber_meta_data.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/runnable/engine_factory.hpp"
 #include "mrc/runnable/launch_options.hpp"
@@ -55,9 +57,14 @@ class FiberEngineFactory : public ::mrc::runnable::EngineFactory
     std::shared_ptr<::mrc::runnable::IEngines> build_engines(const LaunchOptions& launch_options) final
     {
         std::lock_guard<decltype(m_mutex)> lock(m_mutex);
-        return std::make_shared<FiberEngines>(launch_options,
-                                              get_next_n_queues(launch_options.pe_count),
-                                              MRC_DEFAULT_FIBER_PRIORITY);
+
+        FiberMetaData meta{MRC_DEFAULT_FIBER_PRIORITY};
+        if (launch_options.allow_work_sharing)
+        {
+            meta.sharing_group = m_sharing_group;
+        }
+
+        return std::make_shared<FiberEngines>(launch_options, get_next_n_queues(launch_options.pe_count), meta);
     }
 
     ::mrc::runnable::EngineType backend() const final
@@ -65,9 +72,31 @@ class FiberEngineFactory : public ::mrc::runnable::EngineFactory
         return EngineType::Fiber;
     }
 
+  protected:
+    /**
+     * @brief Joins every task queue of pool to a new FiberSharingGroup; fibers launched by this factory will be shared
+     * among them.
+     */
+    void enable_work_sharing(system::FiberPool& pool)
+    {
+        m_sharing_group = std::make_shared<system::FiberSharingGroup>();
+
+        for (std::size_t i = 0; i < pool.thread_count(); ++i)
+        {
+            pool.task_queue(i)
+                .enqueue([group = m_sharing_group] {
+                    auto* scheduler = system::FiberPriorityScheduler::current();
+                    CHECK(scheduler != nullptr) << "fiber task queue is not using the FiberPriorityScheduler";
+                    scheduler->join_sharing_group(group);
+                })
+                .get();
+        }
+    }
+
   private:
     virtual std::vector<std::reference_wrapper<core::FiberTaskQueue>> get_next_n_queues(std::size_t count) = 0;
     std::mutex m_mutex;
+    std::shared_ptr<system::FiberSharingGroup> m_sharing_group;
 };
 
 /**
@@ -76,9 +105,16 @@ class FiberEngineFactory : public ::mrc::runnable::EngineFactory
 class ReusableFiberEngineFactory final : public FiberEngineFactory
 {
   public:
-    ReusableFiberEngineFactory(const system::ThreadingResources& system_resources, const CpuSet& cpu_set) :
+    ReusableFiberEngineFactory(const system::ThreadingResources& system_resources,
+                               const CpuSet& cpu_set,
+                               bool work_sharing) :
       m_pool(system_resources.make_fiber_pool(cpu_set))
-    {}
+    {
+        if (work_sharing)
+        {
+            enable_work_sharing(m_pool);
+        }
+    }
     ~ReusableFiberEngineFactory() final = default;
 
     std::vector<std::reference_wrapper<core::FiberTaskQueue>> get_next_n_queues(std::size_t count) final
@@ -115,9 +151,16 @@ class ReusableFiberEngineFactory final : public FiberEngineFactory
 class SingleUseFiberEngineFactory final : public FiberEngineFactory
 {
   public:
-    SingleUseFiberEngineFactory(const system::ThreadingResources& system_resources, const CpuSet& cpu_set) :
+    SingleUseFiberEngineFactory(const system::ThreadingResources& system_resources,
+                                const CpuSet& cpu_set,
+                                bool work_sharing) :
       m_pool(system_resources.make_fiber_pool(cpu_set))
-    {}
+    {
+        if (work_sharing)
+        {
+            enable_work_sharing(m_pool);
+        }
+    }
     ~SingleUseFiberEngineFactory() final = default;
 
   protected:
@@ -241,15 +284,16 @@ class SingleUseThreadEngineFactory final : public ThreadEngineFactory
 std::shared_ptr<::mrc::runnable::EngineFactory> make_engine_factory(const system::ThreadingResources& system_resources,
                                                                     EngineType engine_type,
                                                                     const CpuSet& cpu_set,
-                                                                    bool reusable)
+                                                                    bool reusable,
+                                                                    bool work_sharing)
 {
     if (engine_type == EngineType::Fiber)
     {
         if (reusable)
         {
-            return std::make_shared<ReusableFiberEngineFactory>(system_resources, cpu_set);
+            return std::make_shared<ReusableFiberEngineFactory>(system_resources, cpu_set, work_sharing);
         }
-        return std::make_shared<SingleUseFiberEngineFactory>(system_resources, cpu_set);
+        return std::make_shared<SingleUseFiberEngineFactory>(system_resources, cpu_set, work_sharing);
     }
 
     if (engine_type == EngineType::Thread)
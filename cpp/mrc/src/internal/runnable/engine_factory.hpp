@@ -33,6 +33,7 @@ namespace mrc::runnable {
 std::shared_ptr<::mrc::runnable::EngineFactory> make_engine_factory(const system::ThreadingResources& system,
                                                                     EngineType engine_type,
                                                                     const CpuSet& cpu_set,
-                                                                    bool reusable);
+                                                                    bool reusable,
+                                                                    bool work_sharing = false);
 
 }  // namespace mrc::runnable
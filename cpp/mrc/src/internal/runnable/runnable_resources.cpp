@@ -54,11 +54,15 @@ RunnableResources::RunnableResources(const system::ThreadingResources& system_re
 
             for (const auto& [name, cpu_set] : host_partition.engine_factory_cpu_sets().fiber_cpu_sets)
             {
-                auto reusable = host_partition.engine_factory_cpu_sets().is_resuable(name);
+                auto reusable     = host_partition.engine_factory_cpu_sets().is_resuable(name);
+                auto work_sharing = host_partition.engine_factory_cpu_sets().is_work_sharing(name);
                 DVLOG(10) << "fiber engine factory: " << name << " using " << cpu_set.str() << " is "
-                          << (reusable ? "resuable" : "not reusable");
-                config.resource_groups[name] =
-                    runnable::make_engine_factory(system_resources, runnable::EngineType::Fiber, cpu_set, reusable);
+                          << (reusable ? "resuable" : "not reusable") << (work_sharing ? "; work sharing" : "");
+                config.resource_groups[name] = runnable::make_engine_factory(system_resources,
+                                                                             runnable::EngineType::Fiber,
+                                                                             cpu_set,
+                                                                             reusable,
+                                                                             work_sharing);
             }
 
             for (const auto& [name, cpu_set] : host_partition.engine_factory_cpu_sets().thread_cpu_sets)
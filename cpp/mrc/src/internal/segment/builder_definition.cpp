@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -23,11 +23,13 @@
 #include "mrc/core/addresses.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/node_watcher.hpp"
 #include "mrc/metrics/registry.hpp"
 #include "mrc/modules/module_registry.hpp"
 #include "mrc/modules/properties/persistent.hpp"  // IWYU pragma: keep
 #include "mrc/modules/segment_modules.hpp"
 #include "mrc/node/port_registry.hpp"
+#include "mrc/node/rx_node.hpp"
 #include "mrc/runnable/launchable.hpp"
 #include "mrc/segment/egress_port.hpp"   // IWYU pragma: keep
 #include "mrc/segment/ingress_port.hpp"  // IWYU pragma: keep
@@ -37,11 +39,15 @@
 #include <glog/logging.h>
 
 #include <exception>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <ostream>
+#include <set>
+#include <sstream>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace {
 
@@ -287,6 +293,13 @@ void BuilderDefinition::initialize()
         // Rethrow after logging
         std::rethrow_exception(std::current_exception());
     }
+
+    this->fuse_components();
+}
+
+const std::map<std::string, std::shared_ptr<ObjectProperties>>& BuilderDefinition::objects() const
+{
+    return m_objects;
 }
 
 const std::map<std::string, std::shared_ptr<mrc::runnable::Launchable>>& BuilderDefinition::nodes() const
@@ -304,6 +317,11 @@ const std::map<std::string, std::shared_ptr<::mrc::segment::IngressPortBase>>& B
     return m_ingress_ports;
 }
 
+const std::vector<std::vector<std::string>>& BuilderDefinition::fused_components() const
+{
+    return m_fused_components;
+}
+
 bool BuilderDefinition::has_object(const std::string& name) const
 {
     auto [global_name, local_name] = this->normalize_name(name);
@@ -402,6 +420,81 @@ std::function<void(std::int64_t)> BuilderDefinition::make_throughput_counter(con
     };
 }
 
+std::shared_ptr<WatcherInterface> BuilderDefinition::make_node_metrics_watcher(const std::string& name)
+{
+    auto& registry = m_resources.metrics_registry();
+    if (!registry.node_metrics_enabled())
+    {
+        return nullptr;
+    }
+
+    auto [global_name, local_name] = this->normalize_name(name);
+
+    auto histogram = registry.make_histogram("mrc_node_on_data_latency_nanoseconds", {{"name", global_name}});
+    return std::make_shared<metrics::NodeLatencyWatcher>(std::move(histogram));
+}
+
+void BuilderDefinition::fuse_components()
+{
+    // Collect every RxNodeComponent in the segment, keeping the order of m_objects so the report is stable
+    std::vector<node::RxNodeComponentBase*> components;
+    std::map<node::RxNodeComponentBase*, std::string> names;
+
+    for (const auto& [local_name, object] : m_objects)
+    {
+        if (!object->is_writable_acceptor())
+        {
+            continue;
+        }
+
+        if (auto* component = dynamic_cast<node::RxNodeComponentBase*>(&object->writable_acceptor_base()))
+        {
+            components.push_back(component);
+            names[component] = local_name;
+        }
+    }
+
+    // Link each component to the one it can be fused into. A component with a fusable upstream is not a chain head
+    std::map<node::RxNodeComponentBase*, node::RxNodeComponentBase*> downstreams;
+    std::set<node::RxNodeComponentBase*> has_upstream;
+
+    for (auto* component : components)
+    {
+        auto* downstream = component->fusable_downstream();
+
+        if (downstream != nullptr && names.contains(downstream))
+        {
+            downstreams[component] = downstream;
+            has_upstream.insert(downstream);
+        }
+    }
+
+    // Fuse from the head of each chain so every component hands over a stream which already includes its upstreams
+    for (auto* head : components)
+    {
+        if (!downstreams.contains(head) || has_upstream.contains(head))
+        {
+            continue;
+        }
+
+        std::vector<std::string> chain{names[head]};
+        std::stringstream sstream;
+        sstream << names[head];
+
+        for (auto* current = head; downstreams.contains(current); current = downstreams[current])
+        {
+            current->fuse_into_downstream();
+
+            chain.push_back(names[downstreams[current]]);
+            sstream << " -> " << chain.back();
+        }
+
+        VLOG(1) << "Segment " << this->name() << ", Rank " << m_rank << ": fused RxNodeComponents " << sstream.str();
+
+        m_fused_components.push_back(std::move(chain));
+    }
+}
+
 void BuilderDefinition::ns_push(std::shared_ptr<mrc::modules::SegmentModule> smodule)
 {
     m_module_stack.push_back(smodule);
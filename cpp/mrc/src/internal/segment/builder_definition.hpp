@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -120,10 +120,16 @@ class BuilderDefinition : public IBuilder
 
     void initialize();
 
+    const std::map<std::string, std::shared_ptr<ObjectProperties>>& objects() const;
     const std::map<std::string, std::shared_ptr<runnable::Launchable>>& nodes() const;
     const std::map<std::string, std::shared_ptr<EgressPortBase>>& egress_ports() const;
     const std::map<std::string, std::shared_ptr<IngressPortBase>>& ingress_ports() const;
 
+    /**
+     * @brief Chains of RxNodeComponents fused by initialize(), each listed by local name from head to tail.
+     */
+    const std::vector<std::vector<std::string>>& fused_components() const;
+
   private:
     // Overriding methods
     ObjectProperties& find_object(const std::string& name) override;
@@ -131,10 +137,14 @@ class BuilderDefinition : public IBuilder
     std::shared_ptr<IngressPortBase> get_ingress_base(const std::string& name) override;
     std::shared_ptr<EgressPortBase> get_egress_base(const std::string& name) override;
     std::function<void(std::int64_t)> make_throughput_counter(const std::string& name) override;
+    std::shared_ptr<WatcherInterface> make_node_metrics_watcher(const std::string& name) override;
 
     // Local methods
     bool has_object(const std::string& name) const;
 
+    // Fuses linear chains of RxNodeComponents into a single observable chain each
+    void fuse_components();
+
     void ns_push(std::shared_ptr<mrc::modules::SegmentModule> smodule);
     void ns_pop();
 
@@ -163,6 +173,8 @@ class BuilderDefinition : public IBuilder
     // ingress/egress - these are also nodes/objects
     std::map<std::string, std::shared_ptr<IngressPortBase>> m_ingress_ports;
     std::map<std::string, std::shared_ptr<EgressPortBase>> m_egress_ports;
+
+    std::vector<std::vector<std::string>> m_fused_components;
 };
 
 }  // namespace mrc::segment
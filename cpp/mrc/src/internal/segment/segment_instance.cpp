@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -24,15 +24,18 @@
 #include "internal/segment/builder_definition.hpp"
 #include "internal/segment/segment_definition.hpp"
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/core/addresses.hpp"
 #include "mrc/core/task_queue.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/manifold/interface.hpp"
+#include "mrc/metrics/registry.hpp"
 #include "mrc/runnable/launchable.hpp"
 #include "mrc/runnable/launcher.hpp"
 #include "mrc/runnable/runner.hpp"
 #include "mrc/segment/egress_port.hpp"
 #include "mrc/segment/ingress_port.hpp"
+#include "mrc/segment/object.hpp"
 #include "mrc/segment/utils.hpp"
 #include "mrc/types.hpp"
 
@@ -76,6 +79,21 @@ SegmentInstance::SegmentInstance(std::shared_ptr<const SegmentDefinition> defini
                         return builder;
                     })
                     .get();
+
+    // the telemetry handles are captured now, the objects themselves are moved to the executor on start
+    for (const auto& [local_name, object] : m_builder->objects())
+    {
+        for (auto& [direction, telemetry] : object->channel_telemetry())
+        {
+            m_resources.metrics_registry().register_channel_telemetry({{"segment", m_name},
+                                                                       {"rank", std::to_string(m_rank)},
+                                                                       {"name", object->name()},
+                                                                       {"direction", direction}},
+                                                                      telemetry);
+
+            m_channel_telemetry[object->name() + ":" + direction] = std::move(telemetry);
+        }
+    }
 }
 
 SegmentInstance::~SegmentInstance()
@@ -103,6 +121,16 @@ const SegmentAddress& SegmentInstance::address() const
     return m_address;
 }
 
+std::map<std::string, channel::ChannelStats> SegmentInstance::channel_stats() const
+{
+    std::map<std::string, channel::ChannelStats> stats;
+    for (const auto& [name, telemetry] : m_channel_telemetry)
+    {
+        stats[name] = telemetry->stats();
+    }
+    return stats;
+}
+
 void SegmentInstance::do_service_start()
 {
     // prepare launchers from m_builder
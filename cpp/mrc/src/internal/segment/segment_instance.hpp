@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -19,6 +19,7 @@
 
 #include "internal/service.hpp"
 
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/runnable/runner.hpp"
 #include "mrc/types.hpp"
 
@@ -57,6 +58,13 @@ class SegmentInstance final : public Service
     std::shared_ptr<manifold::Interface> create_manifold(const PortName& name);
     void attach_manifold(std::shared_ptr<manifold::Interface> manifold);
 
+    /**
+     * @brief Occupancy and backpressure of every channel owned by the segment's objects, keyed by
+     * "<object name>:input" or "<object name>:output". Remains valid after the objects have been moved to the
+     * executor.
+     */
+    std::map<std::string, channel::ChannelStats> channel_stats() const;
+
   protected:
     const std::string& info() const;
 
@@ -83,6 +91,8 @@ class SegmentInstance final : public Service
     std::map<std::string, std::unique_ptr<mrc::runnable::Runner>> m_egress_runners;
     std::map<std::string, std::unique_ptr<mrc::runnable::Runner>> m_ingress_runners;
 
+    std::map<std::string, std::shared_ptr<const channel::ChannelTelemetry>> m_channel_telemetry;
+
     mutable std::mutex m_mutex;
 };
 
@@ -42,6 +42,12 @@ bool EngineFactoryCpuSets::is_resuable(const std::string& name) const
     return search->second;
 }
 
+bool EngineFactoryCpuSets::is_work_sharing(const std::string& name) const
+{
+    auto search = work_sharing.find(name);
+    return search != work_sharing.end() && search->second;
+}
+
 EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
                                                       const Options& options,
                                                       const CpuSet& cpu_set)
@@ -196,7 +202,8 @@ EngineFactoryCpuSets generate_engine_factory_cpu_sets(const Topology& topology,
     DVLOG(10) << "allocating logical cpus for non-overlapping pools";
     for (const auto& kv : engine_groups_map)
     {
-        config.reusable[kv.first] = kv.second.reusable;
+        config.reusable[kv.first]     = kv.second.reusable;
+        config.work_sharing[kv.first] = kv.second.work_sharing;
 
         if (!kv.second.allow_overlap)
         {
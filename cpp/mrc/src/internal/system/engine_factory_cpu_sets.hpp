@@ -34,11 +34,13 @@ class Topology;
 struct EngineFactoryCpuSets
 {
     bool is_resuable(const std::string& name) const;
+    bool is_work_sharing(const std::string& name) const;
     std::size_t main_cpu_id() const;
 
     std::map<std::string, Bitmap> fiber_cpu_sets;
     std::map<std::string, Bitmap> thread_cpu_sets;
     std::map<std::string, bool> reusable;
+    std::map<std::string, bool> work_sharing;
     Bitmap shared_cpus_set;
     bool shared_cpus_has_fibers{false};
 };
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2018-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2018-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -43,10 +43,15 @@ FiberManager::FiberManager(const ThreadingResources& resources) : m_cpu_set(reso
     VLOG(1) << "creating fiber task queues on " << cpu_count << " threads";
     VLOG(1) << "thread_binding : " << (options.fiber_pool().enable_thread_binding() ? " TRUE" : "FALSE");
     VLOG(1) << "memory_binding : " << (options.fiber_pool().enable_memory_binding() ? " TRUE" : "FALSE");
+    VLOG(1) << "scheduler_stats: " << (options.fiber_pool().enable_scheduler_stats() ? " TRUE" : "FALSE");
 
     topology.cpu_set().for_each_bit([&](std::int32_t idx, std::int32_t cpu_id) {
         DVLOG(10) << "initializing fiber queue " << idx << " of " << cpu_count << " on cpu_id " << cpu_id;
-        m_queues[cpu_id] = std::make_unique<FiberTaskQueue>(resources, cpu_id, MRC_CONCAT_STR("fibq[" << idx << "]"));
+        m_queues[cpu_id] = std::make_unique<FiberTaskQueue>(resources,
+                                                            cpu_id,
+                                                            MRC_CONCAT_STR("fibq[" << idx << "]"),
+                                                            64,
+                                                            options.fiber_pool().enable_scheduler_stats());
     });
 }
 
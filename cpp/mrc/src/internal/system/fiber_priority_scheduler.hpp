@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,8 +20,27 @@
 #include <boost/fiber/all.hpp>
 #include <boost/fiber/scheduler.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace mrc::system {
 
+class FiberPriorityScheduler;
+class FiberSharingGroup;
+
 class FiberPriorityProps : public boost::fibers::fiber_properties
 {
   public:
@@ -45,86 +64,507 @@ class FiberPriorityProps : public boost::fibers::fiber_properties
         }
     }
 
+    const std::shared_ptr<FiberSharingGroup>& get_sharing_group() const
+    {
+        return m_sharing_group;
+    }
+
+    // Fibers with a sharing group may be migrated to and run by any thread which has joined the group. Only set this
+    // for fibers which do not depend on thread local state.
+    void set_sharing_group(std::shared_ptr<FiberSharingGroup> group)
+    {
+        if (group != m_sharing_group)
+        {
+            m_sharing_group = std::move(group);
+            notify();
+        }
+    }
+
   private:
+    friend FiberPriorityScheduler;
+
     int m_priority{0};
+
+    std::shared_ptr<FiberSharingGroup> m_sharing_group;
+
+    // priority of the ready list the fiber is linked into; may differ from m_priority until property_change()
+    int m_queued_priority{0};
+
+    // when the fiber was made ready, only recorded when the scheduler is collecting stats
+    std::chrono::steady_clock::time_point m_ready_since;
 };
 
+/**
+ * @brief Per priority level counters collected by a FiberPriorityScheduler.
+ *
+ * Counters are only written by the thread running the scheduler but can be read from any thread. Priorities outside of
+ * the bucketed range of the scheduler are accounted to the nearest level.
+ */
+class FiberPrioritySchedulerStats
+{
+  public:
+    struct Level
+    {
+        int priority;
+        std::uint64_t picks;
+        std::chrono::nanoseconds total_ready_time;
+        std::chrono::nanoseconds max_ready_time;
+    };
+
+    /**
+     * @brief Snapshot of all levels which have been picked at least once, highest priority first
+     */
+    std::vector<Level> levels() const;
+
+    /**
+     * @brief Number of picks which were taken from a FiberSharingGroup, i.e. fibers which may have migrated threads
+     */
+    std::uint64_t shared_picks() const
+    {
+        return m_shared_picks.load(std::memory_order_relaxed);
+    }
+
+  private:
+    friend FiberPriorityScheduler;
+
+    struct Counters
+    {
+        std::atomic<std::uint64_t> picks{0};
+        std::atomic<std::uint64_t> total_ready_ns{0};
+        std::atomic<std::uint64_t> max_ready_ns{0};
+    };
+
+    void record(std::size_t level, std::chrono::steady_clock::duration ready_time)
+    {
+        // single writer, plain load/store pairs avoid the cost of atomic read-modify-writes
+        auto& counters   = m_counters[level];
+        const auto ready = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(ready_time).count());
+
+        counters.picks.store(counters.picks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        counters.total_ready_ns.store(counters.total_ready_ns.load(std::memory_order_relaxed) + ready,
+                                      std::memory_order_relaxed);
+        if (ready > counters.max_ready_ns.load(std::memory_order_relaxed))
+        {
+            counters.max_ready_ns.store(ready, std::memory_order_relaxed);
+        }
+    }
+
+    std::array<Counters, 64> m_counters;
+    std::atomic<std::uint64_t> m_shared_picks{0};
+};
+
+/**
+ * @brief Ready queue shared by the FiberPriorityScheduler of multiple threads.
+ *
+ * Threads join a group with FiberPriorityScheduler::join_sharing_group(). Fibers whose FiberPriorityProps reference the
+ * group are not kept in the ready queue of the thread which woke them; instead they are pushed to the group and picked
+ * by whichever member thread first runs out of local fibers of equal or higher priority.
+ */
+class FiberSharingGroup
+{
+  public:
+    FiberSharingGroup() = default;
+
+    FiberSharingGroup(const FiberSharingGroup&)            = delete;
+    FiberSharingGroup& operator=(const FiberSharingGroup&) = delete;
+
+    /**
+     * @brief Highest priority of the queued fibers; std::numeric_limits<int>::min() when empty
+     */
+    int best_priority() const
+    {
+        return m_best_priority.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const
+    {
+        return m_size.load(std::memory_order_relaxed) == 0;
+    }
+
+  private:
+    friend FiberPriorityScheduler;
+
+    static constexpr int Empty = std::numeric_limits<int>::min();
+
+    void push(boost::fibers::context* ctx, int priority, FiberPriorityScheduler* self);
+    boost::fibers::context* pop(int& priority);
+
+    void add_member(FiberPriorityScheduler* scheduler);
+    void remove_member(FiberPriorityScheduler* scheduler);
+
+    void update_best_priority()
+    {
+        m_best_priority.store(m_ready.empty() ? Empty : m_ready.begin()->first, std::memory_order_relaxed);
+    }
+
+    std::mutex m_mutex;
+    std::map<int, std::deque<boost::fibers::context*>, std::greater<>> m_ready;
+    std::vector<FiberPriorityScheduler*> m_members;
+    std::atomic<int> m_best_priority{Empty};
+    std::atomic<std::size_t> m_size{0};
+};
+
+/**
+ * @brief Fiber scheduling algorithm which always runs the ready fiber with the highest priority; fibers of equal
+ * priority are run round-robin.
+ *
+ * Ready fibers are kept in one intrusive list per priority level together with a bitmap of the non-empty levels, so
+ * both awakened() and pick_next() are O(1) for priorities in [MinBucketedPriority, MaxBucketedPriority]. Fibers with
+ * priorities outside of that range are kept in an ordered map of lists, O(log n) in the number of such priorities.
+ */
 class FiberPriorityScheduler : public boost::fibers::algo::algorithm_with_properties<FiberPriorityProps>
 {
+  public:
+    static constexpr int MinBucketedPriority = -32;
+    static constexpr int MaxBucketedPriority = 31;
+
   private:
     using rqueue_t = boost::fibers::scheduler::ready_queue_type;
 
-    rqueue_t m_rqueue;
+    static constexpr std::size_t LevelCount = MaxBucketedPriority - MinBucketedPriority + 1;
+    static_assert(LevelCount == 64, "the ready bitmap is a single 64-bit word");
+
+    static constexpr int NoPriority = std::numeric_limits<int>::min();
+
+    std::array<rqueue_t, LevelCount> m_levels;
+    std::uint64_t m_ready_levels{0};
+    std::map<int, rqueue_t, std::greater<>> m_overflow;
+    FiberPrioritySchedulerStats* m_stats{nullptr};
+
+    // sharing groups joined by this thread, only touched by the owning thread
+    std::vector<std::shared_ptr<FiberSharingGroup>> m_groups;
+    // set while the thread is parked in suspend_until(), FiberSharingGroup::push() uses it to pick a member to wake
+    std::atomic<bool> m_idle{false};
+
     std::mutex m_mtx{};
     std::condition_variable m_cnd{};
     bool m_flag{false};
 
+    static inline thread_local FiberPriorityScheduler* m_current{nullptr};
+
+    friend FiberSharingGroup;
+
+    static bool is_bucketed(int priority)
+    {
+        return priority >= MinBucketedPriority && priority <= MaxBucketedPriority;
+    }
+
+    static std::size_t level_index(int priority)
+    {
+        return static_cast<std::size_t>(std::clamp(priority, MinBucketedPriority, MaxBucketedPriority) -
+                                        MinBucketedPriority);
+    }
+
+    bool is_member(const FiberSharingGroup* group) const
+    {
+        for (const auto& joined : m_groups)
+        {
+            if (joined.get() == group)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool groups_have_ready_fibers() const
+    {
+        for (const auto& group : m_groups)
+        {
+            if (!group->empty())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void push_back(boost::fibers::context* ctx, FiberPriorityProps& props)
+    {
+        int priority            = props.get_priority();
+        props.m_queued_priority = priority;
+
+        if (is_bucketed(priority)) [[likely]]
+        {
+            auto idx = level_index(priority);
+            m_levels[idx].push_back(*ctx);
+            m_ready_levels |= (std::uint64_t{1} << idx);
+        }
+        else
+        {
+            m_overflow[priority].push_back(*ctx);
+        }
+    }
+
+    // routes a ready fiber either to a sharing group or to the local ready lists
+    void enqueue(boost::fibers::context* ctx, FiberPriorityProps& props)
+    {
+        const auto& group = props.get_sharing_group();
+
+        // pinned contexts (main and dispatcher) can never leave their thread
+        if (group != nullptr && !ctx->is_context(boost::fibers::type::pinned_context) && is_member(group.get()))
+        {
+            props.m_queued_priority = props.get_priority();
+            ctx->detach();
+            group->push(ctx, props.get_priority(), this);
+            return;
+        }
+
+        push_back(ctx, props);
+    }
+
+    boost::fibers::context* pop_front(rqueue_t& queue)
+    {
+        boost::fibers::context* ctx(&queue.front());
+        queue.pop_front();
+        return ctx;
+    }
+
+    int local_best_priority() const
+    {
+        if (!m_overflow.empty() && m_overflow.begin()->first > MaxBucketedPriority)
+        {
+            return m_overflow.begin()->first;
+        }
+        if (m_ready_levels != 0)
+        {
+            return 63 - std::countl_zero(m_ready_levels) + MinBucketedPriority;
+        }
+        if (!m_overflow.empty())
+        {
+            return m_overflow.begin()->first;
+        }
+        return NoPriority;
+    }
+
+    boost::fibers::context* pick_local()
+    {
+        boost::fibers::context* ctx{nullptr};
+
+        // overflow priorities above the bucketed range win over every bucket
+        if (!m_overflow.empty() && m_overflow.begin()->first > MaxBucketedPriority)
+        {
+            auto it = m_overflow.begin();
+            ctx     = pop_front(it->second);
+            if (it->second.empty())
+            {
+                m_overflow.erase(it);
+            }
+        }
+        else if (m_ready_levels != 0)
+        {
+            auto idx = static_cast<std::size_t>(63 - std::countl_zero(m_ready_levels));
+            ctx      = pop_front(m_levels[idx]);
+            if (m_levels[idx].empty())
+            {
+                m_ready_levels &= ~(std::uint64_t{1} << idx);
+            }
+        }
+        else if (!m_overflow.empty())
+        {
+            auto it = m_overflow.begin();
+            ctx     = pop_front(it->second);
+            if (it->second.empty())
+            {
+                m_overflow.erase(it);
+            }
+        }
+
+        return ctx;
+    }
+
+    boost::fibers::context* pick_shared()
+    {
+        // equal priorities prefer the local fiber, it is more likely to still be warm in this cpu's caches
+        FiberSharingGroup* best_group = nullptr;
+        int best_priority             = local_best_priority();
+
+        for (const auto& group : m_groups)
+        {
+            auto priority = group->best_priority();
+            if (priority > best_priority)
+            {
+                best_group    = group.get();
+                best_priority = priority;
+            }
+        }
+
+        if (best_group == nullptr)
+        {
+            return nullptr;
+        }
+
+        int priority = NoPriority;
+        auto* ctx    = best_group->pop(priority);
+        if (ctx == nullptr)
+        {
+            // another member got there first
+            return nullptr;
+        }
+
+        boost::fibers::context::active()->attach(ctx);
+
+        if (m_stats != nullptr)
+        {
+            m_stats->m_shared_picks.store(m_stats->m_shared_picks.load(std::memory_order_relaxed) + 1,
+                                          std::memory_order_relaxed);
+        }
+
+        return ctx;
+    }
+
   public:
-    FiberPriorityScheduler() : m_rqueue() {}  // NOLINT
+    /**
+     * @param stats When not null, per level pick counts and the time fibers sat ready are recorded to stats. Must
+     * outlive the scheduler.
+     */
+    FiberPriorityScheduler(FiberPrioritySchedulerStats* stats = nullptr) : m_stats(stats)  // NOLINT
+    {
+        m_current = this;
+    }
+
+    ~FiberPriorityScheduler() override
+    {
+        for (auto& group : m_groups)
+        {
+            group->remove_member(this);
+        }
+
+        if (m_current == this)
+        {
+            m_current = nullptr;
+        }
+    }
+
+    /**
+     * @brief The scheduler of the calling thread, nullptr if the thread is not using a FiberPriorityScheduler
+     */
+    static FiberPriorityScheduler* current()
+    {
+        return m_current;
+    }
+
+    /**
+     * @brief Lets this thread pick fibers from group. Must be called from the thread owning this scheduler.
+     */
+    void join_sharing_group(std::shared_ptr<FiberSharingGroup> group)
+    {
+        if (group == nullptr || is_member(group.get()))
+        {
+            return;
+        }
+
+        group->add_member(this);
+        m_groups.push_back(std::move(group));
+    }
 
     // For a subclass of algorithm_with_properties<>, it's important to
     // override the correct awakened() overload.
     void awakened(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept final
     {
-        int ctx_priority = props.get_priority();
         // With this scheduler, fibers with higher priority values are
         // preferred over fibers with lower priority values. But fibers with
         // equal priority values are processed in round-robin fashion. So when
-        // we're handed a new context*, put it at the end of the fibers
-        // with that same priority. In other words: search for the first fiber
-        // in the queue with LOWER priority, and insert before that one.
-        rqueue_t::iterator i(
-            std::find_if(m_rqueue.begin(), m_rqueue.end(), [this, ctx_priority](boost::fibers::context& c) {
-                return properties(&c).get_priority() < ctx_priority;
-            }));
-        // Now, whether or not we found a fiber with lower priority,
-        // insert this new fiber here.
-        m_rqueue.insert(i, *ctx);
+        // we're handed a new context*, put it at the end of the list for its priority.
+        if (m_stats != nullptr)
+        {
+            props.m_ready_since = std::chrono::steady_clock::now();
+        }
+
+        enqueue(ctx, props);
     }
 
     boost::fibers::context* pick_next() noexcept final
     {
-        // if ready queue is empty, just tell caller
-        if (m_rqueue.empty())
+        boost::fibers::context* ctx{nullptr};
+
+        if (!m_groups.empty())
+        {
+            ctx = pick_shared();
+        }
+
+        if (ctx == nullptr)
+        {
+            ctx = pick_local();
+        }
+
+        if (ctx == nullptr)
         {
+            // if ready queue is empty, just tell caller
             return nullptr;
         }
-        boost::fibers::context* ctx(&m_rqueue.front());
-        m_rqueue.pop_front();
+
+        if (m_stats != nullptr)
+        {
+            auto& props = properties(ctx);
+            m_stats->record(level_index(props.m_queued_priority),
+                            std::chrono::steady_clock::now() - props.m_ready_since);
+        }
+
         return ctx;
     }
 
     bool has_ready_fibers() const noexcept final
     {
-        return !m_rqueue.empty();
+        return m_ready_levels != 0 || !m_overflow.empty() || groups_have_ready_fibers();
     }
 
     void property_change(boost::fibers::context* ctx, FiberPriorityProps& props) noexcept final
     {
         // Although our priority_props class defines multiple properties, only
-        // one of them (priority) actually calls notify() when changed. The
-        // point of a property_change() override is to reshuffle the ready
-        // queue according to the updated priority value.
+        // priority and the sharing group call notify() when changed. The
+        // point of a property_change() override is to move the fiber to the
+        // ready list of its updated priority value, or to its sharing group.
 
         // 'ctx' might not be in our queue at all, if caller is changing the
-        // priority of (say) the running fiber. If it's not there, no need to
-        // move it: we'll handle it next time it hits awakened().
+        // priority of (say) the running fiber, or it is queued on a sharing group.
+        // If it's not there, no need to move it: we'll handle it next time it hits awakened().
         if (!ctx->ready_is_linked())
         {
             return;
         }
 
-        // Found ctx: unlink it
+        // Found ctx: unlink it and clear the level it was queued on if that left it empty
         ctx->ready_unlink();
 
-        // Here we know that ctx was in our ready queue, but we've unlinked
-        // it. We happen to have a method that will (re-)add a context* to the
-        // right place in the ready queue.
-        awakened(ctx, props);
+        auto old_priority = props.m_queued_priority;
+        if (is_bucketed(old_priority))
+        {
+            auto idx = level_index(old_priority);
+            if (m_levels[idx].empty())
+            {
+                m_ready_levels &= ~(std::uint64_t{1} << idx);
+            }
+        }
+        else
+        {
+            auto it = m_overflow.find(old_priority);
+            if (it != m_overflow.end() && it->second.empty())
+            {
+                m_overflow.erase(it);
+            }
+        }
+
+        // re-add at the end of the new priority's list, the time it became ready is unchanged
+        enqueue(ctx, props);
     }
 
     void suspend_until(std::chrono::steady_clock::time_point const& time_point) noexcept final
     {
+        if (!m_groups.empty())
+        {
+            // advertise that we are idle before the final check; pairs with the fence in FiberSharingGroup::push()
+            m_idle.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (groups_have_ready_fibers())
+            {
+                m_idle.store(false, std::memory_order_relaxed);
+                return;
+            }
+        }
+
         if ((std::chrono::steady_clock::time_point::max)() == time_point)
         {
             std::unique_lock<std::mutex> lk(m_mtx);
@@ -141,6 +581,8 @@ class FiberPriorityScheduler : public boost::fibers::algo::algorithm_with_proper
             });
             m_flag = false;
         }
+
+        m_idle.store(false, std::memory_order_relaxed);
     }
 
     void notify() noexcept final
@@ -152,4 +594,84 @@ class FiberPriorityScheduler : public boost::fibers::algo::algorithm_with_proper
     }
 };
 
+inline void FiberSharingGroup::push(boost::fibers::context* ctx, int priority, FiberPriorityScheduler* self)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_ready[priority].push_back(ctx);
+    m_size.fetch_add(1, std::memory_order_relaxed);
+    update_best_priority();
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // wake a single parked member; busy members will find the fiber on their next pick
+    for (auto* member : m_members)
+    {
+        if (member != self && member->m_idle.exchange(false, std::memory_order_relaxed))
+        {
+            member->notify();
+            break;
+        }
+    }
+}
+
+inline boost::fibers::context* FiberSharingGroup::pop(int& priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_ready.empty())
+    {
+        return nullptr;
+    }
+
+    auto it   = m_ready.begin();
+    priority  = it->first;
+    auto* ctx = it->second.front();
+    it->second.pop_front();
+
+    if (it->second.empty())
+    {
+        m_ready.erase(it);
+    }
+
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+    update_best_priority();
+
+    return ctx;
+}
+
+inline void FiberSharingGroup::add_member(FiberPriorityScheduler* scheduler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_members.push_back(scheduler);
+}
+
+inline void FiberSharingGroup::remove_member(FiberPriorityScheduler* scheduler)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase(m_members, scheduler);
+}
+
+inline std::vector<FiberPrioritySchedulerStats::Level> FiberPrioritySchedulerStats::levels() const
+{
+    std::vector<Level> levels;
+
+    for (std::size_t i = m_counters.size(); i-- > 0;)
+    {
+        const auto& counters = m_counters[i];
+        auto picks           = counters.picks.load(std::memory_order_relaxed);
+        if (picks == 0)
+        {
+            continue;
+        }
+
+        levels.push_back({static_cast<int>(i) + FiberPriorityScheduler::MinBucketedPriority,
+                          picks,
+                          std::chrono::nanoseconds(counters.total_ready_ns.load(std::memory_order_relaxed)),
+                          std::chrono::nanoseconds(counters.max_ready_ns.load(std::memory_order_relaxed))});
+    }
+
+    return levels;
+}
+
 }  // namespace mrc::system
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -41,9 +41,11 @@ namespace mrc::system {
 FiberTaskQueue::FiberTaskQueue(const ThreadingResources& resources,
                                CpuSet cpu_affinity,
                                std::string thread_name,
-                               std::size_t channel_size) :
+                               std::size_t channel_size,
+                               bool enable_scheduler_stats) :
   m_queue(channel_size),
   m_cpu_affinity(std::move(cpu_affinity)),
+  m_enable_scheduler_stats(enable_scheduler_stats),
   m_thread(resources.make_thread(std::move(thread_name), m_cpu_affinity, [this] {
       main();
   }))
@@ -64,6 +66,11 @@ const CpuSet& FiberTaskQueue::affinity() const
     return m_cpu_affinity;
 }
 
+const FiberPrioritySchedulerStats& FiberTaskQueue::scheduler_stats() const
+{
+    return m_scheduler_stats;
+}
+
 boost::fibers::buffered_channel<core::FiberTaskQueue::task_pkg_t>& FiberTaskQueue::task_queue()
 {
     return m_queue;
@@ -71,8 +78,9 @@ boost::fibers::buffered_channel<core::FiberTaskQueue::task_pkg_t>& FiberTaskQueu
 
 void FiberTaskQueue::main()
 {
-    // enable priority scheduler
-    boost::fibers::use_scheduling_algorithm<FiberPriorityScheduler>();
+    // enable priority scheduler, stats cost two clock reads per context switch so they are opt-in
+    boost::fibers::use_scheduling_algorithm<FiberPriorityScheduler>(m_enable_scheduler_stats ? &m_scheduler_stats
+                                                                                             : nullptr);
 
     task_pkg_t task_pkg;
     while (true)
@@ -109,6 +117,7 @@ void FiberTaskQueue::launch(task_pkg_t&& pkg) const
     boost::fibers::fiber fiber(std::move(pkg.first));
     auto& props(fiber.properties<FiberPriorityProps>());
     props.set_priority(pkg.second.priority);
+    props.set_sharing_group(std::move(pkg.second.sharing_group));
     DVLOG(20) << *this << ": created fiber " << fiber.get_id() << " with priority " << pkg.second.priority;
     fiber.detach();
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "internal/system/fiber_priority_scheduler.hpp"
 #include "internal/system/thread.hpp"
 
 #include "mrc/core/bitmap.hpp"
@@ -40,7 +41,8 @@ class FiberTaskQueue final : public core::FiberTaskQueue
     FiberTaskQueue(const ThreadingResources& resources,
                    CpuSet cpu_affinity,
                    std::string thread_name,
-                   std::size_t channel_size = 64);
+                   std::size_t channel_size    = 64,
+                   bool enable_scheduler_stats = false);
     ~FiberTaskQueue() final;
 
     DELETE_COPYABILITY(FiberTaskQueue);
@@ -53,6 +55,12 @@ class FiberTaskQueue final : public core::FiberTaskQueue
 
     void shutdown();
 
+    /**
+     * @brief Per priority level pick counts and ready times of the fibers run by this task queue. Only collected if the
+     * queue was created with enable_scheduler_stats, otherwise all counters remain zero.
+     */
+    const FiberPrioritySchedulerStats& scheduler_stats() const;
+
     friend std::ostream& operator<<(std::ostream& os, const FiberTaskQueue& ftq);
 
   private:
@@ -63,6 +71,8 @@ class FiberTaskQueue final : public core::FiberTaskQueue
 
     boost::fibers::buffered_channel<task_pkg_t> m_queue;
     CpuSet m_cpu_affinity;
+    FiberPrioritySchedulerStats m_scheduler_stats;
+    bool m_enable_scheduler_stats;
     Thread m_thread;
 };
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,38 +17,339 @@
 
 #include "mrc/benchmarking/trace_statistics.hpp"
 
+#include "mrc/benchmarking/latency_histogram.hpp"
 #include "mrc/benchmarking/util.hpp"
 #include "mrc/core/watcher.hpp"  // for WatchableEvent
 
 #include <glog/logging.h>
 #include <nlohmann/json.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <compare>
+#include <cstdint>
 #include <cstdlib>
-#include <iostream>
 #include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <utility>  // for pair, make_pair
+#include <vector>
 
 using nlohmann::json;
 
 namespace mrc::benchmarking {
 
-thread_local std::map<std::string, std::shared_ptr<TraceStatistics>> TraceStatistics::TraceObjectMap{};
+namespace {
+
+using counter_t = std::atomic<std::uint64_t>;
+
+/**
+ * @brief Histogram buckets written by a single thread. Updates are a relaxed load + store rather than a locked
+ * read-modify-write, readers may observe a value that is one update behind.
+ */
+struct ShardHistogram
+{
+    std::array<counter_t, LatencyHistogram::BucketCount> buckets{};
+
+    void record(std::uint64_t value)
+    {
+        auto& bucket = buckets[LatencyHistogram::bucket_index(value)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void clear()
+    {
+        for (auto& bucket : buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void merge_into(LatencyHistogram& histogram) const
+    {
+        for (std::size_t i = 0; i < LatencyHistogram::BucketCount; ++i)
+        {
+            if (auto count = buckets[i].load(std::memory_order_relaxed); count > 0)
+            {
+                histogram.add_to_bucket(i, count);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Statistics for one node as observed by one thread. Only the owning thread writes; scalar totals are updated
+ * inside a seqlock write section so aggregation can take a consistent snapshot of them without blocking the writer.
+ */
+struct alignas(64) NodeCounters
+{
+    counter_t sequence{0};
+    counter_t epoch{0};
+
+    counter_t emission_count{0};
+    counter_t receive_count{0};
+    counter_t channel_sink_reads{0};
+    counter_t channel_source_writes{0};
+    counter_t total_internal_elapsed_ns{0};
+    counter_t total_ch_read_elapsed_ns{0};
+    counter_t total_ch_write_elapsed_ns{0};
+
+    ShardHistogram operator_latency;
+    ShardHistogram channel_read_latency;
+    ShardHistogram channel_write_latency;
+
+    // Owner thread only
+    TimeUtil::time_pt_t internal_chain_start;
+    TimeUtil::time_pt_t channel_read_start;
+    TimeUtil::time_pt_t channel_write_start;
+};
+
+struct CounterSnapshot
+{
+    std::uint64_t emission_count{0};
+    std::uint64_t receive_count{0};
+    std::uint64_t channel_sink_reads{0};
+    std::uint64_t channel_source_writes{0};
+    std::uint64_t total_internal_elapsed_ns{0};
+    std::uint64_t total_ch_read_elapsed_ns{0};
+    std::uint64_t total_ch_write_elapsed_ns{0};
+
+    CounterSnapshot& operator+=(const CounterSnapshot& other)
+    {
+        emission_count += other.emission_count;
+        receive_count += other.receive_count;
+        channel_sink_reads += other.channel_sink_reads;
+        channel_source_writes += other.channel_source_writes;
+        total_internal_elapsed_ns += other.total_internal_elapsed_ns;
+        total_ch_read_elapsed_ns += other.total_ch_read_elapsed_ns;
+        total_ch_write_elapsed_ns += other.total_ch_write_elapsed_ns;
+        return *this;
+    }
+};
+
+/**
+ * @brief Seqlock write section over a thread's own NodeCounters. Counters last written under an older epoch are
+ * zeroed first, which is how reset() clears shards it cannot safely touch from another thread.
+ */
+class CounterUpdate
+{
+  public:
+    CounterUpdate(NodeCounters& counters, std::uint64_t epoch) :
+      m_counters(counters),
+      m_sequence(counters.sequence.load(std::memory_order_relaxed))
+    {
+        m_counters.sequence.store(m_sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (m_counters.epoch.load(std::memory_order_relaxed) != epoch)
+        {
+            m_counters.emission_count.store(0, std::memory_order_relaxed);
+            m_counters.receive_count.store(0, std::memory_order_relaxed);
+            m_counters.channel_sink_reads.store(0, std::memory_order_relaxed);
+            m_counters.channel_source_writes.store(0, std::memory_order_relaxed);
+            m_counters.total_internal_elapsed_ns.store(0, std::memory_order_relaxed);
+            m_counters.total_ch_read_elapsed_ns.store(0, std::memory_order_relaxed);
+            m_counters.total_ch_write_elapsed_ns.store(0, std::memory_order_relaxed);
+            m_counters.operator_latency.clear();
+            m_counters.channel_read_latency.clear();
+            m_counters.channel_write_latency.clear();
+            m_counters.epoch.store(epoch, std::memory_order_relaxed);
+        }
+    }
+
+    ~CounterUpdate()
+    {
+        m_counters.sequence.store(m_sequence + 2, std::memory_order_release);
+    }
+
+    CounterUpdate(const CounterUpdate&)            = delete;
+    CounterUpdate& operator=(const CounterUpdate&) = delete;
+
+    static void add(counter_t& counter, std::uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+  private:
+    NodeCounters& m_counters;
+    const std::uint64_t m_sequence;
+};
+
+/**
+ * @brief All NodeCounters owned by a single thread, indexed by TraceStatistics id. Chunks are allocated lazily by the
+ * owner and published with release stores so readers on other threads can walk them.
+ */
+class ThreadShard
+{
+  public:
+    static constexpr std::size_t ChunkSize = 8;
+    static constexpr std::size_t MaxChunks = TraceStatistics::MaxNodes / ChunkSize;
+
+    using chunk_t = std::array<NodeCounters, ChunkSize>;
+
+    ~ThreadShard()
+    {
+        for (auto& chunk : m_chunks)
+        {
+            delete chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    NodeCounters& local(std::size_t id)
+    {
+        auto& slot  = m_chunks[id / ChunkSize];
+        auto* chunk = slot.load(std::memory_order_relaxed);
+        if (chunk == nullptr)
+        {
+            chunk = new chunk_t{};
+            slot.store(chunk, std::memory_order_release);
+        }
+
+        return (*chunk)[id % ChunkSize];
+    }
+
+    const NodeCounters* find(std::size_t id) const
+    {
+        const auto* chunk = m_chunks[id / ChunkSize].load(std::memory_order_acquire);
+
+        return chunk == nullptr ? nullptr : &(*chunk)[id % ChunkSize];
+    }
+
+  private:
+    std::array<std::atomic<chunk_t*>, MaxChunks> m_chunks{};
+};
+
+/**
+ * @brief Every shard ever created. Shards outlive their threads so that statistics recorded by short lived threads are
+ * still reported.
+ */
+struct ShardRegistry
+{
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadShard>> shards;
+};
+
+ShardRegistry& shard_registry()
+{
+    static ShardRegistry registry;
+    return registry;
+}
+
+std::vector<std::shared_ptr<ThreadShard>> all_shards()
+{
+    auto& registry = shard_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.shards;
+}
+
+NodeCounters& local_counters(std::size_t id)
+{
+    thread_local std::shared_ptr<ThreadShard> shard = [] {
+        auto new_shard = std::make_shared<ThreadShard>();
+        auto& registry = shard_registry();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.shards.push_back(new_shard);
+
+        return new_shard;
+    }();
+
+    return shard->local(id);
+}
+
+/**
+ * @brief Reads a consistent view of the scalar totals for one node on one thread. Returns false if the counters have
+ * not been written since the last reset.
+ */
+bool read_counters(const NodeCounters& counters, std::uint64_t epoch, CounterSnapshot& snapshot)
+{
+    while (true)
+    {
+        auto begin = counters.sequence.load(std::memory_order_acquire);
+        if ((begin & 1) != 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        bool current                       = counters.epoch.load(std::memory_order_relaxed) == epoch;
+        snapshot.emission_count            = counters.emission_count.load(std::memory_order_relaxed);
+        snapshot.receive_count             = counters.receive_count.load(std::memory_order_relaxed);
+        snapshot.channel_sink_reads        = counters.channel_sink_reads.load(std::memory_order_relaxed);
+        snapshot.channel_source_writes     = counters.channel_source_writes.load(std::memory_order_relaxed);
+        snapshot.total_internal_elapsed_ns = counters.total_internal_elapsed_ns.load(std::memory_order_relaxed);
+        snapshot.total_ch_read_elapsed_ns  = counters.total_ch_read_elapsed_ns.load(std::memory_order_relaxed);
+        snapshot.total_ch_write_elapsed_ns = counters.total_ch_write_elapsed_ns.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (counters.sequence.load(std::memory_order_relaxed) == begin)
+        {
+            return current;
+        }
+    }
+}
+
+std::uint64_t elapsed_ns(TimeUtil::time_pt_t start, TimeUtil::time_pt_t now)
+{
+    auto elapsed = now > start ? TimeUtil::time_resolution_unit_t(now - start) : TimeUtil::s_minimum_resolution;
+    return elapsed.count();
+}
+
+enum class LatencyKind
+{
+    operator_latency,
+    channel_read,
+    channel_write,
+};
+
+LatencyHistogram merge_histograms(std::size_t id, std::uint64_t epoch, LatencyKind kind)
+{
+    LatencyHistogram histogram;
+
+    for (const auto& shard : all_shards())
+    {
+        const auto* counters = shard->find(id);
+        if (counters == nullptr || counters->epoch.load(std::memory_order_acquire) != epoch)
+        {
+            continue;
+        }
+
+        switch (kind)
+        {
+        case LatencyKind::operator_latency:
+            counters->operator_latency.merge_into(histogram);
+            break;
+        case LatencyKind::channel_read:
+            counters->channel_read_latency.merge_into(histogram);
+            break;
+        case LatencyKind::channel_write:
+            counters->channel_write_latency.merge_into(histogram);
+            break;
+        }
+    }
+
+    return histogram;
+}
+
+}  // namespace
+
 std::multimap<std::string, std::shared_ptr<TraceStatistics>> TraceStatistics::TraceObjectMultimap{};
 std::recursive_mutex TraceStatistics::s_state_mutex{};
+std::size_t TraceStatistics::s_next_id{0};
 
-bool TraceStatistics::s_trace_operators              = (std::getenv("MRC_TRACE_OPERATORS") != nullptr);
+std::atomic<bool> TraceStatistics::s_trace_operators{std::getenv("MRC_TRACE_OPERATORS") != nullptr};
 bool TraceStatistics::s_trace_operators_set_manually = false;
-bool TraceStatistics::s_trace_channels               = (std::getenv("MRC_TRACE_CHANNELS") != nullptr);
-bool TraceStatistics::s_trace_channels_set_manually  = false;
-bool TraceStatistics::s_initialized                  = false;
+std::atomic<bool> TraceStatistics::s_trace_channels{std::getenv("MRC_TRACE_CHANNELS") != nullptr};
+bool TraceStatistics::s_trace_channels_set_manually = false;
+std::atomic<std::uint64_t> TraceStatistics::s_epoch{1};
+bool TraceStatistics::s_initialized = false;
 
 void TraceStatistics::init()
 {
+    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
+
     if (s_initialized)
     {
         return;
@@ -62,34 +363,34 @@ std::shared_ptr<TraceStatistics> TraceStatistics::get_or_create(const std::strin
 {
     std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
 
-    auto it = TraceObjectMap.find(name);
-    if (it == TraceObjectMap.end())
+    auto it = TraceObjectMultimap.find(name);
+    if (it != TraceObjectMultimap.end())
+    {
+        return it->second;
+    }
+
+    if (s_next_id >= MaxNodes)
     {
         std::stringstream sstream;
-        sstream << name << "_" << std::this_thread::get_id();
+        sstream << "Unable to register TraceStatistics for " << name << ": limit of " << MaxNodes << " reached";
+        throw std::runtime_error(sstream.str());
+    }
 
-        // TraceStatistics constructor is private to force per-thread unique names and to ensure objects are
-        //  tracked correctly via the cross thread multi-map.
-        auto stats           = std::shared_ptr<TraceStatistics>(new TraceStatistics(name));
-        TraceObjectMap[name] = stats;
-        TraceObjectMultimap.insert(std::make_pair(name, stats));
+    // TraceStatistics constructor is private to ensure every object is registered and assigned a unique id.
+    auto stats = std::shared_ptr<TraceStatistics>(new TraceStatistics(name, s_next_id++));
+    TraceObjectMultimap.insert(std::make_pair(name, stats));
 
-        VLOG(5) << "Creating TracerObjectMap entry for " << sstream.str() << " at 0x" << stats.get() << std::endl;
-    }
+    VLOG(5) << "Registering TraceStatistics " << name << " with id " << stats->id() << " at 0x" << stats.get();
 
-    return TraceObjectMap[name];
+    return stats;
 }
 
-TraceStatistics::TraceStatistics(const std::string& name) :
-  m_name(name),
-  m_start_time(TimeUtil::get_delay_compensated_time_point()),
-  m_internal_chain_start(m_start_time),
-  m_channel_read_start(m_start_time),
-  m_channel_write_start(m_start_time),
-  m_parent_id(std::this_thread::get_id())
-{
-    initialize_lookup_tables();
-}
+TraceStatistics::TraceStatistics(std::string name, std::size_t id) :
+  m_name(std::move(name)),
+  m_id(id),
+  m_parent_id(std::this_thread::get_id()),
+  m_start_time(TimeUtil::get_delay_compensated_time_point())
+{}
 
 const std::multimap<std::string, std::shared_ptr<TraceStatistics>>& TraceStatistics::get_thread_local_results_map()
 {
@@ -98,8 +399,11 @@ const std::multimap<std::string, std::shared_ptr<TraceStatistics>>& TraceStatist
 
 void TraceStatistics::trace_operators(bool flag, bool sync_immediate)
 {
-    s_trace_operators              = flag;
-    s_trace_operators_set_manually = true;
+    {
+        std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
+        s_trace_operators              = flag;
+        s_trace_operators_set_manually = true;
+    }
 
     if (sync_immediate)
     {
@@ -109,13 +413,17 @@ void TraceStatistics::trace_operators(bool flag, bool sync_immediate)
 
 std::tuple<bool, bool> TraceStatistics::trace_operators()
 {
-    return std::make_pair(s_trace_operators, s_trace_operators_set_manually);
+    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
+    return std::make_pair(s_trace_operators.load(), s_trace_operators_set_manually);
 }
 
 void TraceStatistics::trace_channels(bool flag, bool sync_immediate)
 {
-    s_trace_channels              = flag;
-    s_trace_channels_set_manually = true;
+    {
+        std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
+        s_trace_channels              = flag;
+        s_trace_channels_set_manually = true;
+    }
 
     if (sync_immediate)
     {
@@ -125,25 +433,63 @@ void TraceStatistics::trace_channels(bool flag, bool sync_immediate)
 
 std::tuple<bool, bool> TraceStatistics::trace_channels()
 {
-    return std::make_pair(s_trace_channels, s_trace_channels_set_manually);
+    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
+    return std::make_pair(s_trace_channels.load(), s_trace_channels_set_manually);
+}
+
+std::size_t TraceStatistics::id() const
+{
+    return m_id;
+}
+
+const std::string& TraceStatistics::name() const
+{
+    return m_name;
+}
+
+LatencyHistogram TraceStatistics::operator_latency_histogram() const
+{
+    return merge_histograms(m_id, s_epoch.load(std::memory_order_acquire), LatencyKind::operator_latency);
+}
+
+LatencyHistogram TraceStatistics::channel_read_latency_histogram() const
+{
+    return merge_histograms(m_id, s_epoch.load(std::memory_order_acquire), LatencyKind::channel_read);
+}
+
+LatencyHistogram TraceStatistics::channel_write_latency_histogram() const
+{
+    return merge_histograms(m_id, s_epoch.load(std::memory_order_acquire), LatencyKind::channel_write);
 }
 
 /*
- * @brief return a snapshot in time of the current state. This does race with the writing thread, so it
- * should be considered approximately accurate.
+ * @brief return a snapshot in time of the current state. Each thread's counters are read consistently, but the
+ * threads keep running while they are merged, so the total should be considered approximately accurate.
  */
 json TraceStatistics::to_json() const
 {
     std::size_t total_elapsed_ns =
-        TimeUtil::time_resolution_unit_t(TimeUtil::get_current_time_point() - m_start_time).count();
+        TimeUtil::time_resolution_unit_t(TimeUtil::get_current_time_point() - m_start_time.load()).count();
 
-    std::size_t emission_count            = m_emission_count;
-    std::size_t receive_count             = m_receive_count;
-    std::size_t ch_read_count             = m_channel_sink_reads;
-    std::size_t ch_write_count            = m_channel_source_writes;
-    std::size_t total_internal_elapsed_ns = m_total_internal_elapsed_ns;
-    std::size_t total_ch_read_elapsed_ns  = m_total_ch_read_elapsed_ns;
-    std::size_t total_ch_write_elapsed_ns = m_total_ch_write_elapsed_ns;
+    const auto epoch = s_epoch.load(std::memory_order_acquire);
+    CounterSnapshot totals;
+    for (const auto& shard : all_shards())
+    {
+        const auto* counters = shard->find(m_id);
+        CounterSnapshot snapshot;
+        if (counters != nullptr && read_counters(*counters, epoch, snapshot))
+        {
+            totals += snapshot;
+        }
+    }
+
+    std::size_t emission_count            = totals.emission_count;
+    std::size_t receive_count             = totals.receive_count;
+    std::size_t ch_read_count             = totals.channel_sink_reads;
+    std::size_t ch_write_count            = totals.channel_source_writes;
+    std::size_t total_internal_elapsed_ns = totals.total_internal_elapsed_ns;
+    std::size_t total_ch_read_elapsed_ns  = totals.total_ch_read_elapsed_ns;
+    std::size_t total_ch_write_elapsed_ns = totals.total_ch_write_elapsed_ns;
 
     double scaling_coef         = total_elapsed_ns * TimeUtil::NsToSec;
     double emissions_per_second = emission_count / scaling_coef;
@@ -210,172 +556,31 @@ json TraceStatistics::aggregate()
 
     json& counters          = aggregation["aggregations"]["metrics"]["counter"];
     json& component_metrics = aggregation["aggregations"]["components"]["metrics"];
-    json& metadata          = aggregation["metadata"];
-    json& data_types        = metadata["metric_data_types"];
-
-    json current_object = {};
-    std::string current_component;
-    std::size_t count = 0;
-    for (auto& it : TraceObjectMultimap)
-    {
-        if (current_component != it.first)
-        {
-            for (json::iterator current_it = current_object.begin(); current_it != current_object.end(); current_it++)
-            {
-                auto key   = current_it.key();
-                auto value = current_it.value();
-
-                // Prometheus style metric storage -- each metric is stored with entries for each component
-                counters[key].push_back({{"labels", {{"component_id", current_component}}}, {"value", value}});
-
-                // Component based metric storage
-                component_metrics[current_component][key] = value;
-            }
-
-            count                                = 0;
-            current_component                    = it.first;
-            current_object                       = it.second->to_json();
-            component_metrics[current_component] = json::object();
 
-            continue;
-        }
-
-        auto sibling = it.second->to_json();
-
-        /*
-         * Note: Sanity check for posterity: obj.get<type> will try to return the underlying memory as the
-         * specified type, it will not do any kind of conversion. So, if your field contains an int and you
-         * make a .get<double> call, you will get back gibberish. The correct way to do the cast would be:
-         * static_cast<double>(obj.get<int>)
-         */
-        for (json::iterator sibling_it = sibling.begin(); sibling_it != sibling.end(); sibling_it++)
-        {
-            auto key   = sibling_it.key();
-            auto value = sibling_it.value();
-
-            if (data_types[key] == "ui")
-            {
-                current_object[key] = current_object[key].get<std::size_t>() + value.get<std::size_t>();
-            }
-            else if (data_types[key] == "d")
-            {
-                current_object[key] = current_object[key].get<double>() + value.get<double>();
-            }
-            else
-            {
-                std::stringstream sstream;
-
-                sstream << "Unknown metric data type: " << key << " -- " << data_types[key];
-                throw std::runtime_error(sstream.str());
-            }
-        }
-
-        count++;
-    }
+    std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
 
+    // Per-thread shards are merged inside to_json, so each registered name maps to exactly one object here
+    for (const auto& [component, stats] : TraceObjectMultimap)
     {
+        auto current_object          = stats->to_json();
+        component_metrics[component] = json::object();
+
         for (json::iterator current_it = current_object.begin(); current_it != current_object.end(); current_it++)
         {
             auto key   = current_it.key();
             auto value = current_it.value();
 
             // Prometheus style metric storage -- each metric is stored with entries for each component
-            counters[key].push_back({{"labels", {{"component_id", current_component}}}, {"value", value}});
-            component_metrics[current_component][key] = value;
+            counters[key].push_back({{"labels", {{"component_id", component}}}, {"value", value}});
+
+            // Component based metric storage
+            component_metrics[component][key] = value;
         }
     }
 
     return aggregation;
 }
 
-void TraceStatistics::channel_read_start()
-{
-    m_channel_read_start = TimeUtil::get_delay_compensated_time_point();
-}
-
-void TraceStatistics::channel_read_end()
-{
-    auto now     = TimeUtil::get_current_time_point();
-    auto elapsed = now > m_channel_read_start ? TimeUtil::time_resolution_unit_t(now - m_channel_write_start)
-                                              : TimeUtil::s_minimum_resolution;
-    m_total_ch_read_elapsed_ns += elapsed.count();
-    m_channel_sink_reads += 1;
-}
-
-void TraceStatistics::channel_write_start()
-{
-    m_channel_write_start = TimeUtil::get_delay_compensated_time_point();
-}
-
-void TraceStatistics::channel_write_end()
-{
-    auto now     = TimeUtil::get_current_time_point();
-    auto elapsed = now > m_channel_write_start ? TimeUtil::time_resolution_unit_t(now - m_channel_write_start)
-                                               : TimeUtil::s_minimum_resolution;
-    m_total_ch_write_elapsed_ns += elapsed.count();
-    m_channel_source_writes += 1;
-    m_internal_chain_start = TimeUtil::get_delay_compensated_time_point();
-}
-
-void TraceStatistics::clear()
-{
-    m_emission_count            = 0;
-    m_receive_count             = 0;
-    m_channel_sink_reads        = 0;
-    m_channel_source_writes     = 0;
-    m_total_ch_read_elapsed_ns  = 0;
-    m_total_ch_write_elapsed_ns = 0;
-    m_total_internal_elapsed_ns = 0;
-    m_start_time                = TimeUtil::get_delay_compensated_time_point();
-}
-
-void TraceStatistics::initialize_lookup_tables()
-{
-    std::function<void(void)> emit_           = []() {};
-    std::function<void(void)> receive_        = []() {};
-    std::function<void(void)> ch_read_start_  = []() {};
-    std::function<void(void)> ch_read_end_    = []() {};
-    std::function<void(void)> ch_write_start_ = []() {};
-    std::function<void(void)> ch_write_end_   = []() {};
-
-    if (TraceStatistics::s_trace_operators)
-    {
-        init();
-        emit_ = [this]() {
-            emit();
-        };
-        receive_ = [this]() {
-            receive();
-        };
-    }
-
-    if (TraceStatistics::s_trace_channels)
-    {
-        init();
-        ch_read_start_ = [this]() {
-            channel_read_start();
-        };
-        ch_read_end_ = [this]() {
-            channel_read_end();
-        };
-
-        ch_write_start_ = [this]() {
-            channel_write_start();
-        };
-        ch_write_end_ = [this]() {
-            channel_write_end();
-        };
-    }
-
-    m_entry_lookup_table[static_cast<std::size_t>(WatchableEvent::sink_on_data)]  = receive_;
-    m_entry_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_read)]  = ch_read_start_;
-    m_entry_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_write)] = ch_write_start_;
-
-    m_exit_lookup_table[static_cast<std::size_t>(WatchableEvent::sink_on_data)]  = emit_;
-    m_exit_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_read)]  = ch_read_end_;
-    m_exit_lookup_table[static_cast<std::size_t>(WatchableEvent::channel_write)] = ch_write_end_;
-}
-
 void TraceStatistics::reset()
 {
     std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
@@ -387,9 +592,12 @@ void TraceStatistics::reset()
     s_trace_channels_set_manually = false;
 
     sync_state();
+
+    // Writers zero their own counters the next time they see the new epoch; until then readers skip them
+    s_epoch.fetch_add(1, std::memory_order_acq_rel);
     for (auto& mm_iter : TraceObjectMultimap)
     {
-        mm_iter.second->clear();
+        mm_iter.second->m_start_time = TimeUtil::get_delay_compensated_time_point();
     }
 }
 
@@ -398,39 +606,97 @@ void TraceStatistics::sync_state()
     std::lock_guard<std::recursive_mutex> lock(s_state_mutex);
 
     TraceStatistics::s_trace_operators = s_trace_operators_set_manually
-                                             ? s_trace_operators
+                                             ? s_trace_operators.load()
                                              : (std::getenv("MRC_TRACE_OPERATORS") != nullptr);
-    TraceStatistics::s_trace_channels  = s_trace_channels_set_manually ? s_trace_channels
-                                                                       : (std::getenv("MRC_TRACE_CHANNELS") != nullptr);
+    TraceStatistics::s_trace_channels  = s_trace_channels_set_manually
+                                             ? s_trace_channels.load()
+                                             : (std::getenv("MRC_TRACE_CHANNELS") != nullptr);
 
-    for (auto& mm_iter : TraceObjectMultimap)
+    if (s_trace_operators || s_trace_channels)
     {
-        mm_iter.second->initialize_lookup_tables();
+        init();
     }
 }
 
-void TraceStatistics::emit()
-{
-    auto now     = TimeUtil::get_current_time_point();
-    auto elapsed = now > m_internal_chain_start ? TimeUtil::time_resolution_unit_t(now - m_internal_chain_start)
-                                                : TimeUtil::s_minimum_resolution;
-    m_emission_count++;
-    m_total_internal_elapsed_ns += elapsed.count();
-
-    /* If we're an internal node, this will be re-set on the next receive call; otherwise, we'll use emit->emit timings
-     *  to produce a sane metric to report for source node operator latency.
-     */
-    m_internal_chain_start = TimeUtil::get_delay_compensated_time_point();
-}
-
 void TraceStatistics::on_entry(const WatchableEvent& e, const void* data)
 {
-    m_entry_lookup_table[static_cast<std::size_t>(e)]();
+    switch (e)
+    {
+    case WatchableEvent::sink_on_data:
+        if (s_trace_operators.load(std::memory_order_relaxed))
+        {
+            auto& counters                = local_counters(m_id);
+            counters.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
+
+            CounterUpdate update(counters, s_epoch.load(std::memory_order_relaxed));
+            CounterUpdate::add(counters.receive_count, 1);
+        }
+        break;
+    case WatchableEvent::channel_read:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            local_counters(m_id).channel_read_start = TimeUtil::get_delay_compensated_time_point();
+        }
+        break;
+    case WatchableEvent::channel_write:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            local_counters(m_id).channel_write_start = TimeUtil::get_delay_compensated_time_point();
+        }
+        break;
+    }
 }
 
 void TraceStatistics::on_exit(const WatchableEvent& e, bool rc, const void* data)
 {
-    m_exit_lookup_table[static_cast<std::size_t>(e)]();
+    switch (e)
+    {
+    case WatchableEvent::sink_on_data:
+        if (s_trace_operators.load(std::memory_order_relaxed))
+        {
+            auto& counters = local_counters(m_id);
+            auto elapsed   = elapsed_ns(counters.internal_chain_start, TimeUtil::get_current_time_point());
+            {
+                CounterUpdate update(counters, s_epoch.load(std::memory_order_relaxed));
+                CounterUpdate::add(counters.emission_count, 1);
+                CounterUpdate::add(counters.total_internal_elapsed_ns, elapsed);
+                counters.operator_latency.record(elapsed);
+            }
+
+            /* If we're an internal node, this will be re-set on the next receive call; otherwise, we'll use
+             *  emit->emit timings to produce a sane metric to report for source node operator latency.
+             */
+            counters.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
+        }
+        break;
+    case WatchableEvent::channel_read:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            auto& counters = local_counters(m_id);
+            auto elapsed   = elapsed_ns(counters.channel_read_start, TimeUtil::get_current_time_point());
+
+            CounterUpdate update(counters, s_epoch.load(std::memory_order_relaxed));
+            CounterUpdate::add(counters.channel_sink_reads, 1);
+            CounterUpdate::add(counters.total_ch_read_elapsed_ns, elapsed);
+            counters.channel_read_latency.record(elapsed);
+        }
+        break;
+    case WatchableEvent::channel_write:
+        if (s_trace_channels.load(std::memory_order_relaxed))
+        {
+            auto& counters = local_counters(m_id);
+            auto elapsed   = elapsed_ns(counters.channel_write_start, TimeUtil::get_current_time_point());
+            {
+                CounterUpdate update(counters, s_epoch.load(std::memory_order_relaxed));
+                CounterUpdate::add(counters.channel_source_writes, 1);
+                CounterUpdate::add(counters.total_ch_write_elapsed_ns, elapsed);
+                counters.channel_write_latency.record(elapsed);
+            }
+
+            counters.internal_chain_start = TimeUtil::get_delay_compensated_time_point();
+        }
+        break;
+    }
 }
 
 std::thread::id TraceStatistics::parent_id() const
@@ -438,10 +704,4 @@ std::thread::id TraceStatistics::parent_id() const
     return m_parent_id;
 }
 
-void TraceStatistics::receive()
-{
-    m_internal_chain_start = TimeUtil::get_delay_compensated_time_point();
-    m_receive_count++;
-}
-
 }  // namespace mrc::benchmarking
@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/channel/telemetry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace mrc::channel {
+
+static std::atomic<bool> s_track_high_water_mark{false};
+
+bool track_high_water_mark()
+{
+    return s_track_high_water_mark.load(std::memory_order_relaxed);
+}
+
+void set_track_high_water_mark(bool enabled)
+{
+    s_track_high_water_mark.store(enabled, std::memory_order_relaxed);
+}
+
+ChannelStats ChannelTelemetry::stats() const
+{
+    ChannelStats stats;
+
+    // Load the consumer side first so a concurrent write can only make occupancy appear larger, never negative
+    stats.reads   = m_reads.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.writes  = m_writes.load(std::memory_order_relaxed);
+
+    auto removed    = stats.reads + stats.dropped;
+    stats.occupancy = stats.writes > removed ? stats.writes - removed : 0;
+
+    update_high_water_mark(stats.occupancy);
+
+    stats.high_water_mark = std::max(m_high_water_mark.load(std::memory_order_relaxed), stats.occupancy);
+    stats.writer_blocked  = std::chrono::nanoseconds(m_writer_blocked_ns.load(std::memory_order_relaxed));
+    stats.reader_starved  = std::chrono::nanoseconds(m_reader_starved_ns.load(std::memory_order_relaxed));
+
+    return stats;
+}
+
+}  // namespace mrc::channel
@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/core/host_partition.hpp"
+
+#include <sched.h>
+
+namespace mrc::core {
+
+std::size_t current_host_partition_id(const std::vector<CpuSet>& host_partition_cpu_sets)
+{
+    const auto cpu_id = sched_getcpu();
+
+    if (cpu_id >= 0)
+    {
+        for (std::size_t i = 0; i < host_partition_cpu_sets.size(); ++i)
+        {
+            if (host_partition_cpu_sets[i].is_set(cpu_id))
+            {
+                return i;
+            }
+        }
+    }
+
+    return 0;
+}
+
+}  // namespace mrc::core
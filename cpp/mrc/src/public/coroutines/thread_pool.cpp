@@ -38,12 +38,25 @@
 
 #include "mrc/coroutines/thread_pool.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 namespace mrc::coroutines {
 
+namespace {
+
+/// Every this many tasks a work stealing executor takes from the front of its local queue and checks the injection
+/// queue first, so neither yielded coroutines nor work from outside the pool can be starved by a LIFO ping-pong.
+constexpr std::uint32_t FairnessInterval = 61;
+
+/// Upper bound on the number of coroutines moved from the injection queue per lock acquisition.
+constexpr std::size_t MaxInjectedBatch = 32;
+
+}  // namespace
+
 thread_local ThreadPool* ThreadPool::m_self{nullptr};
 thread_local std::size_t ThreadPool::m_thread_id{0};
 
@@ -97,6 +110,15 @@ ThreadPool::ThreadPool(Options opts) : m_opts(std::move(opts))
         m_opts.description = ss.str();
     }
 
+    if (m_opts.scheduling_mode == SchedulingMode::WorkStealing)
+    {
+        m_workers = std::make_unique<Worker[]>(m_opts.thread_count);  // NOLINT(modernize-avoid-c-arrays)
+        for (uint32_t i = 0; i < m_opts.thread_count; ++i)
+        {
+            m_workers[i].rng_state = 0x9e3779b9U ^ (i + 1);
+        }
+    }
+
     m_threads.reserve(m_opts.thread_count);
 
     for (uint32_t i = 0; i < m_opts.thread_count; ++i)
@@ -131,7 +153,7 @@ auto ThreadPool::resume(std::coroutine_handle<> handle) noexcept -> void
     }
 
     m_size.fetch_add(1, std::memory_order::release);
-    schedule_impl(handle);
+    schedule_impl(handle, true);
 }
 
 auto ThreadPool::shutdown() noexcept -> void
@@ -164,44 +186,329 @@ auto ThreadPool::executor(std::stop_token stop_token, std::size_t idx) -> void
         m_opts.on_thread_start_functor(idx);
     }
 
-    while (!stop_token.stop_requested())
+    if (m_opts.scheduling_mode == SchedulingMode::WorkStealing)
+    {
+        executor_work_stealing(std::move(stop_token), idx);
+    }
+    else
+    {
+        while (!stop_token.stop_requested())
+        {
+            // Wait until the queue has operations to execute or shutdown has been requested.
+            while (true)
+            {
+                std::unique_lock<std::mutex> lk{m_wait_mutex};
+                m_wait_cv.wait(lk, stop_token, [this] {
+                    return !m_queue.empty();
+                });
+                if (m_queue.empty())
+                {
+                    lk.unlock();  // would happen on scope destruction, but being explicit/faster(?)
+                    break;
+                }
+
+                auto handle = m_queue.front();
+                m_queue.pop_front();
+
+                lk.unlock();  // Not needed for processing the coroutine.
+
+                handle.resume();
+                m_size.fetch_sub(1, std::memory_order::release);
+            }
+        }
+    }
+
+    if (m_opts.on_thread_stop_functor != nullptr)
+    {
+        m_opts.on_thread_stop_functor(idx);
+    }
+}
+
+auto ThreadPool::executor_work_stealing(std::stop_token stop_token, std::size_t idx) -> void
+{
+    while (true)
     {
-        // Wait until the queue has operations to execute or shutdown has been requested.
-        while (true)
+        auto handle = next_task(idx);
+
+        if (handle != nullptr)
+        {
+            handle.resume();
+            m_size.fetch_sub(1, std::memory_order::release);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk{m_wait_mutex};
+
+        // Advertise that we are about to sleep before checking for work one last time; pairs with the fence in
+        // schedule_impl() so a push to a local queue either is seen here or sees m_sleeping > 0 and notifies us.
+        m_sleeping.fetch_add(1, std::memory_order::seq_cst);
+        std::atomic_thread_fence(std::memory_order::seq_cst);
+
+        if (!has_pending_work())
         {
-            std::unique_lock<std::mutex> lk{m_wait_mutex};
             m_wait_cv.wait(lk, stop_token, [this] {
-                return !m_queue.empty();
+                return !m_queue.empty() || m_wakeups > 0;
             });
-            if (m_queue.empty())
+
+            if (m_wakeups > 0)
             {
-                lk.unlock();  // would happen on scope destruction, but being explicit/faster(?)
-                break;
+                --m_wakeups;
             }
+        }
 
-            auto handle = m_queue.front();
+        m_sleeping.fetch_sub(1, std::memory_order::relaxed);
+
+        // Executors only drain their own local queue once stopping, other executors are still running and drain theirs.
+        if (stop_token.stop_requested() && !has_pending_work())
+        {
+            break;
+        }
+    }
+}
+
+auto ThreadPool::next_task(std::size_t idx) -> std::coroutine_handle<>
+{
+    auto& worker = m_workers[idx];
+
+    const bool fair_tick = (++worker.tick % FairnessInterval) == 0;
+
+    if (fair_tick && m_queue_size.load(std::memory_order::relaxed) > 0)
+    {
+        if (auto handle = pop_injected(idx))
+        {
+            return handle;
+        }
+    }
+
+    if (worker.size.load(std::memory_order::relaxed) > 0)
+    {
+        std::scoped_lock lk{worker.mutex};
+        if (!worker.queue.empty())
+        {
+            std::coroutine_handle<> handle;
+            if (fair_tick)
+            {
+                handle = worker.queue.front();
+                worker.queue.pop_front();
+            }
+            else
+            {
+                handle = worker.queue.back();
+                worker.queue.pop_back();
+            }
+            worker.size.store(worker.queue.size(), std::memory_order::relaxed);
+            return handle;
+        }
+    }
+
+    if (m_queue_size.load(std::memory_order::relaxed) > 0)
+    {
+        if (auto handle = pop_injected(idx))
+        {
+            return handle;
+        }
+    }
+
+    return steal(idx);
+}
+
+auto ThreadPool::pop_injected(std::size_t idx) -> std::coroutine_handle<>
+{
+    auto& worker = m_workers[idx];
+
+    std::coroutine_handle<> batch[MaxInjectedBatch];  // NOLINT(modernize-avoid-c-arrays)
+    std::size_t count = 0;
+
+    {
+        std::scoped_lock lk{m_wait_mutex};
+
+        // Take a fair share so a burst from outside the pool is spread over the executors
+        count = std::min(m_queue.size() / m_opts.thread_count + 1, MaxInjectedBatch);
+        count = std::min(count, m_queue.size());
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            batch[i] = m_queue.front();
             m_queue.pop_front();
+        }
 
-            lk.unlock();  // Not needed for processing the coroutine.
+        m_queue_size.store(m_queue.size(), std::memory_order::relaxed);
+    }
 
-            handle.resume();
-            m_size.fetch_sub(1, std::memory_order::release);
+    if (count == 0)
+    {
+        return nullptr;
+    }
+
+    if (count > 1)
+    {
+        {
+            std::scoped_lock lk{worker.mutex};
+            // The owner pops from the back, push in reverse so the batch still runs in FIFO order
+            for (std::size_t i = count - 1; i > 0; --i)
+            {
+                worker.queue.push_back(batch[i]);
+            }
+            worker.size.store(worker.queue.size(), std::memory_order::relaxed);
         }
+
+        notify_sleeper();
     }
 
-    if (m_opts.on_thread_stop_functor != nullptr)
+    return batch[0];
+}
+
+auto ThreadPool::steal(std::size_t idx) -> std::coroutine_handle<>
+{
+    const std::size_t thread_count = m_opts.thread_count;
+
+    if (thread_count < 2)
     {
-        m_opts.on_thread_stop_functor(idx);
+        return nullptr;
+    }
+
+    auto& worker = m_workers[idx];
+
+    // xorshift32, only needs to be good enough to avoid every thief picking the same victim
+    worker.rng_state ^= worker.rng_state << 13;
+    worker.rng_state ^= worker.rng_state >> 17;
+    worker.rng_state ^= worker.rng_state << 5;
+
+    const std::size_t start = worker.rng_state % thread_count;
+
+    for (std::size_t i = 0; i < thread_count; ++i)
+    {
+        const std::size_t victim_idx = (start + i) % thread_count;
+        if (victim_idx == idx)
+        {
+            continue;
+        }
+
+        auto& victim = m_workers[victim_idx];
+        if (victim.size.load(std::memory_order::relaxed) == 0)
+        {
+            continue;
+        }
+
+        std::coroutine_handle<> handle;
+        std::vector<std::coroutine_handle<>> stolen;
+
+        {
+            std::scoped_lock lk{victim.mutex};
+            if (victim.queue.empty())
+            {
+                continue;
+            }
+
+            // Steal the older half from the front, the owner keeps the hot end of its queue
+            const std::size_t count = (victim.queue.size() + 1) / 2;
+
+            handle = victim.queue.front();
+            victim.queue.pop_front();
+
+            for (std::size_t j = 1; j < count; ++j)
+            {
+                stolen.push_back(victim.queue.front());
+                victim.queue.pop_front();
+            }
+
+            victim.size.store(victim.queue.size(), std::memory_order::relaxed);
+        }
+
+        if (!stolen.empty())
+        {
+            std::scoped_lock lk{worker.mutex};
+            // The owner pops from the back, append in reverse so the stolen batch still runs oldest first
+            worker.queue.insert(worker.queue.end(), stolen.rbegin(), stolen.rend());
+            worker.size.store(worker.queue.size(), std::memory_order::relaxed);
+        }
+
+        return handle;
     }
+
+    return nullptr;
 }
 
-auto ThreadPool::schedule_impl(std::coroutine_handle<> handle) noexcept -> void
+auto ThreadPool::has_pending_work() const noexcept -> bool
+{
+    if (m_queue_size.load(std::memory_order::relaxed) > 0)
+    {
+        return true;
+    }
+
+    for (std::size_t i = 0; i < m_opts.thread_count; ++i)
+    {
+        if (m_workers[i].size.load(std::memory_order::relaxed) > 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto ThreadPool::notify_sleeper() noexcept -> void
+{
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+
+    if (m_sleeping.load(std::memory_order::relaxed) == 0)
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock lk{m_wait_mutex};
+        if (m_wakeups >= m_sleeping.load(std::memory_order::relaxed))
+        {
+            return;
+        }
+        ++m_wakeups;
+    }
+
+    m_wait_cv.notify_one();
+}
+
+auto ThreadPool::schedule_impl(std::coroutine_handle<> handle, bool lifo) noexcept -> void
 {
     if (handle == nullptr)
     {
         return;
     }
 
+    if (m_opts.scheduling_mode == SchedulingMode::WorkStealing)
+    {
+        if (m_self == this)
+        {
+            // Fast path, keep work scheduled from inside the pool on the current executor
+            auto& worker = m_workers[m_thread_id];
+            {
+                std::scoped_lock lk{worker.mutex};
+                if (lifo)
+                {
+                    worker.queue.push_back(handle);
+                }
+                else
+                {
+                    // Yielded/rescheduled coroutines go behind the local work and are the first to be stolen
+                    worker.queue.push_front(handle);
+                }
+                worker.size.store(worker.queue.size(), std::memory_order::relaxed);
+            }
+
+            notify_sleeper();
+            return;
+        }
+
+        {
+            std::scoped_lock lk{m_wait_mutex};
+            m_queue.emplace_back(handle);
+            m_queue_size.store(m_queue.size(), std::memory_order::relaxed);
+        }
+
+        m_wait_cv.notify_one();
+        return;
+    }
+
     {
         std::scoped_lock lk{m_wait_mutex};
         m_queue.emplace_back(handle);
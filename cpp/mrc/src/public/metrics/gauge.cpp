@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/metrics/gauge.hpp"
+
+#include <prometheus/gauge.h>
+
+namespace mrc::metrics {
+
+Gauge::Gauge(prometheus::Gauge* gauge) : m_gauge(gauge) {}
+
+void Gauge::set(double value)
+{
+    m_gauge->Set(value);
+}
+
+void Gauge::increment(double value)
+{
+    m_gauge->Increment(value);
+}
+
+void Gauge::decrement(double value)
+{
+    m_gauge->Decrement(value);
+}
+
+double Gauge::value() const
+{
+    return m_gauge->Value();
+}
+
+}  // namespace mrc::metrics
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/metrics/histogram.hpp"
+
+#include "mrc/benchmarking/latency_histogram.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mrc::metrics {
+
+namespace {
+
+std::size_t this_thread_stripe()
+{
+    static std::atomic<std::size_t> next_stripe{0};
+    thread_local std::size_t stripe = next_stripe.fetch_add(1, std::memory_order_relaxed) % HistogramStorage::Stripes;
+    return stripe;
+}
+
+}  // namespace
+
+void HistogramStorage::observe(std::uint64_t value)
+{
+    auto& stripe = m_stripes[this_thread_stripe()];
+    stripe.buckets[benchmarking::LatencyHistogram::bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    stripe.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+benchmarking::LatencyHistogram HistogramStorage::snapshot() const
+{
+    benchmarking::LatencyHistogram histogram;
+    for (const auto& stripe : m_stripes)
+    {
+        for (std::size_t i = 0; i < stripe.buckets.size(); ++i)
+        {
+            if (auto count = stripe.buckets[i].load(std::memory_order_relaxed); count > 0)
+            {
+                histogram.add_to_bucket(i, count);
+            }
+        }
+    }
+    return histogram;
+}
+
+std::uint64_t HistogramStorage::sum() const
+{
+    std::uint64_t sum = 0;
+    for (const auto& stripe : m_stripes)
+    {
+        sum += stripe.sum.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+Histogram::Histogram(HistogramStorage* histogram) : m_histogram(histogram) {}
+
+void Histogram::observe(std::uint64_t value)
+{
+    m_histogram->observe(value);
+}
+
+void Histogram::observe(std::chrono::nanoseconds duration)
+{
+    m_histogram->observe(duration.count() > 0 ? duration.count() : 0);
+}
+
+}  // namespace mrc::metrics
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/metrics/node_watcher.hpp"
+
+#include <boost/fiber/fss.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mrc::metrics {
+
+namespace {
+
+struct PendingOnData
+{
+    std::uint64_t watcher_id;
+    std::chrono::steady_clock::time_point start;
+};
+
+// Per-fiber start times of the on_data calls currently in progress. Each progress engine runs on its own fiber, so
+// engines of the same node sharing a thread never overwrite each other's start time, and the entry follows the fiber
+// if it is moved to another thread. Entries are keyed by watcher id rather than address so a watcher destroyed mid-call
+// can never be matched by a later one, and are removed as soon as the call finishes
+std::vector<PendingOnData>& pending_on_data()
+{
+    static boost::fibers::fiber_specific_ptr<std::vector<PendingOnData>> s_pending;
+
+    if (s_pending.get() == nullptr)
+    {
+        s_pending.reset(new std::vector<PendingOnData>);
+    }
+
+    return *s_pending;
+}
+
+std::vector<PendingOnData>::iterator find_pending(std::vector<PendingOnData>& pending, std::uint64_t watcher_id)
+{
+    return std::find_if(pending.begin(), pending.end(), [watcher_id](const PendingOnData& entry) {
+        return entry.watcher_id == watcher_id;
+    });
+}
+
+std::uint64_t next_watcher_id()
+{
+    static std::atomic<std::uint64_t> s_next_id{0};
+    return s_next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+NodeLatencyWatcher::NodeLatencyWatcher(Histogram on_data_latency) :
+  m_id(next_watcher_id()),
+  m_on_data_latency(std::move(on_data_latency))
+{}
+
+void NodeLatencyWatcher::on_entry(const WatchableEvent& e, const void* data)
+{
+    if (e == WatchableEvent::sink_on_data)
+    {
+        auto& pending = pending_on_data();
+        auto found    = find_pending(pending, m_id);
+        auto now      = std::chrono::steady_clock::now();
+
+        if (found != pending.end())
+        {
+            found->start = now;
+        }
+        else
+        {
+            pending.push_back(PendingOnData{m_id, now});
+        }
+    }
+    else if (e == WatchableEvent::channel_read)
+    {
+        finish_on_data();
+    }
+}
+
+void NodeLatencyWatcher::on_exit(const WatchableEvent& e, bool rc, const void* data)
+{
+    if (e == WatchableEvent::channel_read)
+    {
+        finish_on_data();
+    }
+}
+
+void NodeLatencyWatcher::finish_on_data()
+{
+    auto& pending = pending_on_data();
+    auto found    = find_pending(pending, m_id);
+    if (found == pending.end())
+    {
+        return;
+    }
+
+    m_on_data_latency.observe(std::chrono::steady_clock::now() - found->start);
+
+    // Order does not matter, swap with the last entry to avoid shifting the rest
+    *found = pending.back();
+    pending.pop_back();
+}
+
+}  // namespace mrc::metrics
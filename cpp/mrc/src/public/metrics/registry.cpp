@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -19,29 +19,89 @@
 
 #include "prometheus/metric_family.h"
 
+#include "mrc/benchmarking/latency_histogram.hpp"
+#include "mrc/channel/telemetry.hpp"
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/histogram.hpp"
 
 #include <glog/logging.h>
 #include <prometheus/client_metric.h>
 #include <prometheus/counter.h>
 #include <prometheus/family.h>
+#include <prometheus/gauge.h>
 #include <prometheus/registry.h>
+#include <prometheus/text_serializer.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace mrc::metrics {
 
+namespace {
+
+// All live registries, used by Registry::all_to_text
+struct LiveRegistries
+{
+    std::mutex mutex;
+    std::set<const Registry*> registries;
+};
+
+LiveRegistries& live_registries()
+{
+    static LiveRegistries live;
+    return live;
+}
+
+prometheus::ClientMetric make_labelled_metric(const std::map<std::string, std::string>& labels)
+{
+    prometheus::ClientMetric metric;
+    for (const auto& [label, value] : labels)
+    {
+        metric.label.push_back({label, value});
+    }
+    return metric;
+}
+
+prometheus::MetricFamily make_family(std::string name, std::string help, prometheus::MetricType type)
+{
+    prometheus::MetricFamily family;
+    family.name = std::move(name);
+    family.help = std::move(help);
+    family.type = type;
+    return family;
+}
+
+}  // namespace
+
 Registry::Registry() :
   m_registry(std::make_shared<prometheus::Registry>()),
   m_throughput_counters(prometheus::BuildCounter()
                             .Name("mrc_throughput_counters")
                             .Help("number of data elements passing thru a given pipeline object")
                             .Register(*m_registry))
-{}
+{
+    auto& live = live_registries();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.registries.insert(this);
+}
+
+Registry::~Registry()
+{
+    auto& live = live_registries();
+    std::lock_guard<std::mutex> lock(live.mutex);
+    live.registries.erase(this);
+}
 
 Counter Registry::make_counter(std::string name, std::map<std::string, std::string> labels)
 {
@@ -56,6 +116,51 @@ Counter Registry::make_throughput_counter(std::string name)
     return Counter(&counter);
 }
 
+Gauge Registry::make_gauge(std::string name, std::map<std::string, std::string> labels)
+{
+    auto& family = prometheus::BuildGauge().Name(std::move(name)).Register(*m_registry);
+    auto& gauge  = family.Add(std::move(labels));
+    return Gauge(&gauge);
+}
+
+Histogram Registry::make_histogram(std::string name, std::map<std::string, std::string> labels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto& series = m_histograms[std::move(name)];
+    auto found   = std::find_if(series.begin(), series.end(), [&labels](const HistogramSeries& entry) {
+        return entry.labels == labels;
+    });
+
+    if (found != series.end())
+    {
+        return Histogram(found->storage.get());
+    }
+
+    series.push_back(HistogramSeries{std::move(labels), std::make_unique<HistogramStorage>()});
+    return Histogram(series.back().storage.get());
+}
+
+void Registry::register_channel_telemetry(std::map<std::string, std::string> labels,
+                                          std::shared_ptr<const channel::ChannelTelemetry> telemetry)
+{
+    CHECK(telemetry) << "Cannot register empty channel telemetry";
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto found = std::find_if(m_channels.begin(), m_channels.end(), [&labels](const auto& entry) {
+        return entry.first == labels;
+    });
+
+    if (found != m_channels.end())
+    {
+        found->second = std::move(telemetry);
+        return;
+    }
+
+    m_channels.emplace_back(std::move(labels), std::move(telemetry));
+}
+
 std::vector<CounterReport> Registry::collect_throughput_counters() const
 {
     std::vector<CounterReport> report;
@@ -68,4 +173,163 @@ std::vector<CounterReport> Registry::collect_throughput_counters() const
     return report;
 }
 
+std::string Registry::to_text() const
+{
+    return prometheus::TextSerializer().Serialize(collect_families());
+}
+
+std::vector<prometheus::MetricFamily> Registry::collect_families() const
+{
+    using histogram_t = benchmarking::LatencyHistogram;
+
+    auto families = m_registry->Collect();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [name, series] : m_histograms)
+    {
+        auto family = make_family(name, {}, prometheus::MetricType::Histogram);
+
+        for (const auto& entry : series)
+        {
+            auto snapshot = entry.storage->snapshot();
+            auto metric   = make_labelled_metric(entry.labels);
+
+            metric.histogram.sample_count = snapshot.count();
+            metric.histogram.sample_sum   = static_cast<double>(entry.storage->sum());
+
+            // Collapse the sub-buckets so each power of two is reported as a single cumulative bucket
+            std::uint64_t cumulative = 0;
+            const auto& buckets      = snapshot.buckets();
+            for (std::size_t i = 0; i < buckets.size(); ++i)
+            {
+                cumulative += buckets[i];
+                if ((i + 1) % histogram_t::SubBucketCount == 0)
+                {
+                    prometheus::ClientMetric::Bucket bucket;
+                    bucket.cumulative_count = cumulative;
+                    bucket.upper_bound      = (i + 1 == buckets.size())
+                                                  ? std::numeric_limits<double>::infinity()
+                                                  : static_cast<double>(histogram_t::bucket_upper_bound(i));
+                    metric.histogram.bucket.push_back(bucket);
+                }
+            }
+
+            family.metric.push_back(std::move(metric));
+        }
+
+        families.push_back(std::move(family));
+    }
+
+    if (!m_channels.empty())
+    {
+        using seconds_t = std::chrono::duration<double>;
+
+        auto occupancy = make_family("mrc_channel_occupancy",
+                                     "number of items written to a channel but not yet read or dropped",
+                                     prometheus::MetricType::Gauge);
+
+        auto high_water_mark = make_family("mrc_channel_high_water_mark",
+                                           "largest occupancy observed by a channel, sampled when the metrics are "
+                                           "collected unless exact tracking is enabled",
+                                           prometheus::MetricType::Gauge);
+
+        auto writes = make_family("mrc_channel_writes_total",
+                                  "items written to a channel",
+                                  prometheus::MetricType::Counter);
+
+        auto reads = make_family("mrc_channel_reads_total",
+                                 "items read from a channel",
+                                 prometheus::MetricType::Counter);
+
+        auto dropped = make_family("mrc_channel_dropped_total",
+                                   "items discarded by a channel without being read",
+                                   prometheus::MetricType::Counter);
+
+        auto writer_blocked = make_family("mrc_channel_writer_blocked_seconds_total",
+                                          "time writers spent waiting for space in a channel",
+                                          prometheus::MetricType::Counter);
+
+        auto reader_starved = make_family("mrc_channel_reader_starved_seconds_total",
+                                          "time readers spent waiting for data in a channel",
+                                          prometheus::MetricType::Counter);
+
+        for (const auto& [labels, telemetry] : m_channels)
+        {
+            auto stats  = telemetry->stats();
+            auto metric = make_labelled_metric(labels);
+
+            metric.gauge.value = static_cast<double>(stats.occupancy);
+            occupancy.metric.push_back(metric);
+
+            metric.gauge.value = static_cast<double>(stats.high_water_mark);
+            high_water_mark.metric.push_back(metric);
+
+            metric.counter.value = static_cast<double>(stats.writes);
+            writes.metric.push_back(metric);
+
+            metric.counter.value = static_cast<double>(stats.reads);
+            reads.metric.push_back(metric);
+
+            metric.counter.value = static_cast<double>(stats.dropped);
+            dropped.metric.push_back(metric);
+
+            metric.counter.value = std::chrono::duration_cast<seconds_t>(stats.writer_blocked).count();
+            writer_blocked.metric.push_back(metric);
+
+            metric.counter.value = std::chrono::duration_cast<seconds_t>(stats.reader_starved).count();
+            reader_starved.metric.push_back(metric);
+        }
+
+        for (auto* family : {&occupancy, &high_water_mark, &writes, &reads, &dropped, &writer_blocked, &reader_starved})
+        {
+            families.push_back(std::move(*family));
+        }
+    }
+
+    return families;
+}
+
+std::string Registry::all_to_text()
+{
+    auto& live = live_registries();
+    std::lock_guard<std::mutex> lock(live.mutex);
+
+    // Every pipeline has its own registry, but they share metric names. The exposition format requires all samples of a
+    // family to be grouped under a single HELP/TYPE header, so families are merged by name before serializing
+    std::vector<prometheus::MetricFamily> merged;
+    std::map<std::string, std::size_t> index_by_name;
+
+    for (const auto* registry : live.registries)
+    {
+        for (auto& family : registry->collect_families())
+        {
+            auto [found, inserted] = index_by_name.try_emplace(family.name, merged.size());
+            if (inserted)
+            {
+                merged.push_back(std::move(family));
+                continue;
+            }
+
+            auto& target = merged[found->second];
+            if (target.help.empty())
+            {
+                target.help = std::move(family.help);
+            }
+            std::move(family.metric.begin(), family.metric.end(), std::back_inserter(target.metric));
+        }
+    }
+
+    return prometheus::TextSerializer().Serialize(merged);
+}
+
+void Registry::enable_node_metrics(bool flag)
+{
+    m_node_metrics_enabled = flag;
+}
+
+bool Registry::node_metrics_enabled() const
+{
+    return m_node_metrics_enabled;
+}
+
 }  // namespace mrc::metrics
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -34,6 +34,11 @@ FiberPoolOptions& FiberPoolOptions::enable_tracing_scheduler(bool default_false)
     m_enable_tracing_scheduler = false;
     return *this;
 }
+FiberPoolOptions& FiberPoolOptions::enable_scheduler_stats(bool default_false)
+{
+    m_enable_scheduler_stats = default_false;
+    return *this;
+}
 bool FiberPoolOptions::enable_memory_binding() const
 {
     return m_enable_memory_binding;
@@ -46,5 +51,9 @@ bool FiberPoolOptions::enable_tracing_scheduler() const
 {
     return m_enable_tracing_scheduler;
 }
+bool FiberPoolOptions::enable_scheduler_stats() const
+{
+    return m_enable_scheduler_stats;
+}
 
 }  // namespace mrc
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -48,6 +48,7 @@ Options::Options(const Options& other) :
   m_topology(std::make_unique<TopologyOptions>(*other.m_topology)),
   m_architect_url(other.m_architect_url),
   m_enable_server(other.m_enable_server),
+  m_enable_node_metrics(other.m_enable_node_metrics),
   m_server_port(other.m_server_port),
   m_config_request(other.m_config_request)
 {}
@@ -66,10 +67,11 @@ Options& Options::operator=(const Options& other)
         *m_topology      = *other.m_topology;
 
         // Values
-        m_architect_url  = other.m_architect_url;
-        m_enable_server  = other.m_enable_server;
-        m_server_port    = other.m_server_port;
-        m_config_request = other.m_config_request;
+        m_architect_url       = other.m_architect_url;
+        m_enable_server       = other.m_enable_server;
+        m_enable_node_metrics = other.m_enable_node_metrics;
+        m_server_port         = other.m_server_port;
+        m_config_request      = other.m_config_request;
     }
 
     return *this;
@@ -139,6 +141,16 @@ bool Options::enable_server() const
     return m_enable_server;
 }
 
+void Options::enable_node_metrics(bool default_false)
+{
+    m_enable_node_metrics = default_false;
+}
+
+bool Options::enable_node_metrics() const
+{
+    return m_enable_node_metrics;
+}
+
 const std::string& Options::config_request() const
 {
     return m_config_request;
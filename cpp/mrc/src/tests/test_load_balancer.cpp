@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tests/common.hpp"
+
+#include "internal/runnable/runnable_resources.hpp"
+#include "internal/system/threading_resources.hpp"
+
+#include "mrc/channel/status.hpp"
+#include "mrc/core/addresses.hpp"
+#include "mrc/manifold/interface.hpp"
+#include "mrc/manifold/load_balancer.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/node/source_properties.hpp"
+#include "mrc/options/options.hpp"
+#include "mrc/options/topology.hpp"
+#include "mrc/runnable/launch_options.hpp"
+#include "mrc/types.hpp"
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace mrc;
+
+namespace {
+
+class TestSource : public node::WritableAcceptor<int>
+{
+  public:
+    void write(int value)
+    {
+        EXPECT_EQ(this->get_writable_edge()->await_write(std::move(value)), channel::Status::success);
+    }
+
+    void complete()
+    {
+        this->release_edge_connection();
+    }
+};
+
+// Number of downstream writes in progress across all sinks, and the most seen at once
+struct InFlight
+{
+    void enter()
+    {
+        auto now  = current.fetch_add(1) + 1;
+        auto seen = peak.load();
+        while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+    }
+
+    void exit()
+    {
+        current.fetch_sub(1);
+    }
+
+    std::atomic<std::size_t> current{0};
+    std::atomic<std::size_t> peak{0};
+};
+
+// Stands in for a downstream segment whose ingress applies backpressure for `delay` per item
+class SlowSink : public node::ForwardingWritableProvider<int>
+{
+  public:
+    SlowSink(std::chrono::microseconds delay, InFlight& in_flight) : m_delay(delay), m_in_flight(in_flight) {}
+
+    std::size_t count() const
+    {
+        return m_count;
+    }
+
+    bool completed() const
+    {
+        return m_completed;
+    }
+
+  private:
+    channel::Status on_next(int&& value) final
+    {
+        m_in_flight.enter();
+        boost::this_fiber::sleep_for(m_delay);
+        m_in_flight.exit();
+        ++m_count;
+        return channel::Status::success;
+    }
+
+    void on_complete() final
+    {
+        m_completed = true;
+    }
+
+    std::chrono::microseconds m_delay;
+    InFlight& m_in_flight;
+    std::atomic<std::size_t> m_count{0};
+    std::atomic<bool> m_completed{false};
+};
+
+}  // namespace
+
+class TestLoadBalancer : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_system_resources = tests::make_threading_resources([](Options& options) {
+            options.topology().user_cpuset("0-3");
+            options.topology().restrict_gpus(true);
+        });
+
+        m_resources = std::make_unique<runnable::RunnableResources>(*m_system_resources, 0);
+    }
+
+    void TearDown() override
+    {
+        m_resources.reset();
+        m_system_resources.reset();
+    }
+
+    // Writes `count` items from two upstream segments through a LoadBalancer driven by `engines` progress engines into
+    // four downstream segments, returning once the manifold has joined
+    void run_balancer(std::size_t engines, std::size_t count, std::chrono::microseconds delay)
+    {
+        auto load_balancer = std::make_unique<manifold::LoadBalancer<int>>("port", *m_resources);
+        load_balancer->launch_options().engines_per_pe = engines;
+
+        manifold::Interface& manifold = *load_balancer;
+
+        std::vector<std::unique_ptr<TestSource>> sources;
+        for (SegmentRank rank = 0; rank < 2; ++rank)
+        {
+            auto& source = sources.emplace_back(std::make_unique<TestSource>());
+            manifold.add_input(segment_address_encode(1, rank), source.get());
+        }
+
+        m_sinks.clear();
+        m_in_flight.peak = 0;
+        for (SegmentRank rank = 0; rank < 4; ++rank)
+        {
+            auto& sink = m_sinks.emplace_back(std::make_unique<SlowSink>(delay, m_in_flight));
+            manifold.add_output(segment_address_encode(2, rank), sink.get());
+        }
+
+        manifold.update_inputs();
+        manifold.update_outputs();
+        manifold.start();
+
+        // a second start, as issued after later manifold updates, must not relaunch the engines
+        manifold.start();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            sources[i % sources.size()]->write(int(i));
+        }
+
+        for (auto& source : sources)
+        {
+            source->complete();
+        }
+
+        manifold.join();
+    }
+
+    std::size_t delivered() const
+    {
+        std::size_t total = 0;
+        for (const auto& sink : m_sinks)
+        {
+            total += sink->count();
+        }
+        return total;
+    }
+
+    InFlight m_in_flight;
+    std::vector<std::unique_ptr<SlowSink>> m_sinks;
+
+    std::unique_ptr<system::ThreadingResources> m_system_resources;
+    std::unique_ptr<runnable::RunnableResources> m_resources;
+};
+
+class TestLoadBalancerEngines : public TestLoadBalancer, public ::testing::WithParamInterface<std::size_t>
+{};
+
+TEST_P(TestLoadBalancerEngines, DeliversAndCompletes)
+{
+    const std::size_t count = 256;
+
+    run_balancer(GetParam(), count, std::chrono::microseconds(10));
+
+    EXPECT_EQ(delivered(), count);
+
+    for (const auto& sink : m_sinks)
+    {
+        // every downstream segment receives a share of the work and is completed once the upstream segments are done
+        EXPECT_GT(sink->count(), 0U);
+        EXPECT_TRUE(sink->completed());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(LoadBalancer, TestLoadBalancerEngines, testing::Values<std::size_t>(1, 2, 4, 8));
+
+TEST_F(TestLoadBalancer, EnginesWriteConcurrently)
+{
+    const std::size_t count = 128;
+    const auto delay        = std::chrono::milliseconds(1);
+
+    for (std::size_t engines : {1U, 2U, 4U, 8U})
+    {
+        run_balancer(engines, count, delay);
+        EXPECT_EQ(delivered(), count);
+
+        VLOG(1) << engines << " engines: at most " << m_in_flight.peak.load() << " concurrent downstream writes";
+
+        // each engine blocks on its own downstream write, so throughput scales with the number of writes in flight.
+        // With a 1ms backpressure per item every engine is parked in a write long before the first one returns
+        EXPECT_EQ(m_in_flight.current.load(), 0);
+        EXPECT_LE(m_in_flight.peak.load(), engines);
+        if (engines == 1)
+        {
+            EXPECT_EQ(m_in_flight.peak.load(), 1);
+        }
+        else
+        {
+            EXPECT_GT(m_in_flight.peak.load(), 1);
+        }
+    }
+}
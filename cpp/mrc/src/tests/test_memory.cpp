@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -28,6 +28,7 @@
 #include "mrc/memory/memory_kind.hpp"
 #include "mrc/memory/resources/arena_resource.hpp"
 #include "mrc/memory/resources/device/cuda_malloc_resource.hpp"
+#include "mrc/memory/resources/host/huge_page_memory_resource.hpp"
 #include "mrc/memory/resources/host/malloc_memory_resource.hpp"
 #include "mrc/memory/resources/host/pinned_memory_resource.hpp"
 #include "mrc/memory/resources/logging_resource.hpp"
@@ -38,7 +39,9 @@
 #include <array>
 #include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -263,3 +266,173 @@ TEST_F(TestMemory, TransientPool)
     EXPECT_FALSE(other_tick);
     EXPECT_EQ(some_int, 42);
 }
+
+TEST_F(TestMemory, TransientPoolStats)
+{
+    auto malloc = std::make_shared<mrc::memory::malloc_memory_resource>();
+    memory::TransientPool pool(1_MiB, 4, malloc);
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.pinned_bytes, 0);
+    EXPECT_EQ(stats.allocations, 0);
+
+    auto long_lived = pool.await_buffer(1_KiB);
+    for (int i = 0; i < 100; i++)
+    {
+        auto buffer = pool.await_buffer(64_KiB);
+    }
+
+    // the 1 KiB buffer keeps its block pinned while the short-lived buffers cycle through the remaining blocks
+    stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 101);
+    EXPECT_EQ(stats.allocated_bytes, 1_KiB);
+    EXPECT_GE(stats.pinned_bytes, 1_MiB);
+    EXPECT_LE(stats.pinned_bytes, 2_MiB);
+    EXPECT_GT(stats.fragmentation, 0.99);
+    EXPECT_GT(stats.allocations_per_second, 0);
+
+    long_lived.release();
+    EXPECT_EQ(pool.stats().allocated_bytes, 0);
+    EXPECT_EQ(pool.stats().allocations_per_second, 0);
+}
+
+TEST_F(TestMemory, TransientPoolSizeClasses)
+{
+    auto malloc = std::make_shared<mrc::memory::malloc_memory_resource>();
+    memory::TransientPool pool(1_MiB, 4, malloc, 64, {.size_classes = true, .min_class_bytes = 256});
+
+    EXPECT_ANY_THROW(pool.await_buffer(2_MiB));
+
+    // a long-lived buffer only pins its own slot; released slots are reused by the next allocation of the same class
+    auto long_lived = pool.await_buffer(100);
+    void* reused    = nullptr;
+    for (int i = 0; i < 10000; i++)
+    {
+        auto buffer = pool.await_buffer(300);
+        EXPECT_EQ(buffer.bytes(), 300);
+        reused = (reused == nullptr ? buffer.data() : reused);
+        EXPECT_EQ(buffer.data(), reused);
+    }
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.pinned_bytes, 2_MiB);
+    EXPECT_EQ(stats.allocated_bytes, 100);
+    EXPECT_EQ(stats.allocations, 10001);
+
+    // a shallow copy keeps the slot alive after the original is released
+    auto parent = pool.await_buffer(1_KiB);
+    void* addr  = parent.data();
+    memory::TransientBuffer child(static_cast<std::byte*>(addr) + 1, 10, parent);
+    parent.release();
+    auto other = pool.await_buffer(1_KiB);
+    EXPECT_NE(other.data(), addr);
+    child.release();
+    auto again = pool.await_buffer(1_KiB);
+    EXPECT_EQ(again.data(), addr);
+
+    // a full block allocation fits in a single slot; drawing its block starts the second epoch since the now empty
+    // 512 B class block was retired, so that block is returned to the pool
+    auto block = pool.await_buffer(1_MiB);
+    EXPECT_EQ(pool.stats().pinned_bytes, 3_MiB);
+}
+
+TEST_F(TestMemory, TransientPoolSizeClassRecycling)
+{
+    auto malloc = std::make_shared<mrc::memory::malloc_memory_resource>();
+    memory::TransientBuffer outlives_pool;
+    memory::TransientPool pool(1_MiB, 4, malloc, 64, {.size_classes = true, .recycle_epochs = 1});
+
+    // an empty block is retained by its class until the next block is drawn from the pool
+    pool.await_buffer(1_KiB).release();
+    EXPECT_EQ(pool.stats().pinned_bytes, 1_MiB);
+    auto buffer = pool.await_buffer(4_KiB);
+    EXPECT_EQ(pool.stats().pinned_bytes, 1_MiB);
+
+    // once every block is checked out, blocks are returned to the pool as soon as they empty so a class waiting on the
+    // pool is never starved by empty blocks retained by other classes
+    std::vector<memory::TransientBuffer> buffers;
+    buffers.push_back(pool.await_buffer(16_KiB));
+    buffers.push_back(pool.await_buffer(64_KiB));
+    buffers.push_back(pool.await_buffer(256_KiB));
+    EXPECT_EQ(pool.stats().pinned_bytes, 4_MiB);
+
+    buffers.clear();
+    auto last = pool.await_buffer(1_MiB);
+    EXPECT_EQ(pool.stats().pinned_bytes, 2_MiB);
+
+    // buffers may outlive the pool
+    outlives_pool = pool.await_buffer(4_KiB);
+}
+
+TEST_F(TestMemory, TransientPoolSizeClassesConcurrentRelease)
+{
+    auto malloc = std::make_shared<mrc::memory::malloc_memory_resource>();
+    memory::TransientPool pool(64_KiB, 8, malloc, 64, {.size_classes = true, .min_class_bytes = 64});
+
+    std::mutex mutex;
+    std::vector<memory::TransientBuffer> pending;
+    bool done{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&] {
+            while (true)
+            {
+                memory::TransientBuffer buffer;
+                {
+                    std::lock_guard lock(mutex);
+                    if (pending.empty() && done)
+                    {
+                        break;
+                    }
+                    if (!pending.empty())
+                    {
+                        buffer = std::move(pending.back());
+                        pending.pop_back();
+                    }
+                }
+                if (buffer.data() == nullptr)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::memset(buffer.data(), 0xff, buffer.bytes());
+            }
+        });
+    }
+
+    for (int i = 0; i < 100000; i++)
+    {
+        auto buffer = pool.await_buffer(64 << (i % 8));
+        std::lock_guard lock(mutex);
+        pending.push_back(std::move(buffer));
+    }
+    {
+        std::lock_guard lock(mutex);
+        done = true;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.allocations, 100000);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+}
+
+TEST_F(TestMemory, HugePageMemoryResource)
+{
+    auto huge_pages = std::make_shared<huge_page_memory_resource>();
+    EXPECT_EQ(huge_pages->kind(), memory_kind::host);
+
+    auto md = buffer(3_MiB, huge_pages);
+    std::memset(md.data(), 0xff, md.bytes());
+    md.release();
+
+    memory::TransientPool pool(4_MiB, 2, huge_pages, 64, {.huge_pages = true});
+    auto transient = pool.await_buffer(1_MiB);
+    std::memset(transient.data(), 0xff, transient.bytes());
+}
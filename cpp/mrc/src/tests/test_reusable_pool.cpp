@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -16,14 +16,20 @@
  */
 
 #include "mrc/channel/status.hpp"
+#include "mrc/core/bitmap.hpp"
+#include "mrc/core/host_partition.hpp"
+#include "mrc/data/cached_reusable_pool.hpp"
 #include "mrc/data/reusable_pool.hpp"
 
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <memory>
+#include <thread>
 #include <utility>
+#include <vector>
 
 using namespace mrc;
 
@@ -118,3 +124,172 @@ TEST_F(TestReusablePool, Immutable)
 
     EXPECT_EQ(counter, 13);
 }
+
+TEST_F(TestReusablePool, CachedCapacity)
+{
+    auto pool = data::CachedReusablePool<int>::create(3);
+
+    pool->emplace(1);
+    pool->emplace(2);
+    pool->emplace(3);
+
+    EXPECT_EQ(pool->size(), 3);
+    EXPECT_ANY_THROW(pool->emplace(4));
+}
+
+TEST_F(TestReusablePool, CachedReset)
+{
+    std::atomic<std::size_t> counter = 0;
+
+    auto pool = data::CachedReusablePool<int>::create(4, [&](int& i) {
+        i = 42;
+        counter++;
+    });
+
+    pool->emplace(0);
+    pool->emplace(1);
+    pool->emplace(2);
+
+    // released items are reused most recent first, so hold all three to see the initial values
+    {
+        auto first  = pool->await_item();
+        auto second = pool->await_item();
+        auto third  = pool->await_item();
+        EXPECT_EQ(*first + *second + *third, 3);
+    }
+
+    // all our initial values should now be reset to 42
+    for (int i = 0; i < 10; i++)
+    {
+        auto reusable_int = pool->await_item();
+        EXPECT_EQ(*reusable_int, 42);
+    }
+
+    EXPECT_EQ(counter, 13);
+}
+
+TEST_F(TestReusablePool, CachedBlocksUntilReturned)
+{
+    auto pool = data::CachedReusablePool<int>::create(2, data::CachedReusablePoolOptions{.batch_size = 1});
+
+    pool->emplace(7);
+
+    auto held = pool->await_item();
+
+    // the item is parked in this thread's cache once released, which the waiting thread must find
+    std::atomic<bool> acquired = false;
+    std::thread waiter([&] {
+        auto item = pool->await_item();
+        EXPECT_EQ(*item, 7);
+        acquired = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(acquired);
+
+    held.release();
+    waiter.join();
+
+    EXPECT_TRUE(acquired);
+}
+
+TEST_F(TestReusablePool, CachedManyThreads)
+{
+    constexpr std::size_t ItemCount   = 8;
+    constexpr int ThreadCount         = 4;
+    constexpr int IterationsPerThread = 10000;
+
+    // fewer caches than threads, so some threads share a cache
+    auto pool = data::CachedReusablePool<std::size_t>::create(
+        ItemCount, data::CachedReusablePoolOptions{.batch_size = 2, .thread_cache_count = 2});
+
+    for (std::size_t i = 0; i < ItemCount; ++i)
+    {
+        pool->emplace(0);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < ThreadCount; ++t)
+    {
+        threads.emplace_back([&] {
+            for (int i = 0; i < IterationsPerThread; ++i)
+            {
+                auto first  = pool->await_item();
+                auto second = pool->await_item();
+                ++(*first);
+                ++(*second);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::size_t total = 0;
+    std::vector<data::CachedReusable<std::size_t>> items;
+    for (std::size_t i = 0; i < ItemCount; ++i)
+    {
+        total += *items.emplace_back(pool->await_item());
+    }
+
+    EXPECT_EQ(total, 2 * ThreadCount * IterationsPerThread);
+}
+
+TEST_F(TestReusablePool, CachedDomains)
+{
+    thread_local std::size_t domain = 0;
+
+    auto pool = data::CachedReusablePool<int>::create(
+        4,
+        data::CachedReusablePoolOptions{.batch_size = 1, .domain_count = 2, .domain_fn = [] {
+                                            return domain;
+                                        }});
+
+    EXPECT_ANY_THROW(data::CachedReusablePool<int>::create(4, data::CachedReusablePoolOptions{.domain_count = 2}));
+
+    pool->emplace(0);
+
+    // items added on domain 0 are still found from domain 1 once its stack is empty
+    std::thread remote([&] {
+        domain    = 1;
+        auto item = pool->await_item();
+        EXPECT_EQ(*item, 0);
+        *item = 1;
+    });
+    remote.join();
+
+    auto item = pool->await_item();
+    EXPECT_EQ(*item, 1);
+}
+
+TEST_F(TestReusablePool, CachedOutstandingItemsLeakPool)
+{
+    auto pool = data::CachedReusablePool<int>::create(2);
+
+    pool->emplace(1);
+    pool->emplace(2);
+
+    auto item = pool->await_item();
+
+    // releasing the last reference to the pool with an item outstanding logs an error and leaks the pool rather than
+    // aborting, so the item can still be returned
+    pool.reset();
+
+    EXPECT_EQ(*item, 1);
+    item.release();
+}
+
+TEST_F(TestReusablePool, CurrentHostPartition)
+{
+    CpuSet all_cpus;
+    for (std::uint32_t cpu_id = 0; cpu_id < 4096; ++cpu_id)
+    {
+        all_cpus.on(cpu_id);
+    }
+
+    std::vector<CpuSet> host_partition_cpu_sets{CpuSet(), all_cpus};
+
+    EXPECT_EQ(core::current_host_partition_id(host_partition_cpu_sets), 1);
+}
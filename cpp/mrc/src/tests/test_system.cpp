@@ -18,6 +18,7 @@
 #include "tests/common.hpp"
 
 #include "internal/system/fiber_pool.hpp"
+#include "internal/system/fiber_priority_scheduler.hpp"
 #include "internal/system/system.hpp"
 #include "internal/system/thread.hpp"
 #include "internal/system/thread_pool.hpp"
@@ -32,8 +33,11 @@
 #include "mrc/types.hpp"
 #include "mrc/utils/thread_local_shared_pointer.hpp"
 
+#include <boost/fiber/algo/algorithm.hpp>
+#include <boost/fiber/fiber.hpp>
 #include <boost/fiber/future/async.hpp>
 #include <boost/fiber/future/future.hpp>
+#include <boost/fiber/future/promise.hpp>
 #include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -43,6 +47,7 @@
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <thread>
@@ -137,6 +142,112 @@ TEST_F(TestSystem, FiberPool)
     EXPECT_EQ(s0.size(), 1);
 }
 
+TEST_F(TestSystem, FiberPrioritySchedulerOrder)
+{
+    system::FiberPrioritySchedulerStats stats;
+    std::vector<int> order;
+
+    std::thread thread([&] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>(&stats);
+
+        // priorities outside of the bucketed range are still ordered correctly
+        std::vector<boost::fibers::fiber> fibers;
+        for (int priority : {0, 5, -3, 100, -100, 5, 31, -32})
+        {
+            boost::fibers::fiber fiber([&order, priority] {
+                order.push_back(priority);
+            });
+            fiber.properties<system::FiberPriorityProps>().set_priority(priority);
+            fibers.push_back(std::move(fiber));
+        }
+
+        for (auto& fiber : fibers)
+        {
+            fiber.join();
+        }
+    });
+
+    thread.join();
+
+    EXPECT_EQ(order, (std::vector<int>{100, 31, 5, 5, 0, -3, -32, -100}));
+
+    auto levels = stats.levels();
+    ASSERT_FALSE(levels.empty());
+
+    // out of range priorities are accounted to the nearest level
+    EXPECT_EQ(levels.front().priority, system::FiberPriorityScheduler::MaxBucketedPriority);
+    EXPECT_EQ(levels.front().picks, 2);
+    EXPECT_EQ(levels.back().priority, system::FiberPriorityScheduler::MinBucketedPriority);
+    EXPECT_EQ(levels.back().picks, 2);
+
+    for (const auto& level : levels)
+    {
+        EXPECT_GE(level.max_ready_time.count(), 0);
+        EXPECT_LE(level.max_ready_time, level.total_ready_time);
+    }
+}
+
+TEST_F(TestSystem, FiberSharingGroup)
+{
+    auto group = std::make_shared<system::FiberSharingGroup>();
+    system::FiberPrioritySchedulerStats idle_stats;
+
+    boost::fibers::promise<void> done;
+    auto done_future = done.get_future();
+    std::atomic<bool> idle_joined{false};
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+
+    // this thread only has fibers to run if it picks them from the group
+    std::thread idle([&] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>(&idle_stats);
+        system::FiberPriorityScheduler::current()->join_sharing_group(group);
+        idle_joined = true;
+        done_future.wait();
+    });
+
+    std::thread busy([&] {
+        boost::fibers::use_scheduling_algorithm<system::FiberPriorityScheduler>();
+        system::FiberPriorityScheduler::current()->join_sharing_group(group);
+
+        while (!idle_joined)
+        {
+            std::this_thread::yield();
+        }
+
+        std::vector<boost::fibers::fiber> fibers;
+        for (int i = 0; i < 32; ++i)
+        {
+            boost::fibers::fiber fiber([&] {
+                {
+                    std::lock_guard lock(mutex);
+                    thread_ids.insert(std::this_thread::get_id());
+                }
+                // block the thread, not just the fiber, so the other member has to pick up the remaining fibers
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                boost::this_fiber::yield();
+            });
+            fiber.properties<system::FiberPriorityProps>().set_sharing_group(group);
+            fibers.push_back(std::move(fiber));
+        }
+
+        for (auto& fiber : fibers)
+        {
+            fiber.join();
+        }
+
+        done.set_value();
+    });
+
+    busy.join();
+    idle.join();
+
+    EXPECT_EQ(thread_ids.size(), 2);
+    EXPECT_GT(idle_stats.shared_picks(), 0);
+    EXPECT_TRUE(group->empty());
+}
+
 TEST_F(TestSystem, ImpossibleCoreCount)
 {
     auto resources = tests::make_threading_resources([](Options& options) {
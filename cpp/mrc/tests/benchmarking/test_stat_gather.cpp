@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -19,13 +19,20 @@
 
 #include "../test_segment.hpp"
 
+#include "mrc/benchmarking/latency_histogram.hpp"
 #include "mrc/benchmarking/trace_statistics.hpp"
 #include "mrc/benchmarking/util.hpp"
+#include "mrc/core/watcher.hpp"
 #include "mrc/options/options.hpp"
 #include "mrc/pipeline/executor.hpp"
 
 #include <nlohmann/json.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
 using namespace mrc::benchmarking;
 
 void stat_check_helper(nlohmann::json metrics,
@@ -142,4 +149,111 @@ TEST_F(StatGatherTest, TestStatisticsFullGather)
     TraceStatistics::reset();
 }
 
+TEST_F(StatGatherTest, TestStatisticsConcurrentWriters)
+{
+    TraceStatistics::reset();
+    TraceStatistics::trace_channels(true);
+    TraceStatistics::trace_operators(true);
+
+    auto stats = TraceStatistics::get_or_create("stat_gather_concurrent_writers");
+    EXPECT_EQ(TraceStatistics::get_or_create("stat_gather_concurrent_writers"), stats);
+
+    constexpr std::size_t Threads    = 4;
+    constexpr std::size_t Iterations = 10000;
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> writers;
+    for (std::size_t t = 0; t < Threads; ++t)
+    {
+        writers.emplace_back([&] {
+            for (std::size_t i = 0; i < Iterations; ++i)
+            {
+                stats->on_entry(WatchableEvent::channel_read, nullptr);
+                stats->on_exit(WatchableEvent::channel_read, true, nullptr);
+                stats->on_entry(WatchableEvent::sink_on_data, nullptr);
+                stats->on_exit(WatchableEvent::sink_on_data, true, nullptr);
+                stats->on_entry(WatchableEvent::channel_write, nullptr);
+                stats->on_exit(WatchableEvent::channel_write, true, nullptr);
+            }
+        });
+    }
+
+    // Aggregating while the writers are running must never see a torn or decreasing count
+    std::thread reader([&] {
+        std::size_t last = 0;
+        while (!done)
+        {
+            auto metrics = stats->to_json();
+            auto reads   = metrics["component_channel_read_total"].get<std::size_t>();
+            EXPECT_GE(reads, last);
+            EXPECT_LE(reads, Threads * Iterations);
+            last = reads;
+        }
+    });
+
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    auto framework_stats_info = TraceStatistics::aggregate();
+    auto& metrics             = framework_stats_info["aggregations"]["components"]["metrics"];
+    ASSERT_TRUE(metrics.contains("stat_gather_concurrent_writers"));
+    stat_check_helper(metrics["stat_gather_concurrent_writers"],
+                      Threads * Iterations,
+                      Threads * Iterations,
+                      Threads * Iterations,
+                      Threads * Iterations);
+
+    EXPECT_EQ(stats->channel_read_latency_histogram().count(), Threads * Iterations);
+    EXPECT_EQ(stats->channel_write_latency_histogram().count(), Threads * Iterations);
+    EXPECT_EQ(stats->operator_latency_histogram().count(), Threads * Iterations);
+
+    TraceStatistics::reset();
+
+    auto cleared = stats->to_json();
+    stat_check_helper(cleared, 0, 0, 0, 0);
+    EXPECT_EQ(stats->operator_latency_histogram().count(), 0U);
+}
+
+TEST_F(StatGatherTest, TestLatencyHistogram)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0U);
+
+    for (std::uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.count(), 1000U);
+
+    // Relative error is bounded by the sub-bucket resolution
+    auto max_error = 1.0 / LatencyHistogram::SubBucketCount;
+    for (double quantile : {0.5, 0.9, 0.99})
+    {
+        auto expected = quantile * 1000 * 1000;
+        auto actual   = static_cast<double>(histogram.percentile(quantile));
+        EXPECT_GE(actual, expected);
+        EXPECT_LE(actual, expected * (1 + max_error));
+    }
+
+    for (std::uint64_t value = 0; value < LatencyHistogram::SubBucketCount * 4; ++value)
+    {
+        auto index = LatencyHistogram::bucket_index(value);
+        EXPECT_LE(LatencyHistogram::bucket_lower_bound(index), value);
+        EXPECT_GE(LatencyHistogram::bucket_upper_bound(index), value);
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucket_index(std::uint64_t(1) << 40), LatencyHistogram::BucketCount - 1);
+
+    LatencyHistogram other;
+    other.record(5, 3);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 1003U);
+    EXPECT_EQ(histogram.percentile(0.0), 5U);
+}
+
 }  // namespace mrc
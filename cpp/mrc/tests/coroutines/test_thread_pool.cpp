@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mrc/coroutines/sync_wait.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/coroutines/when_all.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace mrc;
+using namespace std::chrono_literals;
+
+class TestCoroThreadPool : public ::testing::Test
+{
+  protected:
+    static coroutines::ThreadPool::Options work_stealing(uint32_t thread_count)
+    {
+        return {.thread_count    = thread_count,
+                .scheduling_mode = coroutines::ThreadPool::SchedulingMode::WorkStealing};
+    }
+};
+
+TEST_F(TestCoroThreadPool, WorkStealingRunsAllTasks)
+{
+    coroutines::ThreadPool tp{work_stealing(4)};
+
+    std::atomic<std::size_t> counter{0};
+
+    auto inner = [&]() -> coroutines::Task<> {
+        co_await tp.schedule();
+        counter++;
+        co_await tp.yield();
+        counter++;
+    };
+
+    // tasks scheduled from inside the pool take the local queue fast path
+    auto outer = [&]() -> coroutines::Task<> {
+        co_await tp.schedule();
+
+        std::vector<coroutines::Task<>> tasks;
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            tasks.push_back(inner());
+        }
+
+        co_await coroutines::when_all(std::move(tasks));
+    };
+
+    coroutines::sync_wait(outer());
+
+    EXPECT_EQ(counter, 2000);
+}
+
+TEST_F(TestCoroThreadPool, WorkStealingFromOutsideThePool)
+{
+    coroutines::ThreadPool tp{work_stealing(4)};
+
+    std::atomic<std::size_t> counter{0};
+
+    auto task = [&]() -> coroutines::Task<> {
+        co_await tp.schedule();
+        for (int i = 0; i < 10; ++i)
+        {
+            co_await tp.yield();
+        }
+        counter++;
+    };
+
+    std::vector<coroutines::Task<>> tasks;
+    for (std::size_t i = 0; i < 256; ++i)
+    {
+        tasks.push_back(task());
+    }
+
+    coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+
+    EXPECT_EQ(counter, 256);
+    EXPECT_EQ(tp.queue_size(), 0);
+}
+
+TEST_F(TestCoroThreadPool, WorkStealingSpreadsLocalWork)
+{
+    coroutines::ThreadPool tp{work_stealing(4)};
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+
+    auto inner = [&]() -> coroutines::Task<> {
+        co_await tp.schedule();
+        {
+            std::lock_guard lock(mutex);
+            thread_ids.insert(std::this_thread::get_id());
+        }
+        std::this_thread::sleep_for(1ms);
+    };
+
+    // all work starts on a single executor, the idle executors have to steal it
+    auto outer = [&]() -> coroutines::Task<> {
+        co_await tp.schedule();
+
+        std::vector<coroutines::Task<>> tasks;
+        for (std::size_t i = 0; i < 64; ++i)
+        {
+            tasks.push_back(inner());
+        }
+
+        co_await coroutines::when_all(std::move(tasks));
+    };
+
+    coroutines::sync_wait(outer());
+
+    EXPECT_GT(thread_ids.size(), 1);
+}
+
+TEST_F(TestCoroThreadPool, WorkStealingShutdownDrains)
+{
+    std::atomic<std::size_t> counter{0};
+
+    {
+        coroutines::ThreadPool tp{work_stealing(2)};
+
+        auto task = [&]() -> coroutines::Task<> {
+            co_await tp.schedule();
+            std::this_thread::sleep_for(1ms);
+            counter++;
+        };
+
+        std::vector<coroutines::Task<>> tasks;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            tasks.push_back(task());
+        }
+
+        coroutines::sync_wait(coroutines::when_all(std::move(tasks)));
+        tp.shutdown();
+
+        EXPECT_THROW((void)tp.schedule(), std::runtime_error);
+    }
+
+    EXPECT_EQ(counter, 16);
+}
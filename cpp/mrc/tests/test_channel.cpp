@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2018-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2018-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -19,9 +19,11 @@
 
 #include "mrc/channel/buffered_channel.hpp"
 #include "mrc/channel/egress.hpp"
+#include "mrc/channel/factory.hpp"
 #include "mrc/channel/ingress.hpp"
 #include "mrc/channel/null_channel.hpp"
 #include "mrc/channel/recent_channel.hpp"
+#include "mrc/channel/ring_channel.hpp"
 #include "mrc/core/userspace_threads.hpp"
 #include "mrc/core/watcher.hpp"
 
@@ -34,7 +36,10 @@
 #include <cstdint>     // for uint64_t
 #include <functional>  // for ref, reference_wrapper
 #include <memory>
+#include <numeric>
+#include <thread>
 #include <utility>
+#include <vector>
 // IWYU thinks algorithm is needed for: auto channel = std::make_shared<RecentChannel<int>>(2);
 // IWYU pragma: no_include <algorithm>
 
@@ -176,6 +181,41 @@ TEST_F(TestChannel, BufferedChannel)
     EXPECT_GE(t, 0.1);
 }
 
+TEST_F(TestChannel, WatchersToggle)
+{
+    auto channel  = std::make_shared<BufferedChannel<int>>(4);
+    auto observer = std::make_shared<TestChannelObserver>();
+
+    // adding the same watcher twice only attaches it once
+    channel->add_watcher(observer);
+    channel->add_watcher(observer);
+
+    int i;
+    channel->await_write(1);
+    channel->await_read(i);
+
+    channel->set_watchers_enabled(false);
+    EXPECT_FALSE(channel->watchers_enabled());
+
+    channel->await_write(2);
+    channel->await_read(i);
+
+    channel->set_watchers_enabled(true);
+    channel->remove_watcher(observer);
+
+    channel->await_write(3);
+    channel->await_read(i);
+    EXPECT_EQ(i, 3);
+
+#ifdef MRC_TRACING_DISABLED
+    EXPECT_EQ(observer->m_write_counter, 0);
+    EXPECT_EQ(observer->m_read_counter, 0);
+#else
+    EXPECT_EQ(observer->m_write_counter, 1);
+    EXPECT_EQ(observer->m_read_counter, 1);
+#endif
+}
+
 TEST_F(TestChannel, RecentChannel)
 {
     auto channel = std::make_shared<RecentChannel<int>>(2);
@@ -208,6 +248,374 @@ TEST_F(TestChannel, RecentChannel)
     */
 }
 
+TEST_F(TestChannel, RecentChannelReadUntil)
+{
+    auto channel = std::make_shared<RecentChannel<int>>(3);
+
+    int i      = -1;
+    auto start = channel::clock_t::now();
+    EXPECT_EQ(channel->await_read_until(i, channel::clock_t::now() + std::chrono::milliseconds(20)),
+              channel::Status::timeout);
+    EXPECT_GE(channel::clock_t::now() - start, std::chrono::milliseconds(20));
+
+    EXPECT_EQ(channel->await_write(7), channel::Status::success);
+    EXPECT_EQ(channel->await_read_until(i, channel::clock_t::now() + std::chrono::milliseconds(20)),
+              channel::Status::success);
+    EXPECT_EQ(i, 7);
+
+    // remaining items are drained after close
+    std::vector<int> input{1, 2, 3, 4};
+    EXPECT_EQ(channel->await_write_n(input), channel::Status::success);
+    channel->close_channel();
+    EXPECT_EQ(channel->await_write(5), channel::Status::closed);
+
+    std::vector<int> output;
+    EXPECT_EQ(channel->await_read_n(output, 8), channel::Status::success);
+    EXPECT_EQ(output, (std::vector<int>{2, 3, 4}));
+    EXPECT_EQ(channel->await_read(i), channel::Status::closed);
+    EXPECT_EQ(channel->stats().dropped, 1);
+}
+
+TEST_F(TestChannel, RecentChannelConcurrentOverwrite)
+{
+    constexpr int ItemCount = 100000;
+
+    auto channel = std::make_shared<RecentChannel<std::shared_ptr<int>>>(4);
+
+    std::atomic<int> read_count{0};
+    std::thread reader([&] {
+        std::shared_ptr<int> value;
+        int last = -1;
+        while (channel->await_read(value) == channel::Status::success)
+        {
+            // items are never reordered, only skipped
+            EXPECT_GT(*value, last);
+            last = *value;
+            read_count++;
+        }
+    });
+
+    for (int i = 0; i < ItemCount; i++)
+    {
+        EXPECT_EQ(channel->await_write(std::make_shared<int>(i)), channel::Status::success);
+    }
+
+    channel->close_channel();
+    reader.join();
+
+    EXPECT_EQ(read_count + channel->stats().dropped, ItemCount);
+}
+
+template <channel::RingChannelMode ModeT>
+static void test_ring_channel_lifecycle()
+{
+    auto channel = std::make_shared<RingChannel<int, ModeT>>(4);
+
+    EXPECT_EQ(channel->capacity(), 4);
+
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(channel->await_write(i), channel::Status::success);
+    }
+
+    int i = -1;
+    EXPECT_EQ(channel->await_read(i), channel::Status::success);
+    EXPECT_EQ(i, 0);
+
+    EXPECT_FALSE(channel->is_channel_closed());
+    channel->close_channel();
+    EXPECT_TRUE(channel->is_channel_closed());
+
+    // writes are rejected once closed
+    EXPECT_EQ(channel->await_write(911), channel::Status::closed);
+
+    // remaining items can still be drained
+    for (int j = 1; j < 4; j++)
+    {
+        EXPECT_EQ(channel->await_read(i), channel::Status::success);
+        EXPECT_EQ(i, j);
+    }
+
+    EXPECT_EQ(channel->await_read(i), channel::Status::closed);
+    EXPECT_EQ(channel->try_read(i), channel::Status::closed);
+}
+
+template <channel::RingChannelMode ModeT>
+static void test_ring_channel_threaded(int writer_count, int reader_count)
+{
+    constexpr int ItemsPerWriter = 10000;
+
+    auto channel = std::make_shared<RingChannel<int, ModeT>>(8);
+
+    std::atomic<std::int64_t> sum{0};
+    std::atomic<int> count{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < reader_count; r++)
+    {
+        readers.emplace_back([&] {
+            int val;
+            while (channel->await_read(val) == channel::Status::success)
+            {
+                sum += val;
+                count++;
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < writer_count; w++)
+    {
+        writers.emplace_back([&] {
+            for (int i = 0; i < ItemsPerWriter; i++)
+            {
+                EXPECT_EQ(channel->await_write(int(i)), channel::Status::success);
+            }
+        });
+    }
+
+    for (auto& t : writers)
+    {
+        t.join();
+    }
+
+    channel->close_channel();
+
+    for (auto& t : readers)
+    {
+        t.join();
+    }
+
+    const std::int64_t expected_sum = std::int64_t(ItemsPerWriter) * (ItemsPerWriter - 1) / 2 * writer_count;
+
+    EXPECT_EQ(count, ItemsPerWriter * writer_count);
+    EXPECT_EQ(sum, expected_sum);
+}
+
+TEST_F(TestChannel, RingChannelSPSC)
+{
+    test_ring_channel_lifecycle<channel::RingChannelMode::spsc>();
+    test_ring_channel_threaded<channel::RingChannelMode::spsc>(1, 1);
+}
+
+TEST_F(TestChannel, RingChannelMPMC)
+{
+    test_ring_channel_lifecycle<channel::RingChannelMode::mpmc>();
+    test_ring_channel_threaded<channel::RingChannelMode::mpmc>(4, 4);
+}
+
+TEST_F(TestChannel, RingChannelReadUntil)
+{
+    auto channel = std::make_shared<RingChannel<int>>(4);
+
+    int i;
+    auto s = std::chrono::system_clock::now();
+    EXPECT_EQ(channel->await_read_until(i, channel::clock_t::now() + std::chrono::milliseconds(100)),
+              channel::Status::timeout);
+    auto e = std::chrono::system_clock::now();
+    EXPECT_GE(std::chrono::duration<double>(e - s).count(), 0.1);
+
+    auto f = userspace_threads::async([channel] {
+        boost::this_fiber::sleep_for(std::chrono::milliseconds(10));
+        channel->await_write(42);
+    });
+
+    EXPECT_EQ(channel->await_read_until(i, channel::clock_t::now() + std::chrono::seconds(10)),
+              channel::Status::success);
+    EXPECT_EQ(i, 42);
+
+    f.get();
+}
+
+TEST_F(TestChannel, RingChannelDestroysUnreadItems)
+{
+    auto item = std::make_shared<int>(42);
+
+    {
+        RingChannel<std::shared_ptr<int>> channel(4);
+        channel.await_write(item);
+        channel.await_write(item);
+        EXPECT_EQ(item.use_count(), 3);
+    }
+
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST_F(TestChannel, BatchedReadWrite)
+{
+    for (auto type : {channel::ChannelType::buffered,
+                      channel::ChannelType::recent,
+                      channel::ChannelType::ring_spsc,
+                      channel::ChannelType::ring_mpmc})
+    {
+        auto channel = channel::make_channel<int>(type, 16);
+
+        std::vector<int> input(10);
+        std::iota(input.begin(), input.end(), 0);
+
+        EXPECT_EQ(channel->await_write_n(input), channel::Status::success);
+
+        // Reads never block after the first item and are capped at max_count
+        std::vector<int> output{-1};
+        EXPECT_EQ(channel->await_read_n(output, 4), channel::Status::success);
+        EXPECT_EQ(output, std::vector<int>({-1, 0, 1, 2, 3}));
+
+        output.clear();
+        EXPECT_EQ(channel->await_read_n(output, 100), channel::Status::success);
+        EXPECT_EQ(output, std::vector<int>({4, 5, 6, 7, 8, 9}));
+
+        channel->close_channel();
+
+        output.clear();
+        EXPECT_EQ(channel->await_read_n(output, 4), channel::Status::closed);
+        EXPECT_TRUE(output.empty());
+
+        EXPECT_EQ(channel->await_write_n(input), channel::Status::closed);
+    }
+}
+
+TEST_F(TestChannel, BatchedWriteBlocksWhenFull)
+{
+    auto channel = std::make_shared<RingChannel<int>>(4);
+
+    std::vector<int> input(64);
+    std::iota(input.begin(), input.end(), 0);
+
+    std::thread writer([&] {
+        EXPECT_EQ(channel->await_write_n(input), channel::Status::success);
+        channel->close_channel();
+    });
+
+    std::vector<int> output;
+    while (channel->await_read_n(output, 3) == channel::Status::success) {}
+
+    writer.join();
+
+    EXPECT_EQ(output.size(), 64);
+    for (int i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(output[i], i);
+    }
+}
+
+TEST_F(TestChannel, BufferedChannelTelemetry)
+{
+    // BufferedChannel rounds the capacity up to a power of two and can hold one less than that
+    auto channel = std::make_shared<BufferedChannel<int>>(4);
+
+    EXPECT_EQ(channel->await_write(1), channel::Status::success);
+    EXPECT_EQ(channel->await_write(2), channel::Status::success);
+    EXPECT_EQ(channel->await_write(3), channel::Status::success);
+
+    auto stats = channel->stats();
+    EXPECT_EQ(stats.occupancy, 3);
+    EXPECT_EQ(stats.high_water_mark, 3);
+    EXPECT_EQ(stats.writes, 3);
+    EXPECT_EQ(stats.reads, 0);
+    EXPECT_EQ(stats.writer_blocked.count(), 0);
+
+    // the fourth write blocks until the reader makes room
+    std::thread reader([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        int value;
+        EXPECT_EQ(channel->await_read(value), channel::Status::success);
+        EXPECT_EQ(value, 1);
+    });
+
+    EXPECT_EQ(channel->await_write(4), channel::Status::success);
+    reader.join();
+
+    stats = channel->stats();
+    EXPECT_EQ(stats.occupancy, 3);
+    EXPECT_EQ(stats.high_water_mark, 3);
+    EXPECT_EQ(stats.writes, 4);
+    EXPECT_EQ(stats.reads, 1);
+    EXPECT_GE(stats.writer_blocked, std::chrono::milliseconds(10));
+
+    std::vector<int> output;
+    EXPECT_EQ(channel->await_read_n(output, 8), channel::Status::success);
+    EXPECT_EQ(output.size(), 3);
+
+    stats = channel->stats();
+    EXPECT_EQ(stats.occupancy, 0);
+    EXPECT_EQ(stats.reads, 4);
+
+    // the telemetry outlives the channel
+    auto telemetry = channel->telemetry();
+    channel.reset();
+    EXPECT_EQ(telemetry->stats().writes, 4);
+}
+
+TEST_F(TestChannel, RecentChannelTelemetry)
+{
+    auto channel = std::make_shared<RecentChannel<int>>(2);
+
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(channel->await_write(std::move(i)), channel::Status::success);
+    }
+
+    auto stats = channel->stats();
+    EXPECT_EQ(stats.writes, 5);
+    EXPECT_EQ(stats.dropped, 3);
+    EXPECT_EQ(stats.occupancy, 2);
+    EXPECT_EQ(stats.high_water_mark, 2);
+    EXPECT_EQ(stats.writer_blocked.count(), 0);
+}
+
+TEST_F(TestChannel, HighWaterMarkTracking)
+{
+    auto sampled = std::make_shared<BufferedChannel<int>>(8);
+
+    channel::set_track_high_water_mark(true);
+    auto exact = std::make_shared<BufferedChannel<int>>(8);
+    channel::set_track_high_water_mark(false);
+
+    for (auto* channel : {static_cast<Channel<int>*>(sampled.get()), static_cast<Channel<int>*>(exact.get())})
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            EXPECT_EQ(channel->await_write(std::move(i)), channel::Status::success);
+        }
+
+        int value;
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(channel->await_read(value), channel::Status::success);
+        }
+    }
+
+    // by default the high-water mark is only sampled when the stats are read
+    EXPECT_EQ(sampled->stats().high_water_mark, 1);
+    EXPECT_EQ(exact->stats().high_water_mark, 5);
+
+    int value;
+    EXPECT_EQ(sampled->await_read(value), channel::Status::success);
+    EXPECT_EQ(sampled->stats().high_water_mark, 1);
+}
+
+TEST_F(TestChannel, SingleProducerSingleConsumerTelemetry)
+{
+    auto channel = std::make_shared<RingChannel<int, channel::RingChannelMode::spsc>>(8);
+
+    std::thread writer([&] {
+        for (int i = 0; i < 1000; i++)
+        {
+            EXPECT_EQ(channel->await_write(std::move(i)), channel::Status::success);
+        }
+        channel->close_channel();
+    });
+
+    int value;
+    while (channel->await_read(value) == channel::Status::success) {}
+    writer.join();
+
+    auto stats = channel->stats();
+    EXPECT_EQ(stats.writes, 1000);
+    EXPECT_EQ(stats.reads, 1000);
+    EXPECT_EQ(stats.occupancy, 0);
+}
+
 TEST_F(TestChannel, OnComplete) {}
 
 TEST_F(TestChannel, AwaitWriteOverloads)
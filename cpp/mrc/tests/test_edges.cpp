@@ -25,10 +25,13 @@
 #include "mrc/edge/edge_holder.hpp"  // for EdgeHolder
 #include "mrc/edge/edge_readable.hpp"
 #include "mrc/edge/edge_writable.hpp"
+#include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/node/generic_source.hpp"
 #include "mrc/node/operators/broadcast.hpp"
 #include "mrc/node/operators/combine_latest.hpp"
+#include "mrc/node/operators/key_affinity_router_typeless.hpp"
 #include "mrc/node/operators/node_component.hpp"
+#include "mrc/node/operators/queued_broadcast.hpp"
 #include "mrc/node/operators/round_robin_router_typeless.hpp"
 #include "mrc/node/operators/router.hpp"
 #include "mrc/node/rx_node.hpp"
@@ -36,25 +39,27 @@
 #include "mrc/node/sink_properties.hpp"
 #include "mrc/node/source_channel_owner.hpp"
 #include "mrc/node/source_properties.hpp"
+#include "mrc/types.hpp"
 
+#include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <gtest/internal/gtest-internal.h>
 #include <rxcpp/rx.hpp>  // for observable_member
 
+#include <cstddef>
 #include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 // IWYU pragma: no_forward_declare mrc::channel::Channel
 
-// IWYU thinks we need vector for make_segment
-// IWYU pragma: no_include <vector>
-
 using namespace std::chrono_literals;
 
 TEST_CLASS(Edges);
@@ -373,6 +378,58 @@ class TestConditional : public ForwardingWritableProvider<T>, public WritableAcc
     }
 };
 
+template <typename T>
+class TestWriter : public WritableAcceptor<T>
+{
+  public:
+    void write(T value)
+    {
+        EXPECT_EQ(this->get_writable_edge()->await_write(std::move(value)), channel::Status::success);
+    }
+
+    void complete()
+    {
+        this->release_edge_connection();
+    }
+};
+
+// Records every value written to it; writes wait on `gate`, when set, before being recorded
+template <typename T>
+class TestRecordingSink : public WritableProvider<T>
+{
+  public:
+    TestRecordingSink(SharedFuture<void> gate = {}) : m_gate(std::move(gate))
+    {
+        this->init_owned_edge(std::make_shared<EdgeWritableLambda<T>>(
+            [this](T&& t) {
+                if (m_gate.valid())
+                {
+                    m_gate.wait();
+                }
+                m_values.push_back(std::move(t));
+                return channel::Status::success;
+            },
+            [this]() {
+                m_completed = true;
+            }));
+    }
+
+    const std::vector<T>& values() const
+    {
+        return m_values;
+    }
+
+    bool completed() const
+    {
+        return m_completed;
+    }
+
+  private:
+    SharedFuture<void> m_gate;
+    std::vector<T> m_values;
+    bool m_completed{false};
+};
+
 }  // namespace mrc::node
 
 namespace mrc {
@@ -560,6 +617,84 @@ TEST_F(TestEdges, SourceToRxNodeComponentToSinkComponent)
     EXPECT_TRUE(node->stream_fn_called);
 }
 
+TEST_F(TestEdges, SourceToFusedRxNodeComponentsToSink)
+{
+    auto sink   = std::make_shared<node::TestRecordingSink<long>>();
+    auto node3  = std::make_shared<node::RxNodeComponent<long, long>>(rxcpp::operators::map([](long i) {
+        return i * 10;
+    }));
+    auto node2  = std::make_shared<node::RxNodeComponent<int, long>>(rxcpp::operators::map([](int i) {
+        return long(i + 1);
+    }));
+    auto node1  = std::make_shared<node::RxNodeComponent<int, int>>(rxcpp::operators::map([](int i) {
+        return i * 2;
+    }));
+    auto source = std::make_shared<node::TestWriter<int>>();
+
+    mrc::make_edge(*source, *node1);
+    mrc::make_edge(*node1, *node2);
+    mrc::make_edge(*node2, *node3);
+    mrc::make_edge(*node3, *sink);
+
+    EXPECT_EQ(node1->fusable_downstream(), node2.get());
+    EXPECT_EQ(node2->fusable_downstream(), node3.get());
+    EXPECT_EQ(node3->fusable_downstream(), nullptr);
+
+    // Fuse from the head of the chain, as the segment builder does
+    node1->fuse_into_downstream();
+    node2->fuse_into_downstream();
+
+    EXPECT_EQ(node1->fusable_downstream(), nullptr);
+
+    auto identity = [](const rxcpp::observable<int>& input) {
+        return input;
+    };
+    EXPECT_THROW(node1->make_stream(identity), exceptions::MrcRuntimeError);
+
+    for (int i = 0; i < 3; i++)
+    {
+        source->write(i);
+    }
+
+    EXPECT_FALSE(sink->completed());
+
+    source->complete();
+
+    EXPECT_EQ(sink->values(), (std::vector<long>{10, 30, 50}));
+    EXPECT_TRUE(sink->completed());
+}
+
+TEST_F(TestEdges, RxNodeComponentNotFusable)
+{
+    auto sink     = std::make_shared<node::TestRecordingSink<int>>();
+    auto no_fn    = std::make_shared<node::RxNodeComponent<int, int>>();
+    auto shared   = std::make_shared<node::RxNodeComponent<int, int>>(rxcpp::operators::map([](int i) {
+        return i;
+    }));
+    auto upstream = std::make_shared<node::RxNodeComponent<int, int>>(rxcpp::operators::map([](int i) {
+        return i;
+    }));
+    auto adapted  = std::make_shared<node::RxNodeComponent<int, long>>(rxcpp::operators::map([](int i) {
+        return long(i);
+    }));
+    auto source1  = std::make_shared<node::TestWriter<int>>();
+    auto source2  = std::make_shared<node::TestWriter<int>>();
+
+    // `shared` has two upstreams, one of which needs a long -> int adapter
+    mrc::make_edge(*source1, *upstream);
+    mrc::make_edge(*source2, *adapted);
+    mrc::make_edge(*upstream, *shared);
+    mrc::make_edge(*adapted, *shared);
+    mrc::make_edge(*shared, *no_fn);
+    mrc::make_edge(*no_fn, *sink);
+
+    EXPECT_EQ(upstream->fusable_downstream(), nullptr);
+    EXPECT_EQ(adapted->fusable_downstream(), nullptr);
+
+    // the downstream has no stream to fuse into
+    EXPECT_EQ(shared->fusable_downstream(), nullptr);
+}
+
 TEST_F(TestEdges, SourceComponentToNodeToSinkComponent)
 {
     auto source = std::make_shared<node::TestSourceComponent<int>>();
@@ -682,6 +817,164 @@ TEST_F(TestEdges, SourceToRoundRobinRouterTypelessToDifferentSinks)
     sink1->run();
 }
 
+TEST_F(TestEdges, SourceToKeyAffinityRouterTypelessToSinks)
+{
+    auto source = std::make_shared<node::TestWriter<int>>();
+    auto router = std::make_shared<node::KeyAffinityRouterTypeless>();
+    std::vector<std::shared_ptr<node::TestRecordingSink<int>>> sinks;
+
+    router->set_key_extractor<int>([](const int& value) {
+        return value % 10;
+    });
+
+    mrc::make_edge(*source, *router);
+
+    for (int i = 0; i < 3; i++)
+    {
+        mrc::make_edge(*router, *sinks.emplace_back(std::make_shared<node::TestRecordingSink<int>>()));
+    }
+
+    for (int i = 0; i < 300; i++)
+    {
+        source->write(i);
+    }
+
+    source->complete();
+
+    std::map<int, std::size_t> owners;
+    std::size_t total = 0;
+
+    for (std::size_t i = 0; i < sinks.size(); i++)
+    {
+        EXPECT_TRUE(sinks[i]->completed());
+        total += sinks[i]->values().size();
+
+        for (auto value : sinks[i]->values())
+        {
+            // every message with the same key reaches the same downstream
+            auto [owner, inserted] = owners.emplace(value % 10, i);
+            EXPECT_EQ(owner->second, i);
+        }
+    }
+
+    EXPECT_EQ(total, 300);
+    EXPECT_EQ(owners.size(), 10);
+}
+
+TEST_F(TestEdges, KeyAffinityRouterTypelessRebalance)
+{
+    auto source = std::make_shared<node::TestWriter<int>>();
+    auto router = std::make_shared<node::KeyAffinityRouterTypeless>();
+    std::vector<std::shared_ptr<node::TestRecordingSink<int>>> sinks;
+
+    router->set_key_extractor<int>([](const int& value) {
+        return value;
+    });
+
+    mrc::make_edge(*source, *router);
+
+    for (int i = 0; i < 4; i++)
+    {
+        mrc::make_edge(*router, *sinks.emplace_back(std::make_shared<node::TestRecordingSink<int>>()));
+    }
+
+    // writes keys [0, 1000) and returns the downstream each key was routed to
+    auto route_keys = [&]() {
+        std::vector<std::size_t> before(sinks.size());
+        for (std::size_t i = 0; i < sinks.size(); i++)
+        {
+            before[i] = sinks[i]->values().size();
+        }
+
+        for (int key = 0; key < 1000; key++)
+        {
+            source->write(key);
+        }
+
+        std::map<int, std::size_t> owners;
+        for (std::size_t i = 0; i < sinks.size(); i++)
+        {
+            for (std::size_t j = before[i]; j < sinks[i]->values().size(); j++)
+            {
+                owners[sinks[i]->values()[j]] = i;
+            }
+        }
+
+        EXPECT_EQ(owners.size(), 1000);
+        return owners;
+    };
+
+    auto initial = route_keys();
+
+    // removing a downstream only moves the keys it owned
+    router->remove_downstream(1);
+    EXPECT_EQ(router->downstream_count(), 3);
+
+    auto removed = route_keys();
+    std::size_t moved = 0;
+
+    for (const auto& [key, owner] : initial)
+    {
+        EXPECT_NE(removed[key], 1);
+        if (owner != 1)
+        {
+            EXPECT_EQ(removed[key], owner);
+        }
+        else
+        {
+            moved++;
+        }
+    }
+
+    // with 64 points per downstream each should own roughly a quarter of the keys
+    EXPECT_GT(moved, 100);
+    EXPECT_LT(moved, 400);
+
+    // a downstream connected while the router is in use only takes keys from the others
+    mrc::make_edge(*router, *sinks.emplace_back(std::make_shared<node::TestRecordingSink<int>>()));
+    EXPECT_EQ(router->downstream_count(), 4);
+
+    auto added = route_keys();
+    moved      = 0;
+
+    for (const auto& [key, owner] : removed)
+    {
+        if (added[key] != owner)
+        {
+            EXPECT_EQ(added[key], 4);
+            moved++;
+        }
+    }
+
+    EXPECT_GT(moved, 100);
+    EXPECT_LT(moved, 400);
+
+    EXPECT_THROW(router->remove_downstream(1), std::out_of_range);
+
+    source->complete();
+
+    for (const auto& sink : sinks)
+    {
+        EXPECT_TRUE(sink->completed());
+    }
+}
+
+TEST_F(TestEdgesDeathTest, KeyAffinityRouterTypelessMissingKeyExtractor)
+{
+    EXPECT_DEATH(
+        {
+            auto source = std::make_shared<node::TestWriter<float>>();
+            auto router = std::make_shared<node::KeyAffinityRouterTypeless>();
+
+            router->set_key_extractor<int>([](const int& value) {
+                return value;
+            });
+
+            mrc::make_edge(*source, *router);
+        },
+        "");
+}
+
 TEST_F(TestEdges, SourceToBroadcastToSink)
 {
     auto source    = std::make_shared<node::TestSource<int>>();
@@ -814,6 +1107,196 @@ TEST_F(TestEdges, SourceToBroadcastToSinkComponents)
     source->run();
 }
 
+TEST_F(TestEdges, SourceToQueuedBroadcastToMultiSink)
+{
+    using envelope_t = node::QueuedBroadcast<int>::envelope_t;
+
+    auto source    = std::make_shared<node::TestSource<int>>();
+    auto broadcast = std::make_shared<node::QueuedBroadcast<int>>();
+    auto sink1     = std::make_shared<node::TestRecordingSink<envelope_t>>();
+    auto sink2     = std::make_shared<node::TestRecordingSink<envelope_t>>();
+    auto sink3     = std::make_shared<node::TestSink<envelope_t>>();
+
+    mrc::make_edge(*source, *broadcast);
+    mrc::make_edge(*broadcast, *sink1);
+    mrc::make_edge(*broadcast, *sink2);
+    mrc::make_edge(*broadcast, *sink3);
+
+    source->run();
+    sink3->run();
+
+    ASSERT_EQ(sink1->values().size(), 3);
+    ASSERT_EQ(sink2->values().size(), 3);
+    EXPECT_TRUE(sink1->completed());
+    EXPECT_TRUE(sink2->completed());
+
+    for (int i = 0; i < 3; i++)
+    {
+        // every downstream sees the same envelope rather than a copy of the value
+        EXPECT_EQ(*sink1->values()[i], i);
+        EXPECT_EQ(sink1->values()[i].get(), sink2->values()[i].get());
+    }
+
+    for (const auto& stats : broadcast->downstream_stats())
+    {
+        EXPECT_EQ(stats.writes, 3);
+        EXPECT_EQ(stats.reads, 3);
+        EXPECT_EQ(stats.dropped, 0);
+    }
+}
+
+TEST_F(TestEdges, EdgeReadableAwaitReadUntil)
+{
+    int value;
+
+    // edges which cannot honor a deadline say so rather than blocking past it
+    auto lambda_edge = std::make_shared<node::EdgeReadableLambda<int>>([](int& t) {
+        t = 1;
+        return channel::Status::success;
+    });
+
+    EXPECT_THROW(lambda_edge->await_read_until(value, channel::clock_t::now()), exceptions::MrcRuntimeError);
+
+    // channel backed edges, and converting edges in front of them, return at the deadline
+    edge::EdgeChannel<int> edge_channel(std::make_unique<channel::BufferedChannel<int>>(4));
+    auto reader    = edge_channel.get_reader();
+    auto converted = std::make_shared<edge::ConvertingEdgeReadable<int, long>>(reader);
+
+    long converted_value;
+    EXPECT_EQ(reader->await_read_until(value, channel::clock_t::now() + 1ms), channel::Status::timeout);
+    EXPECT_EQ(converted->await_read_until(converted_value, channel::clock_t::now() + 1ms), channel::Status::timeout);
+
+    auto writer = edge_channel.get_writer();
+    EXPECT_EQ(writer->await_write(42), channel::Status::success);
+    EXPECT_EQ(converted->await_read_until(converted_value, channel::clock_t::now() + 1ms), channel::Status::success);
+    EXPECT_EQ(converted_value, 42);
+}
+
+TEST_F(TestEdges, QueuedBroadcastInvalidCapacity)
+{
+    EXPECT_THROW(node::QueuedBroadcast<int>(0), std::invalid_argument);
+}
+
+TEST_F(TestEdges, QueuedBroadcastBlockPolicy)
+{
+    using envelope_t = node::QueuedBroadcast<int>::envelope_t;
+
+    Promise<void> gate;
+
+    auto source    = std::make_shared<node::TestWriter<int>>();
+    auto broadcast = std::make_shared<node::QueuedBroadcast<int>>(1, node::LagPolicy::block);
+    auto fast      = std::make_shared<node::TestRecordingSink<envelope_t>>();
+    auto slow      = std::make_shared<node::TestRecordingSink<envelope_t>>(gate.get_future().share());
+
+    // the lane telemetry always tracks its high-water mark exactly, without set_track_high_water_mark
+    mrc::make_edge(*source, *broadcast);
+    mrc::make_edge(*broadcast, *fast);
+    mrc::make_edge(*broadcast, *slow);
+
+    auto opener = userspace_threads::async([&gate] {
+        userspace_threads::sleep_for(10ms);
+        gate.set_value();
+    });
+
+    // the slow downstream holds one value in flight and one queued, after which the writer has to wait for the gate
+    for (int i = 0; i < 5; i++)
+    {
+        source->write(i);
+    }
+
+    source->complete();
+    opener.get();
+
+    EXPECT_EQ(fast->values().size(), 5);
+    EXPECT_EQ(slow->values().size(), 5);
+
+    auto stats = broadcast->downstream_stats();
+    EXPECT_GT(stats[1].writer_blocked.count(), 0);
+    EXPECT_EQ(stats[1].high_water_mark, 1);
+}
+
+TEST_F(TestEdges, QueuedBroadcastDropPolicy)
+{
+    using envelope_t = node::QueuedBroadcast<int>::envelope_t;
+
+    Promise<void> gate;
+
+    auto source    = std::make_shared<node::TestWriter<int>>();
+    auto broadcast = std::make_shared<node::QueuedBroadcast<int>>(2, node::LagPolicy::drop);
+    auto fast      = std::make_shared<node::TestRecordingSink<envelope_t>>();
+    auto slow      = std::make_shared<node::TestRecordingSink<envelope_t>>(gate.get_future().share());
+
+    mrc::make_edge(*source, *broadcast);
+    mrc::make_edge(*broadcast, *fast);
+    mrc::make_edge(*broadcast, *slow);
+
+    for (int i = 0; i < 10; i++)
+    {
+        source->write(i);
+
+        // let the downstream fibers run
+        boost::this_fiber::yield();
+    }
+
+    // the slow downstream never held up the fast one
+    EXPECT_EQ(fast->values().size(), 10);
+    EXPECT_EQ(slow->values().size(), 0);
+
+    gate.set_value();
+    source->complete();
+
+    // the first value was in flight when the slow downstream stalled, of the rest only the newest two were kept
+    ASSERT_EQ(slow->values().size(), 3);
+    EXPECT_EQ(*slow->values()[0], 0);
+    EXPECT_EQ(*slow->values()[1], 8);
+    EXPECT_EQ(*slow->values()[2], 9);
+    EXPECT_TRUE(slow->completed());
+
+    auto stats = broadcast->downstream_stats();
+    EXPECT_EQ(stats[0].dropped, 0);
+    EXPECT_EQ(stats[1].dropped, 7);
+}
+
+TEST_F(TestEdges, QueuedBroadcastSpillPolicy)
+{
+    using envelope_t = node::QueuedBroadcast<int>::envelope_t;
+
+    Promise<void> gate;
+
+    auto source    = std::make_shared<node::TestWriter<int>>();
+    auto broadcast = std::make_shared<node::QueuedBroadcast<int>>(2, node::LagPolicy::spill);
+    auto fast      = std::make_shared<node::TestRecordingSink<envelope_t>>();
+    auto slow      = std::make_shared<node::TestRecordingSink<envelope_t>>(gate.get_future().share());
+
+    // the lane telemetry always tracks its high-water mark exactly, without set_track_high_water_mark
+    mrc::make_edge(*source, *broadcast);
+    mrc::make_edge(*broadcast, *fast);
+    mrc::make_edge(*broadcast, *slow);
+
+    for (int i = 0; i < 10; i++)
+    {
+        source->write(i);
+        boost::this_fiber::yield();
+    }
+
+    EXPECT_EQ(fast->values().size(), 10);
+    EXPECT_EQ(slow->values().size(), 0);
+
+    gate.set_value();
+    source->complete();
+
+    // nothing is lost, the slow downstream's queue grew past its capacity instead
+    ASSERT_EQ(slow->values().size(), 10);
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(*slow->values()[i], i);
+    }
+
+    auto stats = broadcast->downstream_stats();
+    EXPECT_EQ(stats[1].dropped, 0);
+    EXPECT_EQ(stats[1].high_water_mark, 9);
+}
+
 TEST_F(TestEdges, SourceComponentDoubleToSinkFloat)
 {
     auto source = std::make_shared<node::TestSourceComponent<double>>();
@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: Copyright (c) 2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test_mrc.hpp"  // IWYU pragma: associated
+
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/manifold/egress.hpp"
+#include "mrc/manifold/routing_policy.hpp"
+#include "mrc/node/sink_channel_owner.hpp"
+#include "mrc/node/sink_properties.hpp"
+#include "mrc/types.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <utility>
+
+TEST_CLASS(Manifold);
+
+namespace mrc::manifold {
+
+namespace {
+
+class TestIngress : public node::WritableProvider<int>,
+                    public node::ReadableAcceptor<int>,
+                    public node::SinkChannelOwner<int>
+{
+  public:
+    TestIngress()
+    {
+        this->set_channel(std::make_unique<channel::BufferedChannel<int>>(16));
+    }
+
+    std::size_t queue_depth() const
+    {
+        return this->sink_channel_telemetry()->stats().occupancy;
+    }
+
+    void read(std::size_t count)
+    {
+        int value;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(this->get_readable_edge()->await_read(value), channel::Status::success);
+        }
+    }
+};
+
+class TestEgress : public RoundRobinEgress<int>
+{
+  public:
+    using RoundRobinEgress<int>::on_complete;
+    using RoundRobinEgress<int>::on_next;
+};
+
+class TestEgressFixture
+{
+  public:
+    TestEgressFixture(std::size_t count)
+    {
+        for (SegmentAddress address = 1; address <= count; ++address)
+        {
+            auto& ingress = m_ingresses[address];
+            ingress       = std::make_unique<TestIngress>();
+            m_egress.add_output(address, ingress.get());
+        }
+    }
+
+    ~TestEgressFixture()
+    {
+        m_egress.on_complete();
+    }
+
+    TestEgress& egress()
+    {
+        return m_egress;
+    }
+
+    TestIngress& ingress(SegmentAddress address)
+    {
+        return *m_ingresses.at(address);
+    }
+
+    void write(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EXPECT_EQ(m_egress.on_next(int(i)), channel::Status::success);
+        }
+    }
+
+  private:
+    TestEgress m_egress;
+    std::map<SegmentAddress, std::unique_ptr<TestIngress>> m_ingresses;
+};
+
+}  // namespace
+
+TEST_F(TestManifold, RoundRobinEgress)
+{
+    TestEgressFixture fixture(3);
+
+    EXPECT_EQ(fixture.egress().routing_policy(), RoutingPolicy::round_robin);
+
+    fixture.write(30);
+
+    for (SegmentAddress address = 1; address <= 3; ++address)
+    {
+        EXPECT_EQ(fixture.ingress(address).queue_depth(), 10);
+    }
+}
+
+TEST_F(TestManifold, LoadAwareEgress)
+{
+    for (auto policy : {RoutingPolicy::least_loaded, RoutingPolicy::lowest_queue_depth})
+    {
+        TestEgressFixture fixture(3);
+        fixture.egress().set_routing_policy(policy);
+
+        // equally idle ingresses share the work
+        fixture.write(6);
+        for (SegmentAddress address = 1; address <= 3; ++address)
+        {
+            EXPECT_EQ(fixture.ingress(address).queue_depth(), 2);
+        }
+
+        // only ingress 2 makes progress, so all new work goes to it until it catches up
+        fixture.ingress(2).read(2);
+        fixture.write(2);
+
+        EXPECT_EQ(fixture.ingress(1).queue_depth(), 2);
+        EXPECT_EQ(fixture.ingress(2).queue_depth(), 2);
+        EXPECT_EQ(fixture.ingress(3).queue_depth(), 2);
+
+        fixture.ingress(3).read(2);
+        fixture.write(2);
+        fixture.write(3);
+
+        for (SegmentAddress address = 1; address <= 3; ++address)
+        {
+            EXPECT_EQ(fixture.ingress(address).queue_depth(), 3);
+        }
+    }
+}
+
+TEST_F(TestManifold, PowerOfTwoChoicesEgress)
+{
+    // with two ingresses both are always sampled, so the less loaded one always wins
+    TestEgressFixture fixture(2);
+    fixture.egress().set_routing_policy(RoutingPolicy::power_of_two_choices);
+
+    fixture.write(4);
+    EXPECT_EQ(fixture.ingress(1).queue_depth(), 2);
+    EXPECT_EQ(fixture.ingress(2).queue_depth(), 2);
+
+    fixture.ingress(1).read(2);
+    fixture.write(2);
+    EXPECT_EQ(fixture.ingress(1).queue_depth(), 2);
+    EXPECT_EQ(fixture.ingress(2).queue_depth(), 2);
+
+    // with more ingresses the sampled ingresses are random, but the busier of the two is only chosen when the other
+    // is at least as busy. An ingress which is busier than every other one therefore never receives work
+    TestEgressFixture wide(8);
+
+    wide.write(80);
+    for (SegmentAddress address = 2; address <= 8; ++address)
+    {
+        wide.ingress(address).read(10);
+    }
+
+    // the other ingresses can hold at most 9 between them, so none of them can catch up with ingress 1
+    wide.egress().set_routing_policy(RoutingPolicy::power_of_two_choices);
+    wide.write(9);
+
+    EXPECT_EQ(wide.ingress(1).queue_depth(), 10);
+
+    std::size_t total = 0;
+    for (SegmentAddress address = 2; address <= 8; ++address)
+    {
+        total += wide.ingress(address).queue_depth();
+    }
+    EXPECT_EQ(total, 9);
+}
+
+}  // namespace mrc::manifold
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,13 +17,24 @@
 
 #include "./test_mrc.hpp"  // IWYU pragma: associated
 
+#include "mrc/channel/buffered_channel.hpp"
+#include "mrc/channel/status.hpp"
+#include "mrc/core/watcher.hpp"
 #include "mrc/metrics/counter.hpp"
+#include "mrc/metrics/gauge.hpp"
+#include "mrc/metrics/histogram.hpp"
+#include "mrc/metrics/node_watcher.hpp"
 #include "mrc/metrics/registry.hpp"
 
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/operations.hpp>
 #include <gtest/gtest.h>  // for AssertionResult, SuiteApiResolver, TestInfo, EXPECT_TRUE, Message, TEST_F, Test, TestFactoryImpl, TestPartResult
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>  // for allocator, operator==, basic_string, string
+#include <thread>
 #include <vector>
 
 namespace mrc {
@@ -55,4 +66,160 @@ TEST_F(TestMetrics, ThroughputCounter)
     EXPECT_EQ(report[0].count, 43);
 }
 
+TEST_F(TestMetrics, Gauge)
+{
+    auto gauge = m_registry->make_gauge("mrc_test_gauge", {{"name", "test_gauge"}});
+
+    gauge.set(10);
+    gauge.increment();
+    gauge.decrement(3);
+
+    EXPECT_DOUBLE_EQ(gauge.value(), 8);
+
+    auto text = m_registry->to_text();
+    EXPECT_NE(text.find("mrc_test_gauge{name=\"test_gauge\"} 8"), std::string::npos) << text;
+}
+
+TEST_F(TestMetrics, Histogram)
+{
+    auto histogram = m_registry->make_histogram("mrc_test_latency", {{"name", "test_histogram"}});
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([histogram]() mutable {
+            for (std::uint64_t i = 0; i < 1000; ++i)
+            {
+                histogram.observe(i);
+            }
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // The same name and labels refer to the same histogram
+    m_registry->make_histogram("mrc_test_latency", {{"name", "test_histogram"}}).observe(std::chrono::microseconds(5));
+
+    auto text = m_registry->to_text();
+    EXPECT_NE(text.find("# TYPE mrc_test_latency histogram"), std::string::npos) << text;
+    EXPECT_NE(text.find("mrc_test_latency_count{name=\"test_histogram\"} 4001"), std::string::npos) << text;
+    EXPECT_NE(text.find("mrc_test_latency_bucket{name=\"test_histogram\",le=\"7\"} 32"), std::string::npos) << text;
+    EXPECT_NE(text.find("mrc_test_latency_bucket{name=\"test_histogram\",le=\"+Inf\"} 4001"), std::string::npos)
+        << text;
+
+    EXPECT_NE(Registry::all_to_text().find("mrc_test_latency_count"), std::string::npos);
+}
+
+TEST_F(TestMetrics, AllToTextMergesFamilies)
+{
+    auto other = std::make_shared<Registry>();
+
+    m_registry->make_histogram("mrc_test_merged", {{"name", "first"}}).observe(1);
+    other->make_histogram("mrc_test_merged", {{"name", "second"}}).observe(1);
+    m_registry->make_throughput_counter("first").increment();
+    other->make_throughput_counter("second").increment();
+
+    auto text = Registry::all_to_text();
+
+    auto type_line = std::string("# TYPE mrc_test_merged histogram");
+    auto first     = text.find(type_line);
+    ASSERT_NE(first, std::string::npos) << text;
+    EXPECT_EQ(text.find(type_line, first + 1), std::string::npos) << text;
+
+    // The throughput counter family is owned by every registry
+    type_line = "# TYPE mrc_throughput_counters counter";
+    first     = text.find(type_line);
+    ASSERT_NE(first, std::string::npos) << text;
+    EXPECT_EQ(text.find(type_line, first + 1), std::string::npos) << text;
+
+    EXPECT_NE(text.find("mrc_test_merged_count{name=\"first\"} 1"), std::string::npos) << text;
+    EXPECT_NE(text.find("mrc_test_merged_count{name=\"second\"} 1"), std::string::npos) << text;
+}
+
+TEST_F(TestMetrics, NodeLatencyWatcher)
+{
+    NodeLatencyWatcher watcher(m_registry->make_histogram("mrc_test_on_data", {{"name", "test_node"}}));
+
+    int data = 0;
+
+    // Same sequence of events as RxSinkBase::progress_engine for a batch of two elements
+    watcher.on_entry(WatchableEvent::channel_read, &data);
+    watcher.on_exit(WatchableEvent::channel_read, true, &data);
+    watcher.on_entry(WatchableEvent::sink_on_data, &data);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    watcher.on_exit(WatchableEvent::channel_read, true, &data);
+    watcher.on_entry(WatchableEvent::sink_on_data, &data);
+    watcher.on_entry(WatchableEvent::channel_read, &data);
+
+    // Channel reads without a pending element are not recorded
+    watcher.on_exit(WatchableEvent::channel_read, true, &data);
+    watcher.on_entry(WatchableEvent::channel_read, &data);
+
+    auto text = m_registry->to_text();
+    EXPECT_NE(text.find("mrc_test_on_data_count{name=\"test_node\"} 2"), std::string::npos) << text;
+    EXPECT_NE(text.find("mrc_test_on_data_bucket{name=\"test_node\",le=\"524287\"} 1"), std::string::npos)
+        << text;
+}
+
+TEST_F(TestMetrics, NodeLatencyWatcherEnginesShareThread)
+{
+    NodeLatencyWatcher watcher(m_registry->make_histogram("mrc_test_on_data", {{"name", "test_node"}}));
+
+    int data = 0;
+
+    // Two progress engines of the same node running as fibers on this thread, the second starts and finishes an
+    // element while the first is suspended in on_data
+    boost::fibers::fiber slow([&] {
+        watcher.on_entry(WatchableEvent::sink_on_data, &data);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        boost::this_fiber::yield();
+        watcher.on_entry(WatchableEvent::channel_read, &data);
+    });
+
+    boost::fibers::fiber fast([&] {
+        watcher.on_entry(WatchableEvent::sink_on_data, &data);
+        watcher.on_entry(WatchableEvent::channel_read, &data);
+    });
+
+    slow.join();
+    fast.join();
+
+    auto text = m_registry->to_text();
+    EXPECT_NE(text.find("mrc_test_on_data_count{name=\"test_node\"} 2"), std::string::npos) << text;
+    EXPECT_NE(text.find("mrc_test_on_data_bucket{name=\"test_node\",le=\"524287\"} 1"), std::string::npos)
+        << text;
+}
+
+TEST_F(TestMetrics, ChannelTelemetry)
+{
+    channel::set_track_high_water_mark(true);
+    auto channel = std::make_unique<BufferedChannel<int>>(8);
+    channel::set_track_high_water_mark(false);
+
+    m_registry->register_channel_telemetry({{"name", "test_node"}, {"direction", "input"}}, channel->telemetry());
+
+    EXPECT_EQ(channel->await_write(1), channel::Status::success);
+    EXPECT_EQ(channel->await_write(2), channel::Status::success);
+
+    int value;
+    EXPECT_EQ(channel->await_read(value), channel::Status::success);
+
+    auto text = m_registry->to_text();
+    EXPECT_NE(text.find("mrc_channel_occupancy{direction=\"input\",name=\"test_node\"} 1"), std::string::npos)
+        << text;
+    EXPECT_NE(text.find("mrc_channel_high_water_mark{direction=\"input\",name=\"test_node\"} 2"), std::string::npos)
+        << text;
+    EXPECT_NE(text.find("mrc_channel_reads_total{direction=\"input\",name=\"test_node\"} 1"), std::string::npos)
+        << text;
+
+    // The registry keeps reporting the final values after the channel is destroyed
+    channel.reset();
+    text = m_registry->to_text();
+    EXPECT_NE(text.find("mrc_channel_writes_total{direction=\"input\",name=\"test_node\"} 2"), std::string::npos)
+        << text;
+}
+
 }  // namespace mrc
@@ -18,6 +18,11 @@
 #include "test_mrc.hpp"
 
 #include "mrc/channel/status.hpp"  // for Status
+#include "mrc/coroutines/async_generator.hpp"
+#include "mrc/coroutines/task.hpp"
+#include "mrc/coroutines/thread_pool.hpp"
+#include "mrc/node/coro_node.hpp"
+#include "mrc/node/operators/batch.hpp"
 #include "mrc/node/rx_node.hpp"
 #include "mrc/node/rx_sink.hpp"
 #include "mrc/node/rx_source.hpp"
@@ -32,6 +37,7 @@
 #include "mrc/segment/object.hpp"
 #include "mrc/utils/string_utils.hpp"
 
+#include <boost/fiber/operations.hpp>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 #include <rxcpp/rx.hpp>
@@ -48,9 +54,7 @@
 #include <string>
 #include <thread>
 #include <utility>
-
-// IWYU thinks we need vector for make_segment
-// IWYU pragma: no_include <vector>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -485,6 +489,118 @@ TEST_F(TestNode, NodePrologueEpilogue)
     EXPECT_EQ(epilogue_tap_sum, 20);
 }
 
+TEST_F(TestNode, NodeAndSinkTypeErased)
+{
+    auto p = mrc::make_pipeline();
+
+    std::atomic<int> sink_sum       = 0;
+    std::atomic<int> complete_count = 0;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.make_source<int>("src1", [&](rxcpp::subscriber<int>& s) {
+            s.on_next(1);
+            s.on_next(2);
+            s.on_next(3);
+            s.on_next(4);
+            s.on_completed();
+        });
+
+        // make_stream and an already type erased observer take the dynamic subscription path
+        auto node = seg.make_node<int>("node");
+
+        node->object().make_stream([](const rxcpp::observable<int>& input) {
+            return input.map([](int x) {
+                return x * 3;
+            });
+        });
+
+        seg.make_edge(source, node);
+
+        auto sink = seg.make_sink<int>("sinkRef",
+                                       rxcpp::make_observer_dynamic<int>(
+                                           [&](int x) {
+                                               sink_sum += x;
+                                           },
+                                           [&]() {
+                                               ++complete_count;
+                                           }));
+
+        seg.make_edge(node, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    EXPECT_EQ(sink_sum, 30);
+    EXPECT_EQ(complete_count, 1);
+}
+
+TEST_F(TestNode, SinkObserverSharedAcrossEngines)
+{
+    // Records the address of the instance it is invoked through. A static observer must be shared by every progress
+    // engine, the same as a type erased one, rather than copied per subscription
+    struct RecordInstance
+    {
+        std::mutex* mutex;
+        std::set<const RecordInstance*>* instances;
+
+        void operator()(int /*x*/) const
+        {
+            std::lock_guard<std::mutex> lock(*mutex);
+            instances->insert(this);
+        }
+    };
+
+    auto p = mrc::make_pipeline();
+
+    std::mutex mut;
+    std::set<const RecordInstance*> instances;
+    std::atomic<int> complete_count = 0;
+
+    auto my_segment = p->make_segment("my_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.make_source<int>("src1", [&](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100; ++i)
+            {
+                s.on_next(i);
+                boost::this_fiber::yield();
+            }
+            s.on_completed();
+        });
+
+        auto sink = seg.make_sink<int>("sink", RecordInstance{&mut, &instances}, [&]() {
+            ++complete_count;
+        });
+
+        sink->launch_options().pe_count = 2;
+
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0-1");
+    options->topology().restrict_gpus(true);
+    options->placement().resources_strategy(PlacementResources::Shared);
+
+    Executor exec(std::move(options));
+
+    exec.register_pipeline(std::move(p));
+
+    exec.start();
+
+    exec.join();
+
+    EXPECT_EQ(instances.size(), 1);
+    EXPECT_EQ(complete_count, 2);
+}
+
 TEST_F(TestNode, RxNodeComponentThrows)
 {
     auto p                           = mrc::make_pipeline();
@@ -533,6 +649,330 @@ TEST_F(TestNode, RxNodeComponentThrows)
     EXPECT_EQ(complete_count, 0);
 }
 
+TEST_F(TestNode, RxNodeComponentChain)
+{
+    auto p = mrc::make_pipeline();
+
+    std::vector<std::string> values;
+    std::atomic<int> complete_count = 0;
+
+    auto my_segment = p->make_segment("test_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.make_source<int>("source", [&](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 5; ++i)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        // The three components are fused into a single observable chain by the segment builder
+        auto doubler = seg.make_node_component<int, int>("doubler", rxcpp::operators::map([](int x) {
+                                                             return x * 2;
+                                                         }));
+
+        auto offset = seg.make_node_component<int, int>("offset", rxcpp::operators::map([](int x) {
+                                                            return x + 1;
+                                                        }));
+
+        auto to_string = seg.make_node_component<int, std::string>("to_string",
+                                                                   rxcpp::operators::map([](int x) {
+                                                                       return std::to_string(x);
+                                                                   }));
+
+        auto sink = seg.make_sink<std::string>(
+            "sink",
+            [&](const std::string& x) {
+                values.push_back(x);
+            },
+            [&]() {
+                ++complete_count;
+            });
+
+        seg.make_edge(source, doubler);
+        seg.make_edge(doubler, offset);
+        seg.make_edge(offset, to_string);
+        seg.make_edge(to_string, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    EXPECT_EQ(values, (std::vector<std::string>{"1", "3", "5", "7", "9"}));
+    EXPECT_EQ(complete_count, 1);
+}
+
+TEST_F(TestNode, BatchBySizeAndUnbatch)
+{
+    auto p = mrc::make_pipeline();
+
+    std::vector<std::size_t> batch_sizes;
+    std::vector<int> values;
+    std::atomic<int> complete_count = 0;
+
+    auto my_segment = p->make_segment("test_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.make_source<int>("source", [&](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 10; ++i)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        // The time trigger is far longer than the test, so batches are only cut by size and by completion
+        auto batch = seg.construct_object<node::Batch<int>>("batch", 4, std::chrono::seconds(10));
+
+        auto batch_tap = seg.make_node<std::vector<int>>("batch_tap",
+                                                         rxcpp::operators::map([&](std::vector<int> x) {
+                                                             batch_sizes.push_back(x.size());
+                                                             return x;
+                                                         }));
+
+        auto unbatch = seg.construct_object<node::Unbatch<int>>("unbatch", batch->object().pool());
+
+        auto sink = seg.make_sink<int>(
+            "sink",
+            [&](const int& x) {
+                values.push_back(x);
+            },
+            [&]() {
+                ++complete_count;
+            });
+
+        seg.make_edge(source, batch);
+        seg.make_edge(batch, batch_tap);
+        seg.make_edge(batch_tap, unbatch);
+        seg.make_edge(unbatch, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    EXPECT_EQ(batch_sizes, (std::vector<std::size_t>{4, 4, 2}));
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(complete_count, 1);
+}
+
+TEST_F(TestNode, BatchByTime)
+{
+    auto p = mrc::make_pipeline();
+
+    std::vector<std::vector<int>> batches;
+
+    auto my_segment = p->make_segment("test_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.make_source<int>("source", [&](rxcpp::subscriber<int>& s) {
+            s.on_next(1);
+            s.on_next(2);
+            s.on_next(3);
+            boost::this_fiber::sleep_for(200ms);
+            s.on_next(4);
+            s.on_completed();
+        });
+
+        auto batch = seg.construct_object<node::Batch<int>>("batch", 100, std::chrono::milliseconds(20));
+
+        auto sink = seg.make_sink<std::vector<int>>("sink", [&](const std::vector<int>& x) {
+            batches.push_back(x);
+        });
+
+        seg.make_edge(source, batch);
+        seg.make_edge(batch, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    ASSERT_EQ(batches.size(), 2);
+    EXPECT_EQ(batches[0], (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(batches[1], (std::vector<int>{4}));
+}
+
+TEST_F(TestNode, BatchInvalidArguments)
+{
+    EXPECT_THROW(node::Batch<int>(0, std::chrono::milliseconds(1)), std::invalid_argument);
+    EXPECT_THROW(node::Batch<int>(1, std::chrono::milliseconds(-1)), std::invalid_argument);
+}
+
+TEST_F(TestNode, CoroNodeEndToEnd)
+{
+    auto p = mrc::make_pipeline();
+
+    std::vector<std::string> values;
+    std::atomic<int> complete_count = 0;
+
+    auto my_segment = p->make_segment("test_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.make_source<int>("source", [&](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 10; ++i)
+            {
+                s.on_next(i);
+            }
+            s.on_completed();
+        });
+
+        // the first node writes directly into the ring buffer of the second, the second writes into an rx sink
+        auto doubler = seg.make_node<int, int, node::CoroNode>(
+            "doubler",
+            [](coroutines::AsyncGenerator<int> input, node::CoroWriter<int> output) -> coroutines::Task<void> {
+                auto iter = co_await input.begin();
+                while (iter != input.end())
+                {
+                    co_await output.write(*iter * 2);
+                    co_await ++iter;
+                }
+            });
+
+        auto to_string = seg.make_node<int, std::string, node::CoroNode>(
+            "to_string",
+            [](coroutines::AsyncGenerator<int> input, node::CoroWriter<std::string> output) -> coroutines::Task<void> {
+                auto iter = co_await input.begin();
+                while (iter != input.end())
+                {
+                    co_await output.write(std::to_string(*iter));
+                    co_await ++iter;
+                }
+            });
+
+        auto sink = seg.make_sink<std::string>(
+            "sink",
+            [&](const std::string& x) {
+                values.push_back(x);
+            },
+            [&]() {
+                ++complete_count;
+            });
+
+        seg.make_edge(source, doubler);
+        seg.make_edge(doubler, to_string);
+        seg.make_edge(to_string, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    EXPECT_EQ(values, (std::vector<std::string>{"0", "2", "4", "6", "8", "10", "12", "14", "16", "18"}));
+    EXPECT_EQ(complete_count, 1);
+}
+
+TEST_F(TestNode, CoroSourceToCoroSinkOnThreadPool)
+{
+    auto p = mrc::make_pipeline();
+
+    auto thread_pool = std::make_shared<coroutines::ThreadPool>(coroutines::ThreadPool::Options{.thread_count = 2});
+
+    std::atomic<int> sum            = 0;
+    std::atomic<int> complete_count = 0;
+
+    auto my_segment = p->make_segment("test_segment", [&](segment::IBuilder& seg) {
+        auto source = seg.construct_object<node::CoroSource<int>>(
+            "source",
+            [](node::CoroWriter<int> output) -> coroutines::Task<void> {
+                for (int i = 1; i <= 1000; ++i)
+                {
+                    co_await output.write(int(i));
+                }
+            });
+        source->object().set_thread_pool(thread_pool);
+
+        auto sink = seg.construct_object<node::CoroSink<int>>(
+            "sink",
+            [&](coroutines::AsyncGenerator<int> input) -> coroutines::Task<void> {
+                auto iter = co_await input.begin();
+                while (iter != input.end())
+                {
+                    sum += *iter;
+                    co_await ++iter;
+                }
+                ++complete_count;
+            });
+        sink->object().set_thread_pool(thread_pool);
+
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    EXPECT_EQ(sum, 500500);
+    EXPECT_EQ(complete_count, 1);
+}
+
+TEST_F(TestNode, CoroSinkResumesOnThreadPool)
+{
+    auto p = mrc::make_pipeline();
+
+    auto thread_pool = std::make_shared<coroutines::ThreadPool>(coroutines::ThreadPool::Options{.thread_count = 2});
+
+    std::atomic<int> count          = 0;
+    std::atomic<int> off_pool_count = 0;
+
+    auto my_segment = p->make_segment("test_segment", [&](segment::IBuilder& seg) {
+        // the fiber source refills the buffer after every read, so the sink keeps suspending on an empty buffer and
+        // being woken by a write made on the engine's thread
+        auto source = seg.make_source<int>("source", [&](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < 100; ++i)
+            {
+                s.on_next(i);
+                boost::this_fiber::yield();
+            }
+            s.on_completed();
+        });
+
+        auto sink = seg.construct_object<node::CoroSink<int>>(
+            "sink",
+            [&](coroutines::AsyncGenerator<int> input) -> coroutines::Task<void> {
+                auto iter = co_await input.begin();
+                while (iter != input.end())
+                {
+                    ++count;
+                    if (coroutines::ThreadPool::from_current_thread() != thread_pool.get())
+                    {
+                        ++off_pool_count;
+                    }
+                    co_await ++iter;
+                }
+            },
+            1);
+        sink->object().set_thread_pool(thread_pool);
+
+        seg.make_edge(source, sink);
+    });
+
+    auto options = std::make_unique<Options>();
+    options->topology().user_cpuset("0");
+
+    Executor exec(std::move(options));
+    exec.register_pipeline(std::move(p));
+    exec.start();
+    exec.join();
+
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(off_pool_count, 0);
+}
+
 // the parallel tests:
 // - SourceMultiThread
 // - SinkMultiThread
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,6 +18,7 @@
 #include "test_segment.hpp"
 
 #include "mrc/benchmarking/trace_statistics.hpp"
+#include "mrc/channel/factory.hpp"
 #include "mrc/exceptions/runtime_error.hpp"
 #include "mrc/node/operators/broadcast.hpp"
 #include "mrc/node/rx_node.hpp"
@@ -655,6 +656,33 @@ TEST_F(TestSegment, SegmentSingleSourceTwoNodesException)
     // auto builder =  std::make_unique<segment::IBuilder>(segdef, 42);
 }
 
+TEST_F(TestSegment, SegmentRingSpscEdgeRequiresSingleWriterAndReader)
+{
+    auto init = [&](segment::IBuilder& segment) {
+        auto src1 = segment.make_source<int>("src1", [&](rxcpp::subscriber<int>& s) {
+            s.on_completed();
+        });
+
+        auto src2 = segment.make_source<int>("src2", [&](rxcpp::subscriber<int>& s) {
+            s.on_completed();
+        });
+
+        auto sink = segment.make_sink<int>("sink", [](int x) {});
+
+        // Multiple engines would read from the ring concurrently
+        sink->launch_options().pe_count = 2;
+        EXPECT_THROW(segment.make_edge(src1, sink, channel::ChannelType::ring_spsc), exceptions::MrcRuntimeError);
+
+        sink->launch_options().pe_count = 1;
+        segment.make_edge(src1, sink, channel::ChannelType::ring_spsc);
+
+        // A second upstream would make the ring multi-producer
+        EXPECT_THROW(segment.make_edge(src2, sink), exceptions::MrcRuntimeError);
+    };
+
+    auto segdef = Segment::create("segment_test", init);
+}
+
 TEST_F(TestSegment, SegmentSingleSourceTwoNodes)
 {
     unsigned int iterations{3};
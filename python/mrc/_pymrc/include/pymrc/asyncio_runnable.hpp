@@ -25,20 +25,158 @@
 #include <boost/fiber/future/async.hpp>
 #include <mrc/channel/buffered_channel.hpp>
 #include <mrc/channel/status.hpp>
+#include <mrc/core/utils.hpp>
 #include <mrc/coroutines/async_generator.hpp>
-#include <mrc/coroutines/closable_ring_buffer.hpp>
+#include <mrc/coroutines/scheduler.hpp>
 #include <mrc/coroutines/task.hpp>
 #include <mrc/coroutines/task_container.hpp>
 #include <mrc/exceptions/exception_catcher.hpp>
 #include <mrc/node/sink_properties.hpp>
 #include <mrc/runnable/forward.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <exception>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
 
 namespace mrc::pymrc {
 
+/**
+ * @brief Point in time view of one of an AsyncioRunnable's event loops.
+ */
+struct AsyncioLoopStats
+{
+    std::size_t rank{0};             // rank of the engine hosting the loop
+    std::size_t queue_depth{0};      // values read from the channel whose task has not finished
+    std::size_t high_water_mark{0};  // largest queue_depth observed
+    std::uint64_t tasks_completed{0};
+    std::chrono::nanoseconds total_task_latency{0};  // summed time from reading a value to its task finishing
+    std::chrono::nanoseconds max_task_latency{0};
+};
+
+namespace detail {
+
+struct AsyncioLoopCounters
+{
+    std::atomic<std::size_t> queue_depth{0};
+    std::atomic<std::size_t> high_water_mark{0};
+    std::atomic<std::uint64_t> tasks_completed{0};
+    std::atomic<std::uint64_t> total_task_latency_ns{0};
+    std::atomic<std::uint64_t> max_task_latency_ns{0};
+
+    void record_start()
+    {
+        auto depth           = queue_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto high_water_mark = this->high_water_mark.load(std::memory_order_relaxed);
+        while (depth > high_water_mark &&
+               !this->high_water_mark.compare_exchange_weak(high_water_mark, depth, std::memory_order_relaxed))
+        {}
+    }
+
+    void record_finish(std::chrono::steady_clock::duration latency)
+    {
+        auto latency_ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+
+        queue_depth.fetch_sub(1, std::memory_order_relaxed);
+        tasks_completed.fetch_add(1, std::memory_order_relaxed);
+        total_task_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+
+        auto max_latency_ns = max_task_latency_ns.load(std::memory_order_relaxed);
+        while (latency_ns > max_latency_ns &&
+               !max_task_latency_ns.compare_exchange_weak(max_latency_ns, latency_ns, std::memory_order_relaxed))
+        {}
+    }
+};
+
+/**
+ * @brief Bounds the number of tasks in flight on one event loop. acquire() suspends the caller until a slot is free;
+ * release() hands the slot straight to the oldest waiter, which is resumed through the scheduler rather than inline.
+ */
+class InFlightLimiter
+{
+  public:
+    InFlightLimiter(std::size_t limit, std::shared_ptr<mrc::coroutines::Scheduler> scheduler) :
+      m_limit(limit),
+      m_scheduler(std::move(scheduler))
+    {}
+
+    auto acquire()
+    {
+        struct Awaiter
+        {
+            InFlightLimiter& m_limiter;
+
+            bool await_ready()
+            {
+                std::lock_guard<std::mutex> lock(m_limiter.m_mutex);
+                if (m_limiter.m_in_flight < m_limiter.m_limit)
+                {
+                    ++m_limiter.m_in_flight;
+                    return true;
+                }
+                return false;
+            }
+
+            bool await_suspend(std::coroutine_handle<> handle)
+            {
+                std::lock_guard<std::mutex> lock(m_limiter.m_mutex);
+
+                // A slot may have been released between await_ready and now
+                if (m_limiter.m_in_flight < m_limiter.m_limit)
+                {
+                    ++m_limiter.m_in_flight;
+                    return false;
+                }
+
+                m_limiter.m_waiters.push_back(handle);
+                return true;
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        return Awaiter{*this};
+    }
+
+    void release()
+    {
+        std::coroutine_handle<> waiter;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_waiters.empty())
+            {
+                --m_in_flight;
+                return;
+            }
+
+            waiter = m_waiters.front();
+            m_waiters.pop_front();
+        }
+
+        m_scheduler->resume(waiter);
+    }
+
+  private:
+    const std::size_t m_limit;
+    std::shared_ptr<mrc::coroutines::Scheduler> m_scheduler;
+
+    std::mutex m_mutex;
+    std::size_t m_in_flight{0};
+    std::deque<std::coroutine_handle<>> m_waiters;
+};
+
+}  // namespace detail
+
 /**
  * @brief A wrapper for executing a function as an async boost fiber, the result of which is a
  * C++20 coroutine awaiter.
@@ -172,18 +310,49 @@ class AsyncSource : public mrc::node::WritableAcceptor<T>,
 
 /**
  * @brief A MRC Runnable base class which hosts it's own asyncio loop and exposes a flatmap hook
+ *
+ * Every engine the runnable is launched on (see LaunchOptions::pe_count and engines_per_pe) hosts its own event loop,
+ * all reading from the same input channel. Each loop runs at most `max_concurrent_tasks` on_data tasks at once and
+ * stops reading from the channel while it is at that limit, so a runnable with N engines has at most
+ * N * max_concurrent_tasks values in flight.
  */
 template <typename InputT, typename OutputT>
 class AsyncioRunnable : public AsyncSink<InputT>,
                         public AsyncSource<OutputT>,
                         public mrc::runnable::RunnableWithContext<>
 {
-    using state_t       = mrc::runnable::Runnable::State;
-    using task_buffer_t = mrc::coroutines::ClosableRingBuffer<size_t>;
+    using state_t = mrc::runnable::Runnable::State;
 
   public:
+    static constexpr std::size_t DefaultMaxConcurrentTasks = 8;
+
+    // the event loop is bound to the thread which runs it, never migrate between threads
+    static constexpr bool requires_thread_affinity = true;
+
+    AsyncioRunnable(std::size_t max_concurrent_tasks = DefaultMaxConcurrentTasks) :
+      m_max_concurrent_tasks(max_concurrent_tasks)
+    {
+        if (m_max_concurrent_tasks == 0)
+        {
+            throw std::invalid_argument("AsyncioRunnable max_concurrent_tasks must be greater than 0");
+        }
+    }
+
     ~AsyncioRunnable() override = default;
 
+    /**
+     * @brief Maximum number of on_data tasks in flight on each of the runnable's event loops.
+     */
+    std::size_t max_concurrent_tasks() const
+    {
+        return m_max_concurrent_tasks;
+    }
+
+    /**
+     * @brief Queue depth and task latency of each event loop which has been started, ordered by rank.
+     */
+    std::vector<AsyncioLoopStats> loop_stats() const;
+
   private:
     /**
      * @brief Runnable's entrypoint.
@@ -198,14 +367,18 @@ class AsyncioRunnable : public AsyncSink<InputT>,
     /**
      * @brief The top-level coroutine which is run while the asyncio event loop is running.
      */
-    coroutines::Task<> main_task(std::shared_ptr<mrc::coroutines::Scheduler> scheduler);
+    coroutines::Task<> main_task(std::shared_ptr<mrc::coroutines::Scheduler> scheduler,
+                                 detail::AsyncioLoopCounters& counters);
 
     /**
      * @brief The per-value coroutine run asynchronously alongside other calls.
      */
     coroutines::Task<> process_one(InputT value,
                                    std::shared_ptr<mrc::coroutines::Scheduler> on,
-                                   ExceptionCatcher& catcher);
+                                   ExceptionCatcher& catcher,
+                                   detail::InFlightLimiter& limiter,
+                                   detail::AsyncioLoopCounters& counters,
+                                   std::chrono::steady_clock::time_point read_time);
 
     /**
      * @brief Value's read from the sink's channel are fed to this function and yields from the
@@ -214,14 +387,60 @@ class AsyncioRunnable : public AsyncSink<InputT>,
     virtual mrc::coroutines::AsyncGenerator<OutputT> on_data(InputT&& value,
                                                              std::shared_ptr<mrc::coroutines::Scheduler> on) = 0;
 
+    /**
+     * @brief Creates the counters for the loop hosted by the engine with the given rank.
+     */
+    detail::AsyncioLoopCounters& register_loop(std::size_t rank);
+
+    const std::size_t m_max_concurrent_tasks;
+
     std::stop_source m_stop_source;
+
+    mutable std::mutex m_loop_counters_mutex;
+    std::map<std::size_t, std::unique_ptr<detail::AsyncioLoopCounters>> m_loop_counters;
 };
 
+template <typename InputT, typename OutputT>
+std::vector<AsyncioLoopStats> AsyncioRunnable<InputT, OutputT>::loop_stats() const
+{
+    std::lock_guard<std::mutex> lock(m_loop_counters_mutex);
+
+    std::vector<AsyncioLoopStats> stats;
+    stats.reserve(m_loop_counters.size());
+
+    for (const auto& [rank, counters] : m_loop_counters)
+    {
+        auto& loop              = stats.emplace_back();
+        loop.rank               = rank;
+        loop.queue_depth        = counters->queue_depth.load(std::memory_order_relaxed);
+        loop.high_water_mark    = counters->high_water_mark.load(std::memory_order_relaxed);
+        loop.tasks_completed    = counters->tasks_completed.load(std::memory_order_relaxed);
+        loop.total_task_latency = std::chrono::nanoseconds(
+            counters->total_task_latency_ns.load(std::memory_order_relaxed));
+        loop.max_task_latency = std::chrono::nanoseconds(counters->max_task_latency_ns.load(std::memory_order_relaxed));
+    }
+
+    return stats;
+}
+
+template <typename InputT, typename OutputT>
+detail::AsyncioLoopCounters& AsyncioRunnable<InputT, OutputT>::register_loop(std::size_t rank)
+{
+    std::lock_guard<std::mutex> lock(m_loop_counters_mutex);
+
+    auto& counters = m_loop_counters[rank];
+    counters       = std::make_unique<detail::AsyncioLoopCounters>();
+
+    return *counters;
+}
+
 template <typename InputT, typename OutputT>
 void AsyncioRunnable<InputT, OutputT>::run(mrc::runnable::Context& ctx)
 {
     std::exception_ptr exception;
 
+    auto& counters = this->register_loop(ctx.rank());
+
     {
         py::gil_scoped_acquire gil;
 
@@ -254,7 +473,7 @@ void AsyncioRunnable<InputT, OutputT>::run(mrc::runnable::Context& ctx)
         // TODO(MDD): Eventually we should get this from the context object. For now, just create it directly
         auto scheduler = std::make_shared<AsyncioScheduler>(loop);
 
-        auto py_awaitable = coro::BoostFibersMainPyAwaitable(this->main_task(scheduler));
+        auto py_awaitable = coro::BoostFibersMainPyAwaitable(this->main_task(scheduler, counters));
 
         DVLOG(10) << "AsyncioRunnable::run() > Calling run_until_complete() on main_task()";
 
@@ -287,24 +506,33 @@ void AsyncioRunnable<InputT, OutputT>::run(mrc::runnable::Context& ctx)
 }
 
 template <typename InputT, typename OutputT>
-coroutines::Task<> AsyncioRunnable<InputT, OutputT>::main_task(std::shared_ptr<mrc::coroutines::Scheduler> scheduler)
+coroutines::Task<> AsyncioRunnable<InputT, OutputT>::main_task(std::shared_ptr<mrc::coroutines::Scheduler> scheduler,
+                                                               detail::AsyncioLoopCounters& counters)
 {
-    coroutines::TaskContainer outstanding_tasks(scheduler, 8);
+    // Declared first so it outlives any task still held by the container
+    detail::InFlightLimiter limiter(m_max_concurrent_tasks, scheduler);
+    coroutines::TaskContainer outstanding_tasks(scheduler, m_max_concurrent_tasks);
 
     ExceptionCatcher catcher{};
 
     while (not m_stop_source.stop_requested() and not catcher.has_exception())
     {
+        // Leave values in the channel for the other loops while this one is at its limit
+        co_await limiter.acquire();
+
         InputT data;
 
         auto read_status = co_await this->read_async(data);
 
         if (read_status != mrc::channel::Status::success)
         {
+            limiter.release();
             break;
         }
 
-        outstanding_tasks.start(this->process_one(std::move(data), scheduler, catcher));
+        counters.record_start();
+        outstanding_tasks.start(this->process_one(
+            std::move(data), scheduler, catcher, limiter, counters, std::chrono::steady_clock::now()));
     }
 
     co_await outstanding_tasks.garbage_collect_and_yield_until_empty();
@@ -315,8 +543,16 @@ coroutines::Task<> AsyncioRunnable<InputT, OutputT>::main_task(std::shared_ptr<m
 template <typename InputT, typename OutputT>
 coroutines::Task<> AsyncioRunnable<InputT, OutputT>::process_one(InputT value,
                                                                  std::shared_ptr<mrc::coroutines::Scheduler> on,
-                                                                 ExceptionCatcher& catcher)
+                                                                 ExceptionCatcher& catcher,
+                                                                 detail::InFlightLimiter& limiter,
+                                                                 detail::AsyncioLoopCounters& counters,
+                                                                 std::chrono::steady_clock::time_point read_time)
 {
+    Unwinder finished([&]() {
+        counters.record_finish(std::chrono::steady_clock::now() - read_time);
+        limiter.release();
+    });
+
     co_await on->yield();
 
     try
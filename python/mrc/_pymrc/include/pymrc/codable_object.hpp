@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -25,16 +25,119 @@
 #include "mrc/codable/decode.hpp"
 #include "mrc/codable/encode.hpp"
 #include "mrc/codable/encoding_options.hpp"
+#include "mrc/codable/types.hpp"
+#include "mrc/memory/buffer_view.hpp"
 #include "mrc/memory/memory_kind.hpp"
 
 #include <Python.h>
 #include <glog/logging.h>
+#include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
-#include <iomanip>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 #include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace mrc::pymrc::detail {
+
+/**
+ * Python objects are encoded as a protocol 5 pickle using the descriptors starting at the object's first index:
+ *   - an eager descriptor holding the number of out-of-band buffers
+ *   - the pickle header
+ *   - one descriptor per out-of-band buffer
+ *
+ * Out-of-band buffers are registered as views into the memory of the object being encoded, unless `force_copy` is set
+ * or the storage declines to register them, in which case they are copied. The pickle is released on return, so a
+ * buffer whose exporter is not owned by `py_object`, e.g. a temporary created by its `__reduce_ex__`, is always copied.
+ */
+template <typename RegisterFnT, typename CopyToEagerFnT, typename CopyToBufferFnT>
+void encode_pickled(pybind11::object py_object,
+                    const codable::EncodingOptions& opts,
+                    RegisterFnT&& register_memory_view,
+                    CopyToEagerFnT&& copy_to_eager_descriptor,
+                    CopyToBufferFnT&& copy_to_new_buffer)
+{
+    // The shared memory descriptor is tiny, the object itself has already been written to the block
+    auto pickled = opts.use_shm() ? Serializer::serialize_out_of_band(Serializer::persist_to_shared_memory(py_object))
+                                  : Serializer::serialize_out_of_band(py_object);
+
+    // Only the encoded object outlives the encoding; with shared memory that is not the object which was pickled
+    auto owned = opts.force_copy() ? std::vector<bool>(pickled.buffers.size(), false)
+                                   : pickled.buffers_owned_by(py_object);
+
+    std::uint64_t buffer_count = pickled.buffers.size();
+    copy_to_eager_descriptor(memory::const_buffer_view(&buffer_count, sizeof(buffer_count), memory::memory_kind::host));
+
+    // The header is a temporary, so it is always copied
+    copy_to_new_buffer(pickled.header_view());
+
+    for (std::size_t i = 0; i < pickled.buffers.size(); ++i)
+    {
+        const auto& buffer = pickled.buffers[i];
+
+        if (!owned[i])
+        {
+            copy_to_new_buffer(buffer);
+        }
+        else if (!register_memory_view(buffer))
+        {
+            copy_to_eager_descriptor(buffer);
+        }
+    }
+}
+
+/**
+ * Rebuilds an object written by encode_pickled. Each descriptor is copied exactly once, directly into the memory of the
+ * bytes/bytearray objects handed to pickle, and the copies are made without holding the GIL.
+ */
+template <typename CopyFromBufferFnT, typename BufferSizeFnT>
+pybind11::object decode_pickled(codable::idx_t start_idx,
+                                CopyFromBufferFnT&& copy_from_buffer,
+                                BufferSizeFnT&& buffer_size)
+{
+    std::uint64_t buffer_count{0};
+    copy_from_buffer(start_idx, memory::buffer_view(&buffer_count, sizeof(buffer_count), memory::memory_kind::host));
+
+    auto header_bytes = buffer_size(start_idx + 1);
+    auto header       = pybind11::reinterpret_steal<pybind11::bytes>(PyBytes_FromStringAndSize(nullptr, header_bytes));
+    if (!header)
+    {
+        throw pybind11::error_already_set();
+    }
+
+    std::vector<memory::buffer_view> dst_views;
+    dst_views.emplace_back(PyBytes_AS_STRING(header.ptr()), header_bytes, memory::memory_kind::host);
+
+    pybind11::list buffers;
+    for (std::uint64_t i = 0; i < buffer_count; ++i)
+    {
+        auto bytes  = buffer_size(start_idx + 2 + i);
+        auto buffer = pybind11::reinterpret_steal<pybind11::object>(PyByteArray_FromStringAndSize(nullptr, bytes));
+        if (!buffer)
+        {
+            throw pybind11::error_already_set();
+        }
+
+        dst_views.emplace_back(PyByteArray_AS_STRING(buffer.ptr()), bytes, memory::memory_kind::host);
+        buffers.append(std::move(buffer));
+    }
+
+    {
+        pybind11::gil_scoped_release nogil;
+        for (std::size_t i = 0; i < dst_views.size(); ++i)
+        {
+            copy_from_buffer(start_idx + 1 + i, dst_views[i]);
+        }
+    }
+
+    return Deserializer::deserialize_out_of_band(std::move(header), std::move(buffers));
+}
+
+}  // namespace mrc::pymrc::detail
 
 namespace mrc::codable {
 
@@ -43,33 +146,38 @@ struct codable_protocol<T, std::enable_if_t<std::is_same_v<T, pybind11::object>>
 {
     static void serialize(const T& py_object, Encoder<T>& encoded, const EncodingOptions& opts)
     {
-        using namespace mrc::pymrc;
         VLOG(8) << "Serializing python object";
         pybind11::gil_scoped_acquire gil;
-        pybind11::buffer_info py_bytebuffer;
-        std::tuple<char*, std::size_t> serialized_obj;
-
-        // Serialize the object
-        serialized_obj = Serializer::serialize(py_object, opts.use_shm(), !opts.force_copy());
 
-        // Copy it or not.
-        encoded.add_memory_block(memory::const_buffer_view(std::get<0>(serialized_obj),
-                                                           std::get<1>(serialized_obj),
-                                                           memory::memory_kind::host));
+        pymrc::detail::encode_pickled(
+            py_object,
+            opts,
+            [&encoded](memory::const_buffer_view view) {
+                return encoded.register_memory_view(std::move(view)).has_value();
+            },
+            [&encoded](memory::const_buffer_view view) {
+                encoded.copy_to_eager_descriptor(std::move(view));
+            },
+            [&encoded](memory::const_buffer_view view) {
+                auto idx = encoded.create_memory_buffer(view.bytes());
+                encoded.copy_to_buffer(idx, std::move(view));
+            });
     }
 
     static T deserialize(const Decoder<T>& encoded, std::size_t object_idx)
     {
-        using namespace mrc::pymrc;
         VLOG(8) << "De-serializing python object";
         pybind11::gil_scoped_acquire gil;
         DCHECK_EQ(std::type_index(typeid(T)).hash_code(), encoded.type_index_hash_for_object(object_idx));
 
-        auto idx           = encoded.start_idx_for_object(object_idx);
-        const auto& buffer = encoded.memory_block(idx);
-        const char* data   = static_cast<const char*>(buffer.data());
-
-        return Deserializer::deserialize(data, buffer.bytes());
+        return pymrc::detail::decode_pickled(
+            encoded.start_idx_for_object(object_idx),
+            [&encoded](idx_t idx, memory::buffer_view view) {
+                encoded.copy_from_buffer(idx, std::move(view));
+            },
+            [&encoded](idx_t idx) {
+                return encoded.buffer_size(idx);
+            });
     }
 };
 
@@ -78,33 +186,38 @@ struct codable_protocol<T, std::enable_if_t<std::is_same_v<T, pymrc::PyHolder>>>
 {
     static void serialize(const T& pyholder_object, Encoder<T>& encoded, const EncodingOptions& opts)
     {
-        using namespace mrc::pymrc;
         VLOG(8) << "Serializing PyHolder object";
         pybind11::gil_scoped_acquire gil;
-        pybind11::object py_object = pyholder_object.copy_obj();  // Not a deep copy, just inc_ref the pointer.
-        pybind11::buffer_info py_bytebuffer;
-        std::tuple<char*, std::size_t> serialized_obj;
-
-        // Serialize the object
-        serialized_obj = Serializer::serialize(py_object, opts.use_shm(), !opts.force_copy());
 
-        // Copy it or not.
-        encoded.add_memory_block(
-            memory::buffer_view(std::get<0>(serialized_obj), std::get<1>(serialized_obj), memory::memory_kind::host));
+        pymrc::detail::encode_pickled(
+            pyholder_object.copy_obj(),  // Not a deep copy, just inc_ref the pointer.
+            opts,
+            [&encoded](memory::const_buffer_view view) {
+                return encoded.register_memory_view(std::move(view)).has_value();
+            },
+            [&encoded](memory::const_buffer_view view) {
+                encoded.copy_to_eager_descriptor(std::move(view));
+            },
+            [&encoded](memory::const_buffer_view view) {
+                auto idx = encoded.create_memory_buffer(view.bytes());
+                encoded.copy_to_buffer(idx, std::move(view));
+            });
     }
 
     static T deserialize(const Decoder<T>& encoded, std::size_t object_idx)
     {
-        using namespace mrc::pymrc;
         VLOG(8) << "De-serializing PyHolder object";
         pybind11::gil_scoped_acquire gil;
         DCHECK_EQ(std::type_index(typeid(T)).hash_code(), encoded.type_index_hash_for_object(object_idx));
 
-        auto idx           = encoded.start_idx_for_object(object_idx);
-        const auto& buffer = encoded.memory_block(idx);
-        const char* data   = static_cast<const char*>(buffer.data());
-
-        return Deserializer::deserialize(data, buffer.bytes());
+        return pymrc::detail::decode_pickled(
+            encoded.start_idx_for_object(object_idx),
+            [&encoded](idx_t idx, memory::buffer_view view) {
+                encoded.copy_from_buffer(idx, std::move(view));
+            },
+            [&encoded](idx_t idx) {
+                return encoded.buffer_size(idx);
+            });
     }
 };
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -27,6 +27,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pymrc/types.hpp>
+#include <pymrc/utilities/object_cache.hpp>
 
 #include <coroutine>
 #include <exception>
@@ -177,7 +178,7 @@ class PYBIND11_EXPORT PyTaskToCppAwaitable
     {
         pybind11::gil_scoped_acquire acquire;
 
-        auto asyncio = pybind11::module_::import("asyncio");
+        const auto& asyncio = PythonObjectCache::get_handle().get_module("asyncio");
 
         if (not asyncio.attr("isfuture")(m_task).cast<bool>())
         {
@@ -396,7 +397,8 @@ struct type_caster<mrc::coroutines::Task<ReturnT>>
             // Always assume we are resuming without the GIL
             pybind11::gil_scoped_acquire gil;
 
-            auto asyncio_task = pybind11::module_::import("asyncio").attr("create_task")(py_task);
+            auto asyncio_task = mrc::pymrc::PythonObjectCache::get_handle().get_module("asyncio").attr("create_task")(
+                py_task);
 
             mrc::pymrc::PyHolder py_result;
             {
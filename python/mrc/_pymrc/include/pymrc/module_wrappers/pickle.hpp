@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,10 +17,11 @@
 
 #pragma once
 
+#include "pymrc/utilities/object_cache.hpp"
+
 #include <pybind11/pytypes.h>
 
 namespace mrc::pymrc {
-class PythonObjectCache;
 
 #pragma GCC visibility push(default)
 /****** PythonPickleInterface****************************************/
@@ -37,11 +38,21 @@ class PythonPickleInterface
     pybind11::bytes pickle(pybind11::object obj);
     pybind11::object unpickle(pybind11::bytes bytes);
 
-  private:
-    PythonObjectCache& m_pycache;
+    /**
+     * @brief Pickle using protocol 5, `buffer_callback` is called for each buffer in the object and returns false for
+     * those which should be passed out-of-band rather than copied into the returned bytes.
+     */
+    pybind11::bytes pickle(pybind11::object obj, pybind11::function buffer_callback);
 
-    pybind11::function m_func_loads{};
-    pybind11::function m_func_dumps{};
+    /**
+     * @brief Unpickle a protocol 5 stream, `buffers` supplies the out-of-band buffers in the order they were handed to
+     * the `buffer_callback` when pickling.
+     */
+    pybind11::object unpickle(pybind11::bytes bytes, pybind11::list buffers);
+
+  private:
+    PythonObjectCache::InternedObject m_func_loads;
+    PythonObjectCache::InternedObject m_func_dumps;
 };
 #pragma GCC visibility pop
 }  // namespace mrc::pymrc
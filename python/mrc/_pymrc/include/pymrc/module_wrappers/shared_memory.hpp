@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,12 +17,13 @@
 
 #pragma once
 
+#include "pymrc/utilities/object_cache.hpp"
+
 #include <pybind11/pytypes.h>
 
 #include <cstddef>
 
 namespace mrc::pymrc {
-class PythonObjectCache;
 
 /**
  * @brief Wrapper around the multiprocess.shared_memory class
@@ -93,9 +94,7 @@ class PythonSharedMemoryInterface
     void unlink();
 
   private:
-    PythonObjectCache& m_pycache;
-
-    pybind11::object m_shmem_interface{};
+    PythonObjectCache::InternedObject m_shmem_interface;
     pybind11::object m_shmem{pybind11::none()};
 };
 
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -34,14 +34,22 @@
 #include "mrc/node/rx_source.hpp"
 #include "mrc/runnable/context.hpp"
 
+#include <glog/logging.h>
 #include <pybind11/cast.h>
 #include <pybind11/gil.h>
 #include <pybind11/pytypes.h>
 #include <rxcpp/rx.hpp>
 
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 // Avoid forward declaring template specialization base classes
 // IWYU pragma: no_forward_declare mrc::edge::ConvertingEdgeReadable
@@ -77,6 +85,22 @@ class ConvertingEdgeWritable<
 
         return this->downstream().await_write(std::move(py_data));
     };
+
+    // Converts the whole batch under a single acquisition of the GIL
+    channel::Status await_write_n(std::span<input_t> data) final
+    {
+        std::vector<pymrc::PyHolder> py_data;
+        py_data.reserve(data.size());
+        {
+            pybind11::gil_scoped_acquire gil;
+            for (auto& item : data)
+            {
+                py_data.emplace_back(pybind11::cast(std::move(item)));
+            }
+        }
+
+        return this->downstream().await_write_n(std::span<pymrc::PyHolder>(py_data));
+    }
 };
 
 template <typename SinkT>
@@ -105,6 +129,22 @@ struct ConvertingEdgeWritable<
         return this->downstream().await_write(std::move(_data));
     }
 
+    // Converts the whole batch under a single acquisition of the GIL
+    channel::Status await_write_n(std::span<input_t> data) override
+    {
+        std::vector<output_t> _data;
+        _data.reserve(data.size());
+        {
+            pybind11::gil_scoped_acquire gil;
+            for (auto& item : data)
+            {
+                _data.emplace_back(pybind11::cast<output_t>(pybind11::object(std::move(item))));
+            }
+        }
+
+        return this->downstream().await_write_n(std::span<output_t>(_data));
+    }
+
     static void register_converter()
     {
         EdgeConnector<input_t, output_t>::register_converter();
@@ -194,6 +234,40 @@ class ConvertingEdgeReadable<
 
         return ret_val;
     }
+
+    channel::Status await_read_until(output_t& data, const channel::time_point_t& tp) override
+    {
+        input_t source_data;
+        auto ret_val = this->upstream().await_read_until(source_data, tp);
+
+        if (ret_val == channel::Status::success)
+        {
+            pymrc::AcquireGIL gil;
+
+            data = pybind11::cast(std::move(source_data));
+        }
+
+        return ret_val;
+    }
+
+    // Reads the batch with the GIL released, then converts it under a single acquisition of the GIL
+    channel::Status await_read_n(std::vector<output_t>& data, std::size_t max_count) override
+    {
+        std::vector<input_t> source_data;
+        auto ret_val = this->upstream().await_read_n(source_data, max_count);
+
+        if (!source_data.empty())
+        {
+            pymrc::AcquireGIL gil;
+
+            for (auto& item : source_data)
+            {
+                data.emplace_back(pybind11::cast(std::move(item)));
+            }
+        }
+
+        return ret_val;
+    }
 };
 
 template <typename OutputT>
@@ -224,6 +298,40 @@ struct ConvertingEdgeReadable<
         return ret_val;
     }
 
+    channel::Status await_read_until(output_t& data, const channel::time_point_t& tp) override
+    {
+        input_t source_data;
+        auto ret_val = this->upstream().await_read_until(source_data, tp);
+
+        if (ret_val == channel::Status::success)
+        {
+            pymrc::AcquireGIL gil;
+
+            data = pybind11::cast<output_t>(pybind11::object(std::move(source_data)));
+        }
+
+        return ret_val;
+    }
+
+    // Reads the batch with the GIL released, then converts it under a single acquisition of the GIL
+    channel::Status await_read_n(std::vector<output_t>& data, std::size_t max_count) override
+    {
+        std::vector<input_t> source_data;
+        auto ret_val = this->upstream().await_read_n(source_data, max_count);
+
+        if (!source_data.empty())
+        {
+            pymrc::AcquireGIL gil;
+
+            for (auto& item : source_data)
+            {
+                data.emplace_back(pybind11::cast<output_t>(pybind11::object(std::move(item))));
+            }
+        }
+
+        return ret_val;
+    }
+
     static void register_converter()
     {
         EdgeConnector<input_t, output_t>::register_converter();
@@ -249,6 +357,16 @@ struct ConvertingEdgeReadable<pymrc::PyObjectHolder, pybind11::object, void>
 
         return ret_val;
     }
+
+    channel::Status await_read_until(output_t& data, const channel::time_point_t& tp) override
+    {
+        input_t source_data;
+        auto ret_val = this->upstream().await_read_until(source_data, tp);
+
+        data = std::move(source_data);
+
+        return ret_val;
+    }
 };
 
 template <>
@@ -271,6 +389,16 @@ struct ConvertingEdgeReadable<pybind11::object, pymrc::PyObjectHolder, void>
         return ret_val;
     }
 
+    channel::Status await_read_until(output_t& data, const channel::time_point_t& tp) override
+    {
+        input_t source_data;
+        auto ret_val = this->upstream().await_read_until(source_data, tp);
+
+        data = pymrc::PyObjectHolder(std::move(source_data));
+
+        return ret_val;
+    }
+
     static void register_converter()
     {
         EdgeConnector<input_t, output_t>::register_converter();
@@ -284,6 +412,63 @@ namespace pymrc {
 // Export everything in the mrc::pymrc namespace by default since we compile with -fvisibility=hidden
 #pragma GCC visibility push(default)
 
+/**
+ * @brief Holds the GIL on a progress engine's thread across a batch of items read from a node's channel.
+ *
+ * Each progress engine needs its own scope, see PerEngineState. A progress engine does not yield its fiber between
+ * begin() and end() while it holds the GIL, so batches of the same engine never overlap.
+ */
+class GilBatchScope
+{
+  public:
+    void begin()
+    {
+        CHECK(!active()) << "GilBatchScope::begin() called while a batch already holds the GIL";
+        m_gil.emplace();
+    }
+
+    void end()
+    {
+        m_gil.reset();
+    }
+
+    bool active() const
+    {
+        return m_gil.has_value();
+    }
+
+  private:
+    std::optional<pybind11::gil_scoped_acquire> m_gil;
+};
+
+/**
+ * @brief State of a node kept separately for each of its progress engines, indexed by the rank of the engine's runtime
+ * context. local() must be called from within one of the node's progress engines.
+ */
+template <typename StateT>
+class PerEngineState
+{
+  public:
+    StateT& local()
+    {
+        const auto& context = mrc::runnable::Context::get_runtime_context();
+
+        std::call_once(m_init_flag, [this, &context] {
+            m_states.reserve(context.size());
+            for (std::size_t i = 0; i < context.size(); ++i)
+            {
+                m_states.push_back(std::make_unique<StateT>());
+            }
+        });
+
+        return *m_states[context.rank()];
+    }
+
+  private:
+    std::once_flag m_init_flag;
+    std::vector<std::unique_ptr<StateT>> m_states;
+};
+
 template <typename InputT, typename ContextT = mrc::runnable::Context>
 class PythonSink : public node::RxSink<InputT, ContextT>,
                    public pymrc::AutoRegSinkAdapter<InputT>,
@@ -292,9 +477,51 @@ class PythonSink : public node::RxSink<InputT, ContextT>,
     using base_t = node::RxSink<InputT>;
 
   public:
+    // holds the GIL across batches and relies on per-thread python state, never migrate between threads
+    static constexpr bool requires_thread_affinity = true;
+
     using typename base_t::observer_t;
 
     using base_t::base_t;
+
+    /**
+     * @brief Read up to `gil_batch_size` items from the channel with the GIL released, then acquire the GIL once to
+     * call the sink's on_next for all of them. The default of 1 acquires the GIL separately for every item.
+     */
+    void set_gil_batch_size(std::size_t gil_batch_size)
+    {
+        if (gil_batch_size == 0)
+        {
+            throw std::invalid_argument("gil_batch_size must be greater than 0");
+        }
+
+        m_gil_batched = gil_batch_size > 1;
+        if (m_gil_batched)
+        {
+            this->set_read_batch_size(gil_batch_size);
+        }
+    }
+
+  protected:
+    void on_read_batch_begin() override
+    {
+        if (m_gil_batched)
+        {
+            m_gil_batches.local().begin();
+        }
+    }
+
+    void on_read_batch_end() override
+    {
+        if (m_gil_batched)
+        {
+            m_gil_batches.local().end();
+        }
+    }
+
+  private:
+    bool m_gil_batched{false};
+    PerEngineState<GilBatchScope> m_gil_batches;
 };
 
 template <typename InputT>
@@ -320,11 +547,94 @@ class PythonNode : public node::RxNode<InputT, OutputT, ContextT>,
     using base_t = node::RxNode<InputT, OutputT>;
 
   public:
+    // holds the GIL across batches and relies on per-thread python state, never migrate between threads
+    static constexpr bool requires_thread_affinity = true;
+
     using typename base_t::stream_fn_t;
     using subscribe_fn_t = std::function<rxcpp::subscription(rxcpp::observable<InputT>, rxcpp::subscriber<OutputT>)>;
 
     using base_t::base_t;
 
+    /**
+     * @brief Read up to `gil_batch_size` items from the channel with the GIL released, then acquire the GIL once to
+     * pass all of them through the node's stream. Items emitted by the stream while the GIL is held are buffered and
+     * written downstream after it has been released, since writing may block the fiber. Errors and completion are
+     * buffered in the same way, so they are always forwarded after the items emitted before them. The default of 1
+     * acquires the GIL separately for every item. Only streams set through PythonNode::make_stream are batched.
+     */
+    void set_gil_batch_size(std::size_t gil_batch_size)
+    {
+        if (gil_batch_size == 0)
+        {
+            throw std::invalid_argument("gil_batch_size must be greater than 0");
+        }
+
+        m_gil_batched = gil_batch_size > 1;
+        if (m_gil_batched)
+        {
+            this->set_read_batch_size(gil_batch_size);
+        }
+
+        if (m_stream_fn)
+        {
+            this->make_stream(m_stream_fn);
+        }
+    }
+
+    // Hides RxNode::make_stream so that the stream's output can be buffered while a batch holds the GIL
+    void make_stream(stream_fn_t fn)
+    {
+        m_stream_fn = std::move(fn);
+
+        m_batched_stream = m_gil_batched;
+
+        if (!m_gil_batched)
+        {
+            base_t::make_stream(m_stream_fn);
+            return;
+        }
+
+        base_t::make_stream([this, stream_fn = m_stream_fn](const rxcpp::observable<InputT>& input) {
+            auto output = stream_fn(input);
+
+            return rxcpp::observable<>::create<OutputT>([this, output](rxcpp::subscriber<OutputT> sub) {
+                // Subscribed from within the progress engine, which owns this batch state for its whole lifetime
+                auto& batch  = m_gil_batches.local();
+                batch.output = sub;
+
+                output.subscribe(
+                    sub,
+                    [&batch, sub](OutputT data) {
+                        if (batch.gil.active())
+                        {
+                            batch.pending.push_back(std::move(data));
+                            return;
+                        }
+
+                        sub.on_next(std::move(data));
+                    },
+                    [&batch, sub](std::exception_ptr error) {
+                        if (batch.gil.active())
+                        {
+                            batch.pending_error = std::move(error);
+                            return;
+                        }
+
+                        sub.on_error(std::move(error));
+                    },
+                    [&batch, sub]() {
+                        if (batch.gil.active())
+                        {
+                            batch.pending_completed = true;
+                            return;
+                        }
+
+                        sub.on_completed();
+                    });
+            });
+        });
+    }
+
   protected:
     static auto op_factory_from_sub_fn(subscribe_fn_t sub_fn)
     {
@@ -337,6 +647,64 @@ class PythonNode : public node::RxNode<InputT, OutputT, ContextT>,
             });
         };
     }
+
+    void on_read_batch_begin() override
+    {
+        if (m_gil_batched && m_batched_stream)
+        {
+            m_gil_batches.local().gil.begin();
+        }
+    }
+
+    void on_read_batch_end() override
+    {
+        if (!m_gil_batched || !m_batched_stream)
+        {
+            return;
+        }
+
+        auto& batch = m_gil_batches.local();
+
+        batch.gil.end();
+
+        if (!batch.output)
+        {
+            return;
+        }
+
+        // Forward everything the stream emitted during the batch in the order it was emitted; a terminal event can
+        // only have been the last one
+        for (auto& data : batch.pending)
+        {
+            batch.output->on_next(std::move(data));
+        }
+        batch.pending.clear();
+
+        if (batch.pending_error)
+        {
+            batch.output->on_error(std::exchange(batch.pending_error, nullptr));
+        }
+        else if (std::exchange(batch.pending_completed, false))
+        {
+            batch.output->on_completed();
+        }
+    }
+
+  private:
+    // Output of one progress engine's subscription and the events emitted by its stream while a batch holds the GIL
+    struct GilBatch
+    {
+        GilBatchScope gil;
+        std::optional<rxcpp::subscriber<OutputT>> output;
+        std::vector<OutputT> pending;
+        std::exception_ptr pending_error;
+        bool pending_completed{false};
+    };
+
+    stream_fn_t m_stream_fn;
+    bool m_gil_batched{false};
+    bool m_batched_stream{false};
+    PerEngineState<GilBatch> m_gil_batches;
 };
 
 template <typename InputT, typename OutputT>
@@ -376,6 +744,9 @@ class PythonSource : public node::RxSource<OutputT, ContextT>,
     using base_t = node::RxSource<OutputT>;
 
   public:
+    // python generators are bound to the thread state which created them, never migrate between threads
+    static constexpr bool requires_thread_affinity = true;
+
     using subscriber_fn_t = std::function<void(rxcpp::subscriber<OutputT>& sub)>;
 
     using base_t::base_t;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -19,6 +19,7 @@
 
 #include "pymrc/types.hpp"
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -37,21 +38,28 @@ struct PyFuncHolder;
 class PythonOperator
 {
   public:
-    PythonOperator(std::string name, PyObjectOperateFn operate_fn);
+    PythonOperator(std::string name, PyObjectOperateFn operate_fn, std::size_t gil_batch_size = 1);
 
     const std::string& get_name() const;
 
     const PyObjectOperateFn& get_operate_fn() const;
 
+    /**
+     * @brief Number of items the node running this operator should pass through it per acquisition of the GIL.
+     */
+    std::size_t get_gil_batch_size() const;
+
   private:
     std::string m_name;
     PyObjectOperateFn m_operate_fn;
+    std::size_t m_gil_batch_size;
 };
 
 class OperatorProxy
 {
   public:
     static std::string get_name(PythonOperator& self);
+    static std::size_t get_gil_batch_size(PythonOperator& self);
 };
 
 class OperatorsProxy
@@ -60,7 +68,7 @@ class OperatorsProxy
     static PythonOperator build(PyFuncHolder<void(const PyObjectObservable& obs, PyObjectSubscriber& sub)> build_fn);
     static PythonOperator filter(PyFuncHolder<bool(pybind11::object x)> filter_fn);
     static PythonOperator flatten();
-    static PythonOperator map(OnDataFunction map_fn);
+    static PythonOperator map(OnDataFunction map_fn, std::size_t gil_batch_size = 1);
     static PythonOperator on_completed(PyFuncHolder<std::optional<pybind11::object>()> finally_fn);
     static PythonOperator pairwise();
     static PythonOperator to_list();
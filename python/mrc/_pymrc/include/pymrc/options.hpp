@@ -65,6 +65,10 @@ class EngineFactoryOptionsProxy
     static bool get_allow_overlap(mrc::EngineFactoryOptions& self);
 
     static void set_allow_overlap(mrc::EngineFactoryOptions& self, bool allow_overlap);
+
+    static bool get_work_sharing(mrc::EngineFactoryOptions& self);
+
+    static void set_work_sharing(mrc::EngineFactoryOptions& self, bool work_sharing);
 };
 
 class OptionsProxy
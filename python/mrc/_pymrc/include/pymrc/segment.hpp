@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -168,6 +168,7 @@ class BuilderProxy
      * (py) @param on_next: python/std function that will be called on a new data element.
      * (py) @param on_error: python/std function that will be called if an error occurs.
      * (py) @param on_completed: python/std function that will be called
+     * (py) @param gil_batch_size: maximum number of items passed to on_next per acquisition of the GIL
      *  Python example.
      *  ```python
      *      def my_on_next(x):
@@ -184,7 +185,8 @@ class BuilderProxy
                                                                      const std::string& name,
                                                                      OnNextFunction on_next,
                                                                      OnErrorFunction on_error,
-                                                                     OnCompleteFunction on_completed);
+                                                                     OnCompleteFunction on_completed,
+                                                                     std::size_t gil_batch_size = 1);
 
     static std::shared_ptr<mrc::segment::ObjectProperties> make_sink_component(mrc::segment::IBuilder& self,
                                                                                const std::string& name,
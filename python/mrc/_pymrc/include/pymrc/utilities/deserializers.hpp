@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -38,6 +38,15 @@ struct Deserializer
     static pybind11::object deserialize(pybind11::buffer_info& buffer_info);
     static pybind11::object deserialize(const char* bytes, std::size_t count);
 
+    /**
+     * @brief Rebuild an object pickled by Serializer::serialize_out_of_band. The objects in `buffers` are handed to
+     * pickle as-is, so anything rebuilt from them shares their memory rather than copying it.
+     * @param header
+     * @param buffers
+     * @return
+     */
+    static pybind11::object deserialize_out_of_band(pybind11::bytes header, pybind11::list buffers);
+
     /**
      * @brief Given a pyMRC shmem descriptor, attempt to retrieve the object information from shared memory
      * and unpickle it.
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,26 +17,81 @@
 
 #pragma once
 
-#include "pymrc/types.hpp"
-
 #include <pybind11/pytypes.h>
 
+#include <atomic>
 #include <cstddef>
+#include <deque>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace mrc::pymrc {
 
 #pragma GCC visibility push(default)
 /**
  * @brief Cache python objects in a way that allows them to be freed correctly before the interpreter shuts down.
+ *
+ * Lookups read an immutable snapshot of the cache and never take a lock. Inserts and overwrites are serialized, copy
+ * the current snapshot and publish the copy. Cached objects are never modified or moved once published, an overwrite
+ * stores the new object in a new entry, so a snapshot or InternedObject taken earlier can always be read safely.
  **/
 class __attribute__((visibility("default"))) PythonObjectCache
 {
   public:
+    /**
+     * @brief Non-owning handle to a cache entry. Resolve it once, for example when a node is built, and read through
+     * it afterwards without looking the entry up again. Valid until the cache is cleared at interpreter shutdown. A
+     * handle keeps the object it was resolved to, even if the entry is later overwritten with cache_object.
+     */
+    class InternedObject
+    {
+      public:
+        const pybind11::object& operator*() const
+        {
+            return *m_object;
+        }
+
+        const pybind11::object* operator->() const
+        {
+            return m_object;
+        }
+
+      private:
+        explicit InternedObject(const pybind11::object* object) : m_object(object) {}
+
+        const pybind11::object* m_object;
+
+        friend PythonObjectCache;
+    };
+
+    /**
+     * @brief Interned entry which is resolved once per interpreter rather than every time it is used. Meant to be
+     * declared `static`, get() only looks the entry up on first use and again after the interpreter has been
+     * re-initialized, which replaces the cache.
+     */
+    class StaticInternedObject
+    {
+      public:
+        StaticInternedObject(std::string object_id, std::function<pybind11::object()> loader);
+
+        InternedObject get();
+
+      private:
+        struct Resolved
+        {
+            const PythonObjectCache* cache;
+            InternedObject object;
+        };
+
+        const std::string m_object_id;
+        const std::function<pybind11::object()> m_loader;
+        std::atomic<const Resolved*> m_resolved{nullptr};
+    };
+
     /**
      * @brief Get singleton handle
      * @return Reference to singleton PythonObjectCache
@@ -80,24 +135,60 @@ class __attribute__((visibility("default"))) PythonObjectCache
      */
     pybind11::object& get_module(const std::string& module_name);
 
+    /**
+     * @brief Same as get_or_load, but returns a handle to the entry rather than a new reference to the object.
+     */
+    InternedObject intern(const std::string& object_id, std::function<pybind11::object()> loader);
+
+    /**
+     * @brief Same as get_module, but returns a handle to the entry rather than a reference to the object.
+     */
+    InternedObject intern_module(const std::string& module_name);
+
     /**
      * @brief Add an arbitrary python object to the cache. If an entry with the same name exists it will be
-     * overwritten.
+     * overwritten; handles resolved before the overwrite keep the previous object.
      */
     void cache_object(const std::string& object_id, pybind11::object& obj);
 
   private:
+    using snapshot_t = std::unordered_map<std::string, pybind11::object*>;
+
+    // Guards creation of the singleton and all writes to the cache, readers never take it
     static std::mutex s_cache_lock;
-    static std::unique_ptr<PythonObjectCache> s_py_object_cache;
+    static std::atomic<PythonObjectCache*> s_py_object_cache;
 
     PythonObjectCache();
 
+    /**
+     * @brief Lock-free lookup in the current snapshot, returns nullptr if 'object_id' is not cached.
+     */
+    pybind11::object* find(const std::string& object_id) const;
+
+    /**
+     * @brief Returns the entry for 'object_id', calling 'loader' without holding s_cache_lock if it has to be added.
+     */
+    pybind11::object* find_or_insert(const std::string& object_id, const std::function<pybind11::object()>& loader);
+
+    /**
+     * @brief Stores obj in a new entry and publishes a new snapshot mapping 'object_id' to it, replacing any existing
+     * mapping. s_cache_lock must be held.
+     */
+    pybind11::object* insert(const std::string& object_id, pybind11::object obj);
+
     /**
      * @brief Actions taken to clear the cache prior to interpreter shutdown.
      */
     void atexit_callback();
 
-    python_map_t m_object_cache;
+    // Stable storage for the cached objects, entries are never erased or overwritten so snapshots can hold plain
+    // pointers
+    std::deque<pybind11::object> m_objects;
+
+    // Every published snapshot is kept until the cache is cleared, a reader may still hold an older one. The cache
+    // holds tens of entries which are added once, so this stays small.
+    std::vector<std::unique_ptr<const snapshot_t>> m_snapshots;
+    std::atomic<const snapshot_t*> m_snapshot{nullptr};
 };
 
 #pragma GCC visibility pop
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,17 +17,54 @@
 
 #pragma once
 
+#include "mrc/memory/buffer_view.hpp"
+
 #include <pybind11/pytypes.h>
 
 #include <cstddef>
 #include <tuple>
+#include <vector>
 
 namespace mrc::pymrc {
 #pragma GCC visibility push(default)
 
+/**
+ * @brief An object pickled with protocol 5. Buffers of at least the requested size are not copied into `header`, they
+ * are described by `buffers` and remain views into the memory exported by `exporters`.
+ *
+ * The views are valid for as long as this object is alive, `pickle_buffers` holds the buffer exports which keep the
+ * underlying memory from being resized or released. An exporter may be a temporary created while reducing the object,
+ * e.g. by a `__reduce_ex__` returning a `PickleBuffer` of a new bytearray, so once this object is released a view is
+ * only valid if buffers_owned_by reports the buffer as owned by an object which is still alive.
+ */
+struct OutOfBandPickle
+{
+    pybind11::bytes header;
+    std::vector<memory::const_buffer_view> buffers;
+    std::vector<pybind11::object> pickle_buffers;
+    std::vector<pybind11::object> exporters;
+
+    memory::const_buffer_view header_view() const;
+
+    /**
+     * @brief For each of `buffers`, whether its exporter can be reached from `owner` by following references, in which
+     * case the view stays valid for as long as `owner` is alive and unmodified. References from types, modules and
+     * functions are not followed, buffers only reachable through them are reported as not owned.
+     */
+    std::vector<bool> buffers_owned_by(pybind11::handle owner) const;
+};
+
 struct Serializer
 {
+    // Buffers smaller than this are cheaper to copy into the pickle stream than to track separately
+    static constexpr std::size_t DefaultMinOutOfBandBytes = 64 * 1024;
+
     /**
+     * @brief Pickle `obj` into a buffer allocated with malloc and owned by the caller.
+     *
+     * The result is kept a self-contained pickle stream, as read by Deserializer::deserialize and by `pickle.loads`, so
+     * buffers held by `obj` are copied in-band by pickle and copied once more into the returned memory. Use
+     * serialize_out_of_band, or `use_shmem`, for objects holding large buffers.
      *
      * @param obj pybind11 object to serialize
      * @param use_shmem flag indicating whether or not we should put the serialized object into shared memory.
@@ -36,6 +73,18 @@ struct Serializer
     static std::tuple<char*, std::size_t> serialize(pybind11::object obj,
                                                     bool use_shmem         = false,
                                                     bool return_raw_buffer = false);
+
+    /**
+     * @brief Pickle `obj` with protocol 5, passing buffers of at least `min_out_of_band_bytes` out-of-band rather
+     * than copying them. Rebuild the object with Deserializer::deserialize_out_of_band.
+     */
+    static OutOfBandPickle serialize_out_of_band(pybind11::object obj,
+                                                 std::size_t min_out_of_band_bytes = DefaultMinOutOfBandBytes);
+
+    /**
+     * @brief Write `obj` to a new shared memory block and return a descriptor for it. Out-of-band buffers are copied
+     * directly into the block following the pickle header.
+     */
     static pybind11::object persist_to_shared_memory(pybind11::object obj);
 };
 #pragma GCC visibility pop
@@ -27,6 +27,16 @@
 #include <string>
 #include <typeinfo>
 
+/**
+ * @brief Declares a pybind11 module. When built against a free-threaded (PEP 703) interpreter the module is marked as
+ * not relying on the GIL, otherwise importing it would cause the interpreter to re-enable the GIL for the process.
+ */
+#if defined(Py_GIL_DISABLED) && PYBIND11_VERSION_HEX >= 0x020D0000
+    #define PYMRC_MODULE(name, variable) PYBIND11_MODULE(name, variable, pybind11::mod_gil_not_used())
+#else
+    #define PYMRC_MODULE(name, variable) PYBIND11_MODULE(name, variable)
+#endif
+
 namespace mrc::pymrc {
 
 // Export everything in the mrc::pymrc namespace by default since we compile with -fvisibility=hidden
@@ -82,6 +92,13 @@ std::string get_py_type_name(const pybind11::object& obj);
 
 void show_deprecation_warning(const std::string& deprecation_message, ssize_t stack_level = 1);
 
+/**
+ * @brief Returns true if the running interpreter is using the GIL. Always true prior to Python 3.13, on free-threaded
+ * builds this is false unless the GIL was re-enabled, either by PYTHON_GIL=1 or by importing an extension module which
+ * does not declare support for running without it. Requires the GIL (or an attached thread state) to be held.
+ */
+bool is_gil_enabled();
+
 #pragma GCC visibility pop
 
 }  // namespace mrc::pymrc
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,6 +18,7 @@
 #include "pymrc/executor.hpp"  // IWYU pragma: associated
 
 #include "pymrc/pipeline.hpp"
+#include "pymrc/utils.hpp"
 
 #include "mrc/pipeline/executor.hpp"
 #include "mrc/pipeline/pipeline.hpp"  // IWYU pragma: keep
@@ -51,6 +52,16 @@ namespace mrc::pymrc {
 
 namespace py = pybind11;
 
+static bool python_is_finalizing()
+{
+    // The private _Py_IsFinalizing() was removed in 3.13 in favor of the public Py_IsFinalizing()
+#if PY_VERSION_HEX >= 0x030D0000
+    return Py_IsFinalizing() != 0;
+#else
+    return _Py_IsFinalizing() != 0;
+#endif
+}
+
 std::function<void()> create_gil_initializer()
 {
     bool has_pydevd_trace = false;
@@ -112,7 +123,7 @@ std::function<void()> create_gil_initializer()
 
 std::function<void()> create_gil_finalizer()
 {
-    bool python_finalizing = _Py_IsFinalizing() != 0;
+    bool python_finalizing = python_is_finalizing();
 
     if (python_finalizing)
     {
@@ -122,7 +133,7 @@ std::function<void()> create_gil_finalizer()
 
     // Ensure we dont have the GIL here otherwise this deadlocks.
     return [] {
-        bool python_finalizing = _Py_IsFinalizing() != 0;
+        bool python_finalizing = python_is_finalizing();
 
         if (python_finalizing)
         {
@@ -228,6 +239,20 @@ Executor::Executor(std::shared_ptr<Options> options)
     system->add_thread_initializer(create_gil_initializer());
     system->add_thread_finalizer(create_gil_finalizer());
 
+#ifdef Py_GIL_DISABLED
+    // Python nodes on separate threads only execute in parallel if the GIL is still disabled at this point. Importing
+    // an extension module which does not declare free-threading support silently re-enables it.
+    if (is_gil_enabled())
+    {
+        LOG(WARNING) << "MRC was built for a free-threaded Python, however the GIL has been re-enabled (PYTHON_GIL=1 "
+                        "or an imported extension module requires it). Python nodes will be serialized by the GIL.";
+    }
+    else
+    {
+        VLOG(10) << "Running without the GIL. Python nodes on separate threads will execute in parallel.";
+    }
+#endif
+
     // Must release the GIL while we create the executor
     pybind11::gil_scoped_release nogil;
 
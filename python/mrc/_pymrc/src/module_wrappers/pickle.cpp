@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -28,27 +28,41 @@
 #include <ostream>
 
 namespace py = pybind11;
+using namespace pybind11::literals;
+
 namespace mrc::pymrc {
 
 PythonPickleInterface::~PythonPickleInterface() = default;
 
-PythonPickleInterface::PythonPickleInterface() : m_pycache(PythonObjectCache::get_handle())
-{
-    auto mod = m_pycache.get_module("pickle");
+namespace {
 
-    m_func_loads = m_pycache.get_or_load("PythonPickleInterface.loads", [mod]() {
-        return mod.attr("loads");
+PythonObjectCache::StaticInternedObject& pickle_loads()
+{
+    static PythonObjectCache::StaticInternedObject loads("PythonPickleInterface.loads", []() {
+        return PythonObjectCache::get_handle().get_module("pickle").attr("loads");
     });
-    m_func_dumps = m_pycache.get_or_load("PythonPickleInterface.dumps", [mod]() {
-        return mod.attr("dumps");
+    return loads;
+}
+
+PythonObjectCache::StaticInternedObject& pickle_dumps()
+{
+    static PythonObjectCache::StaticInternedObject dumps("PythonPickleInterface.dumps", []() {
+        return PythonObjectCache::get_handle().get_module("pickle").attr("dumps");
     });
+    return dumps;
 }
 
+}  // namespace
+
+// Constructed for every message which is serialized, the functions are only looked up once per interpreter
+PythonPickleInterface::PythonPickleInterface() : m_func_loads(pickle_loads().get()), m_func_dumps(pickle_dumps().get())
+{}
+
 pybind11::bytes PythonPickleInterface::pickle(pybind11::object obj)
 {
     try
     {
-        return m_func_dumps(obj);
+        return (*m_func_dumps)(obj);
     } catch (pybind11::error_already_set err)
     {
         LOG(ERROR) << "Object serialization failed: " << err.what();
@@ -60,7 +74,31 @@ pybind11::object PythonPickleInterface::unpickle(pybind11::bytes bytes)
 {
     try
     {
-        return m_func_loads(bytes);
+        return (*m_func_loads)(bytes);
+    } catch (pybind11::error_already_set err)
+    {
+        LOG(ERROR) << "Object deserialization failed: " << err.what();
+        throw;
+    }
+}
+
+pybind11::bytes PythonPickleInterface::pickle(pybind11::object obj, pybind11::function buffer_callback)
+{
+    try
+    {
+        return (*m_func_dumps)(obj, "protocol"_a = 5, "buffer_callback"_a = buffer_callback);
+    } catch (pybind11::error_already_set err)
+    {
+        LOG(ERROR) << "Object serialization failed: " << err.what();
+        throw;
+    }
+}
+
+pybind11::object PythonPickleInterface::unpickle(pybind11::bytes bytes, pybind11::list buffers)
+{
+    try
+    {
+        return (*m_func_loads)(bytes, "buffers"_a = buffers);
     } catch (pybind11::error_already_set err)
     {
         LOG(ERROR) << "Object deserialization failed: " << err.what();
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -33,22 +33,28 @@ namespace py = pybind11;
 namespace mrc::pymrc {
 PythonSharedMemoryInterface::~PythonSharedMemoryInterface() = default;
 
-PythonSharedMemoryInterface::PythonSharedMemoryInterface() : m_pycache(PythonObjectCache::get_handle())
+namespace {
+
+PythonObjectCache::StaticInternedObject& shared_memory_class()
 {
-    auto mod          = m_pycache.get_module("multiprocessing.shared_memory");
-    m_shmem_interface = py::cast<py::object>(m_pycache.get_or_load("PythonSharedMemoryInterface.SharedMemory", [mod]() {
-        return mod.attr("SharedMemory");
-    }));
+    static PythonObjectCache::StaticInternedObject shared_memory("PythonSharedMemoryInterface.SharedMemory", []() {
+        return PythonObjectCache::get_handle().get_module("multiprocessing.shared_memory").attr("SharedMemory");
+    });
+    return shared_memory;
 }
 
+}  // namespace
+
+PythonSharedMemoryInterface::PythonSharedMemoryInterface() : m_shmem_interface(shared_memory_class().get()) {}
+
 void PythonSharedMemoryInterface::allocate(std::size_t sz_bytes)
 {
-    m_shmem = m_shmem_interface(py::none(), true, sz_bytes);
+    m_shmem = (*m_shmem_interface)(py::none(), true, sz_bytes);
 }
 
 void PythonSharedMemoryInterface::attach(py::object block_id)
 {
-    m_shmem = m_shmem_interface(block_id, false);
+    m_shmem = (*m_shmem_interface)(block_id, false);
 }
 
 void PythonSharedMemoryInterface::close()
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -30,6 +30,7 @@
 #include <rxcpp/rx.hpp>
 
 #include <exception>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -41,10 +42,16 @@ namespace mrc::pymrc {
 
 namespace py = pybind11;
 
-PythonOperator::PythonOperator(std::string name, PyObjectOperateFn operate_fn) :
+PythonOperator::PythonOperator(std::string name, PyObjectOperateFn operate_fn, std::size_t gil_batch_size) :
   m_name(std::move(name)),
-  m_operate_fn(std::move(operate_fn))
-{}
+  m_operate_fn(std::move(operate_fn)),
+  m_gil_batch_size(gil_batch_size)
+{
+    if (m_gil_batch_size == 0)
+    {
+        throw std::invalid_argument("gil_batch_size must be greater than 0");
+    }
+}
 const std::string& PythonOperator::get_name() const
 {
     return m_name;
@@ -53,12 +60,21 @@ const PyObjectOperateFn& PythonOperator::get_operate_fn() const
 {
     return m_operate_fn;
 }
+std::size_t PythonOperator::get_gil_batch_size() const
+{
+    return m_gil_batch_size;
+}
 
 std::string OperatorProxy::get_name(PythonOperator& self)
 {
     return self.get_name();
 }
 
+std::size_t OperatorProxy::get_gil_batch_size(PythonOperator& self)
+{
+    return self.get_gil_batch_size();
+}
+
 PythonOperator OperatorsProxy::build(PyFuncHolder<void(const PyObjectObservable& obs, PyObjectSubscriber& sub)> build_fn)
 {
     //  Build and return the map operator
@@ -169,17 +185,19 @@ PythonOperator OperatorsProxy::flatten()
             }};
 }
 
-PythonOperator OperatorsProxy::map(OnDataFunction map_fn)
+PythonOperator OperatorsProxy::map(OnDataFunction map_fn, std::size_t gil_batch_size)
 {
-    // Build and return the map operator
-    return {"map", [=](PyObjectObservable source) -> PyObjectObservable {
+    // Build and return the map operator. When the node batches items under the GIL this acquisition is a no-op
+    return {"map",
+            [=](PyObjectObservable source) -> PyObjectObservable {
                 return source.map([=](PyHolder data_object) -> PyHolder {
                     py::gil_scoped_acquire gil;
 
                     // Call the map function
                     return map_fn(std::move(data_object));
                 });
-            }};
+            },
+            gil_batch_size};
 }
 
 PythonOperator OperatorsProxy::on_completed(PyFuncHolder<std::optional<pybind11::object>()> finally_fn)
@@ -83,6 +83,16 @@ void EngineFactoryOptionsProxy::set_allow_overlap(mrc::EngineFactoryOptions& sel
     self.allow_overlap = allow_overlap;
 }
 
+bool EngineFactoryOptionsProxy::get_work_sharing(mrc::EngineFactoryOptions& self)
+{
+    return self.work_sharing;
+}
+
+void EngineFactoryOptionsProxy::set_work_sharing(mrc::EngineFactoryOptions& self, bool work_sharing)
+{
+    self.work_sharing = work_sharing;
+}
+
 std::string OptionsProxy::get_user_cpuset(mrc::TopologyOptions& self)
 {
     // Convert the CPU set to a string
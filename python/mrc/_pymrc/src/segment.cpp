@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -38,6 +38,8 @@
 #include <pybind11/pytypes.h>
 #include <rxcpp/rx.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -328,9 +330,20 @@ std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_sink(mrc::seg
                                                                         const std::string& name,
                                                                         OnNextFunction on_next,
                                                                         OnErrorFunction on_error,
-                                                                        OnCompleteFunction on_completed)
+                                                                        OnCompleteFunction on_completed,
+                                                                        std::size_t gil_batch_size)
 {
-    return self.make_sink<PyHolder, PythonSink>(name, on_next, on_error, on_completed);
+    // Checked before the sink is added to the segment so an invalid argument does not leave a partial sink behind
+    if (gil_batch_size == 0)
+    {
+        throw std::invalid_argument("gil_batch_size must be greater than 0");
+    }
+
+    auto sink = self.make_sink<PyHolder, PythonSink>(name, on_next, on_error, on_completed);
+
+    sink->object().set_gil_batch_size(gil_batch_size);
+
+    return sink;
 }
 
 std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_sink_component(mrc::segment::IBuilder& self,
@@ -387,6 +400,17 @@ std::shared_ptr<mrc::segment::ObjectProperties> BuilderProxy::make_node(mrc::seg
 {
     auto node = self.make_node<PyHolder, PyHolder, PythonNode>(name);
 
+    // The node batches items under the GIL if any of its operators asked for it
+    std::size_t gil_batch_size = 1;
+    for (const auto& op : operators)
+    {
+        if (py::isinstance<PythonOperator>(op))
+        {
+            gil_batch_size = std::max(gil_batch_size, op.cast<const PythonOperator&>().get_gil_batch_size());
+        }
+    }
+    node->object().set_gil_batch_size(gil_batch_size);
+
     node->object().make_stream(
         [operators = PyObjectHolder(std::move(operators))](const PyObjectObservable& input) -> PyObjectObservable {
             AcquireGIL gil;
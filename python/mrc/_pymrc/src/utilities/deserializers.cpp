@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -61,6 +61,28 @@ pybind11::object Deserializer::deserialize(pybind11::bytes py_bytes)
     }
 }
 
+pybind11::object Deserializer::deserialize_out_of_band(pybind11::bytes header, pybind11::list buffers)
+{
+    VLOG(8) << "Deserializing from pickle header with " << buffers.size() << " out-of-band buffers";
+    pybind11::object obj;
+    try
+    {
+        auto pkl = PythonPickleInterface();
+        obj      = pkl.unpickle(header, buffers);
+    } catch (pybind11::error_already_set err)
+    {
+        LOG(ERROR) << "Failed to deserialize bytes into python object: " << err.what();
+        throw;
+    }
+
+    if (pybind11::hasattr(obj, "__shared_memory_descriptor__"))
+    {
+        obj = load_from_shared_memory(obj);
+    }
+
+    return obj;
+}
+
 pybind11::object Deserializer::deserialize(pybind11::buffer_info& buffer_info)
 {
     VLOG(8) << "Deserializing from py_buffer_info";
@@ -77,7 +99,26 @@ pybind11::object Deserializer::load_from_shared_memory(pybind11::object descript
     pybind11::object obj;
 
     shmem.attach(descriptor.attr("block_id"));
-    obj = pkl.unpickle(shmem.get_bytes());
+    {
+        // Copy each region out of the block exactly once, the rebuilt object must not reference the block as it is
+        // closed (and possibly unlinked) below.
+        auto block_info = pybind11::buffer(shmem.get_memoryview()).request();
+        const auto* src = static_cast<const char*>(block_info.ptr);
+
+        auto header_bytes = pybind11::cast<std::size_t>(descriptor.attr("header_bytes"));
+        pybind11::bytes header(src, header_bytes);
+        src += header_bytes;
+
+        pybind11::list buffers;
+        for (const auto& size : descriptor.attr("buffer_bytes"))
+        {
+            auto bytes = pybind11::cast<std::size_t>(size);
+            buffers.append(pybind11::bytearray(src, bytes));
+            src += bytes;
+        }
+
+        obj = pkl.unpickle(header, buffers);
+    }
 
     shmem.close();
     if (!is_shared)
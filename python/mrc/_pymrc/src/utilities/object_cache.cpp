@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -24,30 +24,39 @@
 #include <pybind11/pytypes.h>
 #include <pylifecycle.h>
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace py = pybind11;
 namespace mrc::pymrc {
 
-std::unique_ptr<PythonObjectCache> PythonObjectCache::s_py_object_cache{nullptr};
+std::atomic<PythonObjectCache*> PythonObjectCache::s_py_object_cache{nullptr};
 std::mutex PythonObjectCache::s_cache_lock{};
 
 PythonObjectCache& PythonObjectCache::get_handle()
 {
-    if (!PythonObjectCache::s_py_object_cache)
+    // Without a GIL (free-threaded builds) several threads can race to create the cache, so the pointer has to be
+    // published with release semantics
+    auto* cache = s_py_object_cache.load(std::memory_order_acquire);
+
+    if (cache == nullptr)
     {
         std::lock_guard<std::mutex> lock(s_cache_lock);
-        if (!PythonObjectCache::s_py_object_cache)
+
+        cache = s_py_object_cache.load(std::memory_order_relaxed);
+        if (cache == nullptr)
         {
-            PythonObjectCache::s_py_object_cache = std::move(
-                std::unique_ptr<PythonObjectCache>(new PythonObjectCache()));
+            cache = new PythonObjectCache();
+            s_py_object_cache.store(cache, std::memory_order_release);
         }
     }
 
-    return *s_py_object_cache;
+    return *cache;
 }
 
 PythonObjectCache::PythonObjectCache()
@@ -59,6 +68,9 @@ PythonObjectCache::PythonObjectCache()
         throw std::runtime_error(err);
     }
 
+    m_snapshots.push_back(std::make_unique<const snapshot_t>());
+    m_snapshot.store(m_snapshots.back().get(), std::memory_order_release);
+
     auto at_exit = pybind11::module_::import("atexit");
     at_exit.attr("register")(pybind11::cpp_function([this]() {
         this->atexit_callback();
@@ -67,65 +79,153 @@ PythonObjectCache::PythonObjectCache()
 
 bool PythonObjectCache::contains(const std::string& object_id)
 {
-    return (m_object_cache.find(object_id) != m_object_cache.end());
+    return find(object_id) != nullptr;
 }
 
 std::size_t PythonObjectCache::size()
 {
-    return m_object_cache.size();
+    return m_snapshot.load(std::memory_order_acquire)->size();
 }
 
 pybind11::object PythonObjectCache::get_or_load(const std::string& object_id, std::function<pybind11::object()> loader)
 {
-    std::lock_guard<std::mutex> lock(s_cache_lock);
+    return *intern(object_id, std::move(loader));
+}
 
-    auto iter = m_object_cache.find(object_id);
-    if (iter != m_object_cache.end())
+pybind11::object& PythonObjectCache::get_module(const std::string& module_name)
+{
+    auto* obj = find(module_name);
+    if (obj != nullptr)
     {
-        return iter->second;
+        return *obj;
+    }
+
+    return *find_or_insert(module_name, [&module_name]() {
+        VLOG(8) << "Caching module: " << module_name;
+        return pybind11::module_::import(module_name.c_str());
+    });
+}
+
+PythonObjectCache::InternedObject PythonObjectCache::intern(const std::string& object_id,
+                                                            std::function<pybind11::object()> loader)
+{
+    auto* obj = find(object_id);
+    if (obj != nullptr)
+    {
+        return InternedObject(obj);
     }
 
-    VLOG(1) << "Caching loader object: " << object_id;
-    m_object_cache[object_id] = loader();  // Load the object, then drop iter to a handle.
-    VLOG(1) << "Done caching loader object: " << object_id;
+    return InternedObject(find_or_insert(object_id, [&object_id, &loader]() {
+        VLOG(1) << "Caching loader object: " << object_id;
+        return loader();
+    }));
+}
 
-    return m_object_cache[object_id];
+PythonObjectCache::InternedObject PythonObjectCache::intern_module(const std::string& module_name)
+{
+    return InternedObject(&get_module(module_name));
 }
 
-pybind11::object& PythonObjectCache::get_module(const std::string& module_name)
+void PythonObjectCache::cache_object(const std::string& object_id, pybind11::object& obj)
 {
+    VLOG(8) << "Caching object: " << object_id;
     std::lock_guard<std::mutex> lock(s_cache_lock);
 
-    auto iter = m_object_cache.find(module_name);
-    if (iter != m_object_cache.end())
+    // Readers may be copying the current object without any lock, so an existing entry is never written to. The new
+    // object gets its own entry and the snapshot published by insert maps 'object_id' to it
+    insert(object_id, obj);
+}
+
+pybind11::object* PythonObjectCache::find(const std::string& object_id) const
+{
+    const auto* snapshot = m_snapshot.load(std::memory_order_acquire);
+
+    auto iter = snapshot->find(object_id);
+    if (iter != snapshot->end())
     {
         return iter->second;
     }
 
-    VLOG(8) << "Caching module: " << module_name;
-    m_object_cache[module_name] = pybind11::module_::import(module_name.c_str());
-    VLOG(8) << "Done caching module: " << module_name;
-    return m_object_cache[module_name];
+    return nullptr;
 }
 
-void PythonObjectCache::cache_object(const std::string& object_id, pybind11::object& obj)
+pybind11::object* PythonObjectCache::find_or_insert(const std::string& object_id,
+                                                    const std::function<pybind11::object()>& loader)
 {
-    VLOG(8) << "Caching object: " << object_id;
-    m_object_cache[object_id] = obj;
+    // Load outside of the lock, loaders may import modules which can release the GIL part way through
+    auto obj = loader();
+
+    std::lock_guard<std::mutex> lock(s_cache_lock);
+
+    // Another thread may have added the entry while we were loading, first one in wins
+    auto* existing = find(object_id);
+    if (existing != nullptr)
+    {
+        return existing;
+    }
+
+    return insert(object_id, std::move(obj));
+}
+
+pybind11::object* PythonObjectCache::insert(const std::string& object_id, pybind11::object obj)
+{
+    auto* entry = &m_objects.emplace_back(std::move(obj));
+
+    auto snapshot = std::make_unique<snapshot_t>(*m_snapshot.load(std::memory_order_relaxed));
+    (*snapshot)[object_id] = entry;
+
+    m_snapshot.store(snapshot.get(), std::memory_order_release);
+    m_snapshots.push_back(std::move(snapshot));
+
+    VLOG(1) << "Done caching object: " << object_id;
+
+    return entry;
+}
+
+PythonObjectCache::StaticInternedObject::StaticInternedObject(std::string object_id,
+                                                             std::function<pybind11::object()> loader) :
+  m_object_id(std::move(object_id)),
+  m_loader(std::move(loader))
+{}
+
+PythonObjectCache::InternedObject PythonObjectCache::StaticInternedObject::get()
+{
+    auto& cache = PythonObjectCache::get_handle();
+
+    const auto* resolved = m_resolved.load(std::memory_order_acquire);
+    if (resolved != nullptr && resolved->cache == &cache)
+    {
+        return resolved->object;
+    }
+
+    // Intentionally leaked, like the cache it was resolved from. This only happens once per interpreter, and a handle
+    // copied out of an older resolution may still be in use. Racing threads both resolve the same entry, either result
+    // is correct
+    resolved = new Resolved{&cache, cache.intern(m_object_id, m_loader)};
+    m_resolved.store(resolved, std::memory_order_release);
+
+    return resolved->object;
 }
 
 void PythonObjectCache::atexit_callback()
 {
     py::gil_scoped_acquire gil;
 
-    for (auto iter : m_object_cache)
+    for (const auto& [object_id, obj] : *m_snapshot.load(std::memory_order_acquire))
+    {
+        VLOG(1) << "Dropping reference to cached object: '" << object_id << "' currently has " << obj->ref_count()
+                << " remaining references";
+    }
+
+    // Release the references but keep the storage, any handle still held now sees an empty object rather than
+    // dangling
+    for (auto& obj : m_objects)
     {
-        VLOG(1) << "Dropping reference to cached object: '" << iter.first << "' currently has "
-                << iter.second.ref_count() << " remaining references";
+        obj = pybind11::object();
     }
 
-    m_object_cache.clear();
-    s_py_object_cache.release();
+    // Intentionally leaked, handles may still point at the storage
+    s_py_object_cache.store(nullptr, std::memory_order_release);
 }
 
 }  // namespace mrc::pymrc
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -20,33 +20,156 @@
 #include "pymrc/module_wrappers/pickle.hpp"
 #include "pymrc/module_wrappers/shared_memory.hpp"
 
-#include <bytesobject.h>
+#include "mrc/memory/memory_kind.hpp"
+
+#include <Python.h>
 #include <glog/logging.h>
+#include <pybind11/buffer_info.h>
 #include <pybind11/cast.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace py = pybind11;
 namespace mrc::pymrc {
 
+memory::const_buffer_view OutOfBandPickle::header_view() const
+{
+    return {PyBytes_AS_STRING(header.ptr()),
+            static_cast<std::size_t>(PyBytes_GET_SIZE(header.ptr())),
+            memory::memory_kind::host};
+}
+
+std::vector<bool> OutOfBandPickle::buffers_owned_by(pybind11::handle owner) const
+{
+    std::vector<bool> owned(exporters.size(), false);
+    auto remaining = std::count_if(exporters.begin(), exporters.end(), [](const py::object& exporter) {
+        return static_cast<bool>(exporter);
+    });
+
+    // Breadth first, so exporters close to the owner are found without walking the rest of its references. Objects
+    // are borrowed, which is safe since no Python code runs while the GIL is held here
+    std::unordered_set<PyObject*> visited;
+    std::deque<PyObject*> pending{owner.ptr()};
+
+    while (remaining > 0 && !pending.empty())
+    {
+        PyObject* obj = pending.front();
+        pending.pop_front();
+
+        if (!visited.insert(obj).second)
+        {
+            continue;
+        }
+
+        for (std::size_t i = 0; i < exporters.size(); ++i)
+        {
+            if (!owned[i] && exporters[i].ptr() == obj)
+            {
+                owned[i] = true;
+                --remaining;
+            }
+        }
+
+        // Types, modules and functions lead to module globals and from there to most of the interpreter
+        if (PyType_Check(obj) || PyModule_Check(obj) || PyFunction_Check(obj) || !PyObject_IS_GC(obj) ||
+            Py_TYPE(obj)->tp_traverse == nullptr)
+        {
+            continue;
+        }
+
+        Py_TYPE(obj)->tp_traverse(
+            obj,
+            [](PyObject* referent, void* arg) {
+                static_cast<std::deque<PyObject*>*>(arg)->push_back(referent);
+                return 0;
+            },
+            &pending);
+    }
+
+    return owned;
+}
+
+OutOfBandPickle Serializer::serialize_out_of_band(pybind11::object obj, std::size_t min_out_of_band_bytes)
+{
+    auto pkl = PythonPickleInterface();
+    OutOfBandPickle pickled;
+
+    // Returning true from the callback tells pickle to copy the buffer in-band
+    auto buffer_callback = py::cpp_function([&pickled, min_out_of_band_bytes](py::object pickle_buffer) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(pickle_buffer.ptr(), &view, PyBUF_ANY_CONTIGUOUS) != 0)
+        {
+            // Non-contiguous buffers cannot be described by a single view, let pickle decide what to do with them
+            PyErr_Clear();
+            return true;
+        }
+
+        auto bytes = static_cast<std::size_t>(view.len);
+        if (bytes < min_out_of_band_bytes)
+        {
+            PyBuffer_Release(&view);
+            return true;
+        }
+
+        // The PickleBuffer holds its own export of the underlying memory, so the pointer outlives our view
+        pickled.buffers.emplace_back(view.buf, bytes, memory::memory_kind::host);
+        pickled.pickle_buffers.push_back(std::move(pickle_buffer));
+        pickled.exporters.push_back(py::reinterpret_borrow<py::object>(view.obj));
+        PyBuffer_Release(&view);
+        return false;
+    });
+
+    pickled.header = pkl.pickle(std::move(obj), buffer_callback);
+
+    return pickled;
+}
+
 pybind11::object Serializer::persist_to_shared_memory(pybind11::object obj)
 {
     VLOG(8) << "Persisting object to shared memory: " << py::cast<std::string>(repr(obj));
-    auto pkl   = PythonPickleInterface();
-    auto shmem = PythonSharedMemoryInterface();
-    auto bytes = pkl.pickle(obj);
+    auto shmem   = PythonSharedMemoryInterface();
+    auto pickled = serialize_out_of_band(obj);
+
+    // The block holds the pickle header followed by each out-of-band buffer, so large buffers are copied exactly once
+    auto header       = pickled.header_view();
+    std::size_t total = header.bytes();
+    py::list buffer_bytes;
+    for (const auto& buffer : pickled.buffers)
+    {
+        total += buffer.bytes();
+        buffer_bytes.append(buffer.bytes());
+    }
+
+    shmem.allocate(total);
+    {
+        auto block_info = py::buffer(shmem.get_memoryview()).request(true);
+        auto* dst       = static_cast<char*>(block_info.ptr);
 
-    shmem.allocate(pybind11::len(bytes));
-    shmem.set(bytes);
+        std::memcpy(dst, header.data(), header.bytes());
+        dst += header.bytes();
+
+        for (const auto& buffer : pickled.buffers)
+        {
+            std::memcpy(dst, buffer.data(), buffer.bytes());
+            dst += buffer.bytes();
+        }
+    }
 
     auto descriptor = build_shmem_descriptor(shmem);
+    py::setattr(descriptor, "header_bytes", py::int_(header.bytes()));
+    py::setattr(descriptor, "buffer_bytes", buffer_bytes);
     shmem.close();
 
     VLOG(8) << "Finished persisting object to shared memory: " << py::cast<std::string>(repr(obj));
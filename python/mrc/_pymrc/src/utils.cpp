@@ -236,4 +236,16 @@ void show_deprecation_warning(const std::string& deprecation_message, ssize_t st
 {
     PyErr_WarnEx(PyExc_DeprecationWarning, deprecation_message.c_str(), stack_level);
 }
+
+bool is_gil_enabled()
+{
+    auto sys = py::module_::import("sys");
+
+    if (!py::hasattr(sys, "_is_gil_enabled"))
+    {
+        return true;
+    }
+
+    return sys.attr("_is_gil_enabled")().cast<bool>();
+}
 }  // namespace mrc::pymrc
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -21,6 +21,7 @@
 #include <pybind11/pybind11.h>
 #include <pymrc/coro.hpp>
 #include <pymrc/types.hpp>
+#include <pymrc/utils.hpp>
 
 #include <coroutine>
 #include <stdexcept>
@@ -60,7 +61,7 @@ mrc::coroutines::Task<mrc::pymrc::PyHolder> call_async(mrc::pymrc::PyHolder fn)
     }(fn));
 }
 
-PYBIND11_MODULE(coro, _module)
+PYMRC_MODULE(coro, _module)
 {
     pybind11::module_::import("mrc.core.coro");  // satisfies automatic type conversions for tasks
 
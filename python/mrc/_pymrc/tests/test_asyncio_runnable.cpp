@@ -47,12 +47,15 @@
 #include <atomic>
 #include <chrono>
 #include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <stdexcept>
 #include <stop_token>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace mrc::coroutines {
 class Scheduler;
@@ -87,7 +90,11 @@ std::unique_ptr<pybind11::scoped_interpreter> TestAsyncioRunnable::m_interpreter
 class __attribute__((visibility("default"))) PythonCallbackAsyncioRunnable : public pymrc::AsyncioRunnable<int, int>
 {
   public:
-    PythonCallbackAsyncioRunnable(pymrc::PyObjectHolder operation) : m_operation(std::move(operation)) {}
+    PythonCallbackAsyncioRunnable(pymrc::PyObjectHolder operation,
+                                  std::size_t max_concurrent_tasks = DefaultMaxConcurrentTasks) :
+      pymrc::AsyncioRunnable<int, int>(max_concurrent_tasks),
+      m_operation(std::move(operation))
+    {}
 
     mrc::coroutines::AsyncGenerator<int> on_data(int&& value, std::shared_ptr<mrc::coroutines::Scheduler> on) override
     {
@@ -170,6 +177,117 @@ TEST_F(TestAsyncioRunnable, UseAsyncioTasks)
     EXPECT_EQ(counter, 60);
 }
 
+// Records the loop stats when the runnable is destroyed, the executor owns it once the pipeline starts
+class __attribute__((visibility("default"))) StatsRecordingAsyncioRunnable : public PythonCallbackAsyncioRunnable
+{
+  public:
+    StatsRecordingAsyncioRunnable(pymrc::PyObjectHolder operation,
+                                  std::size_t max_concurrent_tasks,
+                                  std::shared_ptr<std::vector<pymrc::AsyncioLoopStats>> stats) :
+      PythonCallbackAsyncioRunnable(std::move(operation), max_concurrent_tasks),
+      m_stats(std::move(stats))
+    {}
+
+    ~StatsRecordingAsyncioRunnable() override
+    {
+        *m_stats = this->loop_stats();
+    }
+
+  private:
+    std::shared_ptr<std::vector<pymrc::AsyncioLoopStats>> m_stats;
+};
+
+TEST_F(TestAsyncioRunnable, MultipleLoopsBoundedConcurrency)
+{
+    py::object globals = py::globals();
+    py::exec(
+        R"(
+            import asyncio
+            import collections
+
+            active = collections.Counter()
+            peak = collections.Counter()
+
+            async def fn(value):
+                loop = id(asyncio.get_running_loop())
+                active[loop] += 1
+                peak[loop] = max(peak[loop], active[loop])
+                await asyncio.sleep(0.001)
+                active[loop] -= 1
+                return value * 2
+        )",
+        globals);
+
+    pymrc::PyObjectHolder fn = static_cast<py::object>(globals["fn"]);
+
+    constexpr int count                = 200;
+    constexpr std::size_t max_in_flight = 4;
+
+    std::atomic<unsigned int> counter = 0;
+    auto stats                        = std::make_shared<std::vector<pymrc::AsyncioLoopStats>>();
+    pymrc::Pipeline p;
+
+    p.make_segment("seg1"s, [&](mrc::segment::IBuilder& seg) {
+        auto src = seg.make_source<int>("src", [](rxcpp::subscriber<int>& s) {
+            for (int i = 0; i < count && s.is_subscribed(); ++i)
+            {
+                s.on_next(i);
+            }
+
+            s.on_completed();
+        });
+
+        auto internal = seg.construct_object<StatsRecordingAsyncioRunnable>("internal", fn, max_in_flight, stats);
+        internal->launch_options().pe_count = 2;
+
+        auto sink = seg.make_sink<int>("sink", [&counter](int x) {
+            counter.fetch_add(x, std::memory_order_relaxed);
+        });
+
+        seg.make_edge(src, internal);
+        seg.make_edge(internal, sink);
+    });
+
+    auto options = std::make_shared<mrc::Options>();
+    options->topology().user_cpuset("0-1");
+    // AsyncioRunnable only works with the Thread engine due to asyncio loops being thread-specific.
+    options->engine_factories().set_default_engine_type(mrc::runnable::EngineType::Thread);
+
+    {
+        pymrc::Executor exec{options};
+        exec.register_pipeline(p);
+
+        exec.start();
+        exec.join();
+    }
+
+    EXPECT_EQ(counter, count * (count - 1));
+
+    // Each engine hosts its own loop and neither ever had more than max_in_flight tasks running
+    {
+        py::gil_scoped_acquire gil;
+        py::dict peak = globals["peak"];
+        EXPECT_LE(peak.size(), 2);
+        for (const auto& item : peak)
+        {
+            EXPECT_LE(item.second.cast<std::size_t>(), max_in_flight);
+        }
+    }
+
+    ASSERT_EQ(stats->size(), 2);
+    std::uint64_t completed = 0;
+    for (std::size_t i = 0; i < stats->size(); ++i)
+    {
+        const auto& loop = (*stats)[i];
+        EXPECT_EQ(loop.rank, i);
+        EXPECT_EQ(loop.queue_depth, 0);
+        EXPECT_LE(loop.high_water_mark, max_in_flight);
+        EXPECT_LE(loop.max_task_latency, loop.total_task_latency);
+        completed += loop.tasks_completed;
+    }
+    EXPECT_EQ(completed, count);
+}
+
 TEST_F(TestAsyncioRunnable, UseAsyncioGeneratorThrows)
 {
     // pybind11::module_::import("mrc.core.coro");
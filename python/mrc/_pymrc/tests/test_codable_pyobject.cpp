@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -23,12 +23,25 @@
 #include "pymrc/types.hpp"
 
 #include "mrc/codable/codable_protocol.hpp"
+#include "mrc/codable/encoding_options.hpp"
 #include "mrc/codable/type_traits.hpp"
+#include "mrc/codable/types.hpp"
+#include "mrc/memory/buffer_view.hpp"
+#include "mrc/memory/memory_kind.hpp"
 
+#include <Python.h>
 #include <gtest/gtest.h>
+#include <pybind11/gil.h>
+#include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
 #include <string>
+#include <utility>
+#include <vector>
 
 // uncomment the following header list when uncommenting the test
 
@@ -79,6 +92,186 @@ TEST_F(TestCodablePyobject, PyObject)
                   "use pybind11::object or mrc::PyHolder");
 }
 
+/**
+ * Stands in for the descriptors of an encoded object when calling detail::encode_pickled and detail::decode_pickled
+ * directly. Registered views keep pointing at the memory of the object being encoded, everything else is copied.
+ */
+class PickledDescriptors
+{
+  public:
+    explicit PickledDescriptors(bool accept_views = true) : m_accept_views(accept_views) {}
+
+    void encode(py::object py_object, const EncodingOptions& opts)
+    {
+        pymrc::detail::encode_pickled(
+            std::move(py_object),
+            opts,
+            [this](mrc::memory::const_buffer_view view) {
+                if (m_accept_views)
+                {
+                    m_views.push_back(std::move(view));
+                    ++m_registered_count;
+                }
+                return m_accept_views;
+            },
+            [this](mrc::memory::const_buffer_view view) {
+                copy(view);
+            },
+            [this](mrc::memory::const_buffer_view view) {
+                copy(view);
+            });
+    }
+
+    py::object decode() const
+    {
+        return pymrc::detail::decode_pickled(
+            0,
+            [this](idx_t idx, mrc::memory::buffer_view view) {
+                ASSERT_EQ(view.bytes(), m_views[idx].bytes());
+                std::memcpy(view.data(), m_views[idx].data(), view.bytes());
+            },
+            [this](idx_t idx) {
+                return m_views[idx].bytes();
+            });
+    }
+
+    const std::vector<mrc::memory::const_buffer_view>& views() const
+    {
+        return m_views;
+    }
+
+    std::size_t registered_count() const
+    {
+        return m_registered_count;
+    }
+
+    std::uint64_t buffer_count() const
+    {
+        std::uint64_t count{0};
+        std::memcpy(&count, m_views.at(0).data(), sizeof(count));
+        return count;
+    }
+
+  private:
+    void copy(const mrc::memory::const_buffer_view& view)
+    {
+        const auto& owned = m_copies.emplace_back(static_cast<const char*>(view.data()), view.bytes());
+        m_views.emplace_back(owned.data(), owned.size(), mrc::memory::memory_kind::host);
+    }
+
+    bool m_accept_views;
+    std::size_t m_registered_count{0};
+    std::list<std::string> m_copies;
+    std::vector<mrc::memory::const_buffer_view> m_views;
+};
+
+TEST_F(TestCodablePyobject, PickledBelowOutOfBandThreshold)
+{
+    py::gil_scoped_acquire gil;
+
+    auto pickle_buffer = py::module_::import("pickle").attr("PickleBuffer");
+    py::bytearray small(std::string(16, 'y'));
+    py::dict py_dict("small"_a = pickle_buffer(small), "prop"_a = py::dict("subprop"_a = "abc"), "int"_a = 5);
+
+    PickledDescriptors descriptors;
+    descriptors.encode(py_dict, EncodingOptions());
+
+    // the buffer count and the pickle header, the small buffer is copied in-band
+    EXPECT_EQ(descriptors.buffer_count(), 0);
+    EXPECT_EQ(descriptors.views().size(), 2);
+
+    auto rebuilt = descriptors.decode();
+
+    EXPECT_TRUE(rebuilt["small"].equal(small));
+    EXPECT_TRUE(rebuilt["prop"].equal(py_dict["prop"]));
+    EXPECT_TRUE(rebuilt["int"].equal(py::int_(5)));
+}
+
+TEST_F(TestCodablePyobject, PickledAboveOutOfBandThreshold)
+{
+    py::gil_scoped_acquire gil;
+
+    auto pickle_buffer = py::module_::import("pickle").attr("PickleBuffer");
+    py::bytearray large(std::string(1 << 20, 'x'));
+    py::bytearray small(std::string(16, 'y'));
+    py::dict py_dict("large"_a = pickle_buffer(large), "small"_a = pickle_buffer(small), "int"_a = 5);
+
+    PickledDescriptors descriptors;
+    descriptors.encode(py_dict, EncodingOptions());
+
+    // the large buffer is registered as a view of the original memory rather than copied
+    ASSERT_EQ(descriptors.buffer_count(), 1);
+    ASSERT_EQ(descriptors.views().size(), 3);
+    EXPECT_EQ(descriptors.views()[2].data(), PyByteArray_AS_STRING(large.ptr()));
+    EXPECT_EQ(descriptors.views()[2].bytes(), 1 << 20);
+
+    auto rebuilt = descriptors.decode();
+
+    EXPECT_TRUE(rebuilt["large"].equal(large));
+    EXPECT_TRUE(rebuilt["small"].equal(small));
+    EXPECT_TRUE(rebuilt["int"].equal(py::int_(5)));
+}
+
+TEST_F(TestCodablePyobject, PickledAboveOutOfBandThresholdCopied)
+{
+    py::gil_scoped_acquire gil;
+
+    auto pickle_buffer = py::module_::import("pickle").attr("PickleBuffer");
+    py::bytearray large(std::string(1 << 20, 'x'));
+    py::dict py_dict("large"_a = pickle_buffer(large), "int"_a = 5);
+
+    // both force_copy and a storage which declines views copy the out-of-band buffer
+    for (auto [force_copy, accept_views] : {std::pair{true, true}, std::pair{false, false}})
+    {
+        PickledDescriptors descriptors(accept_views);
+        descriptors.encode(py_dict, EncodingOptions(force_copy, false));
+
+        ASSERT_EQ(descriptors.buffer_count(), 1);
+        ASSERT_EQ(descriptors.views().size(), 3);
+        EXPECT_NE(descriptors.views()[2].data(), PyByteArray_AS_STRING(large.ptr()));
+        EXPECT_EQ(descriptors.views()[2].bytes(), 1 << 20);
+
+        auto rebuilt = descriptors.decode();
+
+        EXPECT_TRUE(rebuilt["large"].equal(large));
+        EXPECT_TRUE(rebuilt["int"].equal(py::int_(5)));
+    }
+}
+
+TEST_F(TestCodablePyobject, PickledTemporaryOutOfBandBufferCopied)
+{
+    py::gil_scoped_acquire gil;
+
+    py::object globals = py::globals();
+    py::exec(
+        R"(
+            import pickle
+
+            class ReducesToTemporary:
+                def __reduce_ex__(self, protocol):
+                    return bytearray, (pickle.PickleBuffer(bytearray(b"t" * (1 << 20))), )
+        )",
+        globals);
+
+    auto pickle_buffer = py::module_::import("pickle").attr("PickleBuffer");
+    py::bytearray large(std::string(1 << 20, 'x'));
+    py::dict py_dict("large"_a = pickle_buffer(large), "temporary"_a = globals["ReducesToTemporary"]());
+
+    PickledDescriptors descriptors;
+    descriptors.encode(py_dict, EncodingOptions());
+
+    // the buffer created by __reduce_ex__ is released with the pickle, so only the owned buffer is registered
+    ASSERT_EQ(descriptors.buffer_count(), 2);
+    ASSERT_EQ(descriptors.views().size(), 4);
+    EXPECT_EQ(descriptors.registered_count(), 1);
+    EXPECT_EQ(descriptors.views()[2].data(), PyByteArray_AS_STRING(large.ptr()));
+
+    auto rebuilt = descriptors.decode();
+
+    EXPECT_TRUE(rebuilt["large"].equal(large));
+    EXPECT_TRUE(rebuilt["temporary"].equal(py::bytearray(std::string(1 << 20, 't'))));
+}
+
 // todo(ryan/mdemoret) - reenable when python has a runtime object and a codable storage object can be acquired
 
 // TEST_F(TestCodablePyobject, EncodedObjectSimple)
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -68,3 +68,60 @@ TEST_F(TestObjectCache, Interface)
 
     EXPECT_THROW(cache.get_module("not_a_real_module"), py::error_already_set);
 }
+
+TEST_F(TestObjectCache, InternedObject)
+{
+    mrc::pymrc::PythonObjectCache& cache = pymrc::PythonObjectCache::get_handle();
+
+    auto os = cache.intern_module("os");
+    ASSERT_TRUE(os->is(cache.get_module("os")));
+
+    std::size_t load_count = 0;
+    auto loader            = [&load_count]() {
+        ++load_count;
+        return py::cast<py::object>(py::dict("key"_a = "val"));
+    };
+
+    auto dict  = cache.intern("interned_dictionary", loader);
+    auto dict2 = cache.intern("interned_dictionary", loader);
+    EXPECT_EQ(load_count, 1);
+    ASSERT_TRUE(dict->is(*dict2));
+    ASSERT_TRUE((*dict)["key"].equal(py::str("val")));
+
+    // Handles stay valid across later inserts
+    for (int i = 0; i < 100; ++i)
+    {
+        cache.get_or_load("filler_" + std::to_string(i), []() {
+            return py::int_(0);
+        });
+    }
+
+    ASSERT_TRUE((*dict)["key"].equal(py::str("val")));
+
+    // Overwriting publishes a new entry, handles taken before keep the previous object
+    py::object replacement = py::dict("key"_a = "other");
+    cache.cache_object("interned_dictionary", replacement);
+    ASSERT_TRUE((*dict)["key"].equal(py::str("val")));
+    ASSERT_TRUE(cache.intern("interned_dictionary", loader)->is(replacement));
+    EXPECT_EQ(load_count, 1);
+    EXPECT_EQ(cache.size(), 102);
+}
+
+TEST_F(TestObjectCache, StaticInternedObject)
+{
+    mrc::pymrc::PythonObjectCache& cache = pymrc::PythonObjectCache::get_handle();
+
+    std::size_t load_count = 0;
+    pymrc::PythonObjectCache::StaticInternedObject dict("static_interned_dictionary", [&load_count]() {
+        ++load_count;
+        return py::cast<py::object>(py::dict("key"_a = "val"));
+    });
+
+    auto handle  = dict.get();
+    auto handle2 = dict.get();
+    EXPECT_EQ(load_count, 1);
+    ASSERT_TRUE(handle->is(*handle2));
+    ASSERT_TRUE(handle->is(cache.get_or_load("static_interned_dictionary", []() {
+        return py::none();
+    })));
+}
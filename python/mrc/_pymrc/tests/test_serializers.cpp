@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -164,6 +164,49 @@ TEST_F(TestSerializer, Pybind11SimpleShmem)
     ASSERT_TRUE(simple_pickleable.attr("int_value")().equal(rebuilt.attr("int_value")()));
 }
 
+TEST_F(TestSerializer, OutOfBandBuffers)
+{
+    py::gil_scoped_acquire gil;
+
+    auto pickle_buffer = py::module_::import("pickle").attr("PickleBuffer");
+    py::bytearray large(std::string(1 << 20, 'x'));
+    py::bytearray small(std::string(16, 'y'));
+    py::dict py_dict("large"_a = pickle_buffer(large), "small"_a = pickle_buffer(small), "int"_a = 5);
+
+    auto pickled = pymrc::Serializer::serialize_out_of_band(py_dict);
+
+    // Only the large buffer is passed out-of-band and it is a view of the original memory, not a copy
+    ASSERT_EQ(pickled.buffers.size(), 1);
+    EXPECT_EQ(pickled.buffers[0].data(), PyByteArray_AS_STRING(large.ptr()));
+    EXPECT_EQ(pickled.buffers[0].bytes(), 1 << 20);
+    EXPECT_LT(pickled.header_view().bytes(), 1024);
+
+    py::list buffers;
+    buffers.append(py::bytearray(static_cast<const char*>(pickled.buffers[0].data()), pickled.buffers[0].bytes()));
+
+    auto rebuilt = pymrc::Deserializer::deserialize_out_of_band(pickled.header, buffers);
+
+    ASSERT_TRUE(rebuilt["large"].is(buffers[0]));
+    ASSERT_TRUE(rebuilt["large"].equal(large));
+    ASSERT_TRUE(rebuilt["small"].equal(small));
+    ASSERT_TRUE(rebuilt["int"].equal(py::int_(5)));
+}
+
+TEST_F(TestSerializer, OutOfBandBuffersShmem)
+{
+    py::gil_scoped_acquire gil;
+
+    auto pickle_buffer = py::module_::import("pickle").attr("PickleBuffer");
+    py::bytearray large(std::string(1 << 20, 'x'));
+    py::dict py_dict("large"_a = pickle_buffer(large), "int"_a = 5);
+
+    auto result  = pymrc::Serializer::serialize(py_dict, true);
+    auto rebuilt = pymrc::Deserializer::deserialize(std::get<0>(result), std::get<1>(result));
+
+    ASSERT_TRUE(rebuilt["large"].equal(large));
+    ASSERT_TRUE(rebuilt["int"].equal(py::int_(5)));
+}
+
 TEST_F(TestSerializer, cuDFObject)
 {
     pybind11::gil_scoped_acquire gil;
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -16,6 +16,7 @@
  */
 
 #include "pymrc/tracers.hpp"
+#include "pymrc/utils.hpp"
 
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
@@ -33,7 +34,7 @@ void init_tracer_stats_api(py::module_& m);
 void init_tracer_api(py::module_& m);
 
 // TODO (Devin): Not supporting direct tracers yet, file still needs to be implemented.
-PYBIND11_MODULE(tracers, m)
+PYMRC_MODULE(tracers, m)
 {
     m.doc() = R"pbdoc()pbdoc";
 
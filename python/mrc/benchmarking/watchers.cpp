@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -35,7 +35,7 @@ namespace py = pybind11;
 
 void init_tracer_stats_api(py::module_& m);
 
-PYBIND11_MODULE(watchers, m)
+PYMRC_MODULE(watchers, m)
 {
     m.doc() = R"pbdoc()pbdoc";
 
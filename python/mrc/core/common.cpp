@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -17,6 +17,7 @@
 
 #include "pymrc/port_builders.hpp"
 #include "pymrc/types.hpp"
+#include "pymrc/utils.hpp"
 
 #include "mrc/utils/string_utils.hpp"
 #include "mrc/version.hpp"
@@ -33,7 +34,7 @@ namespace mrc::pymrc {
 namespace py = pybind11;
 using namespace py::literals;
 
-PYBIND11_MODULE(common, py_mod)
+PYMRC_MODULE(common, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC common functionality / utilities
@@ -45,6 +46,11 @@ PYBIND11_MODULE(common, py_mod)
 
     PortBuilderUtil::register_port_util<PyHolder>();
 
+    py_mod.def("is_gil_enabled",
+               &is_gil_enabled,
+               "Returns True if the interpreter is using the GIL. On free-threaded Python builds, Python nodes on "
+               "separate threads only execute in parallel when this is False.");
+
     py_mod.attr("__version__") = MRC_CONCAT_STR(mrc_VERSION_MAJOR << "." << mrc_VERSION_MINOR << "."
                                                                   << mrc_VERSION_PATCH);
 }
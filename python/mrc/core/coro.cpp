@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "pymrc/coro.hpp"
+#include "pymrc/utils.hpp"
 
 #include <glog/logging.h>
 #include <mrc/coroutines/task.hpp>
@@ -32,7 +33,7 @@ namespace mrc::pymrc::coro {
 
 namespace py = pybind11;
 
-PYBIND11_MODULE(coro, _module)
+PYMRC_MODULE(coro, _module)
 {
     _module.doc() = R"pbdoc(
         -----------------------
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -16,6 +16,7 @@
  */
 
 #include "pymrc/logging.hpp"
+#include "pymrc/utils.hpp"
 
 #include "mrc/core/logging.hpp"
 #include "mrc/utils/string_utils.hpp"
@@ -33,7 +34,7 @@ namespace mrc::pymrc {
 namespace py = pybind11;
 using namespace std::string_literals;
 
-PYBIND11_MODULE(logging, py_mod)
+PYMRC_MODULE(logging, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC logging
@@ -36,7 +36,7 @@
 namespace mrc::pymrc {
 namespace py = pybind11;
 
-PYBIND11_MODULE(node, py_mod)
+PYMRC_MODULE(node, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC nodes
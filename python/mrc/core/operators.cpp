@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -35,7 +35,7 @@ namespace mrc::pymrc {
 namespace py = pybind11;
 
 // Define the pybind11 module m, as 'pipeline'.
-PYBIND11_MODULE(operators, py_mod)
+PYMRC_MODULE(operators, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC operators
@@ -49,12 +49,14 @@ PYBIND11_MODULE(operators, py_mod)
     pymrc::import(py_mod, "mrc.core.common");
     pymrc::import(py_mod, "mrc.core.subscriber");
 
-    py::class_<PythonOperator>(py_mod, "Operator").def_property_readonly("name", &OperatorProxy::get_name);
+    py::class_<PythonOperator>(py_mod, "Operator")
+        .def_property_readonly("name", &OperatorProxy::get_name)
+        .def_property_readonly("gil_batch_size", &OperatorProxy::get_gil_batch_size);
 
     py_mod.def("build", &OperatorsProxy::build);
     py_mod.def("filter", &OperatorsProxy::filter);
     py_mod.def("flatten", &OperatorsProxy::flatten);
-    py_mod.def("map", &OperatorsProxy::map);
+    py_mod.def("map", &OperatorsProxy::map, py::arg("map_fn"), py::arg("gil_batch_size") = 1);
     py_mod.def("on_completed", &OperatorsProxy::on_completed);
     py_mod.def("pairwise", &OperatorsProxy::pairwise);
     py_mod.def("to_list", &OperatorsProxy::to_list);
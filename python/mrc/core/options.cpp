@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -41,7 +41,7 @@ class Config
 {};
 
 // Define the pybind11 module m, as 'pipeline'.
-PYBIND11_MODULE(options, py_mod)
+PYMRC_MODULE(options, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC options
@@ -90,7 +90,10 @@ PYBIND11_MODULE(options, py_mod)
         .def_property("reusable", &EngineFactoryOptionsProxy::get_reusable, &EngineFactoryOptionsProxy::set_reusable)
         .def_property("allow_overlap",
                       &EngineFactoryOptionsProxy::get_allow_overlap,
-                      &EngineFactoryOptionsProxy::set_allow_overlap);
+                      &EngineFactoryOptionsProxy::set_allow_overlap)
+        .def_property("work_sharing",
+                      &EngineFactoryOptionsProxy::get_work_sharing,
+                      &EngineFactoryOptionsProxy::set_work_sharing);
 
     py::class_<mrc::EngineGroups>(py_mod, "EngineGroups")
         .def(py::init<>())
@@ -116,7 +119,10 @@ PYBIND11_MODULE(options, py_mod)
         .def_property("architect_url",
                       // return a const str
                       static_cast<std::string const& (mrc::Options::*)() const>(&mrc::Options::architect_url),
-                      static_cast<void (mrc::Options::*)(std::string)>(&mrc::Options::architect_url));
+                      static_cast<void (mrc::Options::*)(std::string)>(&mrc::Options::architect_url))
+        .def_property("enable_node_metrics",
+                      static_cast<bool (mrc::Options::*)() const>(&mrc::Options::enable_node_metrics),
+                      static_cast<void (mrc::Options::*)(bool)>(&mrc::Options::enable_node_metrics));
 
     py_mod.attr("__version__") = MRC_CONCAT_STR(mrc_VERSION_MAJOR << "." << mrc_VERSION_MINOR << "."
                                                                   << mrc_VERSION_PATCH);
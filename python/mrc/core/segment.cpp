@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -46,7 +46,7 @@ namespace mrc::pymrc {
 
 namespace py = pybind11;
 
-PYBIND11_MODULE(segment, py_mod)
+PYMRC_MODULE(segment, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC Segments
@@ -92,7 +92,8 @@ PYBIND11_MODULE(segment, py_mod)
     py::class_<mrc::runnable::LaunchOptions>(py_mod, "LaunchOptions")
         .def_readwrite("pe_count", &mrc::runnable::LaunchOptions::pe_count)
         .def_readwrite("engines_per_pe", &mrc::runnable::LaunchOptions::engines_per_pe)
-        .def_readwrite("engine_factory_name", &mrc::runnable::LaunchOptions::engine_factory_name);
+        .def_readwrite("engine_factory_name", &mrc::runnable::LaunchOptions::engine_factory_name)
+        .def_readwrite("allow_work_sharing", &mrc::runnable::LaunchOptions::allow_work_sharing);
 
     // Base SegmentObject that all object usually derive from
     py::class_<mrc::segment::ObjectProperties, std::shared_ptr<mrc::segment::ObjectProperties>>(py_mod, "SegmentObject")
@@ -160,6 +161,7 @@ PYBIND11_MODULE(segment, py_mod)
      * (py) @param on_next: python/std function that will be called on a new data element.
      * (py) @param on_error: python/std function that will be called if an error occurs.
      * (py) @param on_completed: python/std function that will be called
+     * (py) @param gil_batch_size: maximum number of items passed to on_next per acquisition of the GIL
      *  Python example.
      *  ```python
      *      def my_on_next(x):
@@ -178,7 +180,8 @@ PYBIND11_MODULE(segment, py_mod)
                 py::arg("name"),
                 py::arg("on_next").none(true)     = py::none(),
                 py::arg("on_error").none(true)    = py::none(),
-                py::arg("on_complete").none(true) = py::none());
+                py::arg("on_complete").none(true) = py::none(),
+                py::arg("gil_batch_size")         = 1);
 
     Builder.def("make_sink_component",
                 &BuilderProxy::make_sink_component,
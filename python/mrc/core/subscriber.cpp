@@ -37,7 +37,7 @@ namespace mrc::pymrc {
 namespace py = pybind11;
 using namespace py::literals;
 
-PYBIND11_MODULE(subscriber, py_mod)
+PYMRC_MODULE(subscriber, py_mod)
 {
     py_mod.doc() = R"pbdoc(
         Python bindings for MRC subscribers
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: Apache-2.0
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -318,7 +318,7 @@ GENERATE_NODE_TYPES(TestSinkComponent, SinkComponent);
              py::arg("counter"),                                                                                   \
              py::arg("msg_count") = 5);
 
-PYBIND11_MODULE(test_edges_cpp, py_mod)
+PYMRC_MODULE(test_edges_cpp, py_mod)
 {
     py_mod.doc() = R"pbdoc()pbdoc";
 
@@ -48,7 +48,7 @@ pymrc::JSONValues roundtrip_cast(pymrc::JSONValues v)
     return v;
 }
 
-PYBIND11_MODULE(utils, py_mod)
+PYMRC_MODULE(utils, py_mod)
 {
     py_mod.doc() = R"pbdoc()pbdoc";
 
@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: Copyright (c) 2023 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-FileCopyrightText: Copyright (c) 2023-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 # SPDX-License-Identifier: Apache-2.0
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
@@ -13,9 +13,14 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import sys
+import sysconfig
 import threading
 
+import pytest
+
 import mrc
+from mrc.core.common import is_gil_enabled
 from mrc.tests.utils import RequireGilInDestructor
 
 TLS = threading.local()
@@ -43,3 +48,23 @@ def test_gil_thread_local_storage():
     executor.register_pipeline(pipe)
     executor.start()
     executor.join()
+
+
+def test_is_gil_enabled():
+    expected = sys._is_gil_enabled() if hasattr(sys, "_is_gil_enabled") else True
+    assert is_gil_enabled() == expected
+
+
+@pytest.mark.skipif(not sysconfig.get_config_var("Py_GIL_DISABLED"), reason="Requires a free-threaded Python build")
+def test_modules_do_not_enable_gil():
+    """
+    Every mrc extension module is declared as not requiring the GIL, importing them should leave it disabled
+    """
+    import mrc._pymrc.tests.coro.coro  # noqa: F401
+    import mrc.benchmarking  # noqa: F401
+    import mrc.core.coro  # noqa: F401
+    import mrc.tests.sample_modules  # noqa: F401
+    import mrc.tests.test_edges_cpp  # noqa: F401
+    import mrc.tests.utils  # noqa: F401
+
+    assert not is_gil_enabled()
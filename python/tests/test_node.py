@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: Copyright (c) 2021-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-FileCopyrightText: Copyright (c) 2021-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 # SPDX-License-Identifier: Apache-2.0
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
@@ -295,6 +295,60 @@ def test_launch_options_properties():
     executor.join()
 
 
+def test_launch_options_work_sharing():
+    pe_count = 2
+    input_data = list(range(100))
+    actual = []
+
+    def segment_init(seg: mrc.Builder):
+        src_node = seg.make_source("my_src", input_data)
+
+        def node_fn(x: int):
+            return x * 2
+
+        map_node = seg.make_node("my_map", ops.map(node_fn))
+        map_node.launch_options.engine_factory_name = "sharing"
+        map_node.launch_options.pe_count = pe_count
+        map_node.launch_options.allow_work_sharing = True
+        assert map_node.launch_options.allow_work_sharing, "Set and get should match"
+
+        sink_node = seg.make_sink("my_sink", actual.append, None, None, gil_batch_size=8)
+        sink_node.launch_options.engine_factory_name = "sharing"
+        sink_node.launch_options.allow_work_sharing = True
+
+        assert src_node.launch_options.allow_work_sharing is False, "Default should be False"
+
+        seg.make_edge(src_node, map_node)
+        seg.make_edge(map_node, sink_node)
+
+    pipeline = mrc.Pipeline()
+
+    pipeline.make_segment("my_seg", segment_init)
+
+    options = mrc.Options()
+
+    options.topology.user_cpuset = "0-{}".format(pe_count)
+
+    # Python nodes ignore allow_work_sharing and stay pinned to the thread holding their python state
+    sharing_group = mrc.core.options.EngineFactoryOptions()
+    sharing_group.cpu_count = pe_count
+    sharing_group.engine_type = mrc.core.options.EngineType.Fiber
+    sharing_group.reusable = True
+    sharing_group.allow_overlap = False
+    sharing_group.work_sharing = True
+    options.engine_factories.set_engine_factory_options("sharing", sharing_group)
+
+    executor = mrc.Executor(options)
+
+    executor.register_pipeline(pipeline)
+
+    executor.start()
+
+    executor.join()
+
+    assert sorted(actual) == [x * 2 for x in input_data]
+
+
 @pytest.mark.parametrize("use_on_completed", [True, False])
 @pytest.mark.parametrize("use_on_error", [True, False])
 @pytest.mark.parametrize("use_on_next", [True, False])
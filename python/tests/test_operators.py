@@ -1,4 +1,4 @@
-# SPDX-FileCopyrightText: Copyright (c) 2022-2023, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-FileCopyrightText: Copyright (c) 2022-2024, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 # SPDX-License-Identifier: Apache-2.0
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
@@ -254,5 +254,93 @@ def test_combination(run_segment):
     assert actual == expected
 
 
+def test_map_gil_batch_size(ex_runner):
+
+    input_data = list(range(1000))
+    expected = [x + 1 for x in input_data if (x + 1) % 2 == 0]
+    actual = []
+    did_complete = False
+
+    def segment_fn(seg: mrc.Builder):
+        source = seg.make_source("source", producer(input_data))
+
+        map_op = ops.map(lambda x: x + 1, gil_batch_size=32)
+        assert map_op.gil_batch_size == 32
+
+        node = seg.make_node("test", map_op, ops.filter(lambda x: x % 2 == 0))
+        seg.make_edge(source, node)
+
+        def sink_on_completed():
+            nonlocal did_complete
+            did_complete = True
+
+        sink = seg.make_sink("sink", actual.append, None, sink_on_completed, gil_batch_size=16)
+        seg.make_edge(node, sink)
+
+    ex_runner(segment_fn)
+
+    assert did_complete, "Sink on_completed was not called"
+    assert actual == expected
+
+
+def test_map_gil_batch_size_invalid():
+
+    assert ops.map(lambda x: x).gil_batch_size == 1
+
+    with pytest.raises(ValueError):
+        ops.map(lambda x: x, gil_batch_size=0)
+
+
+
+def test_map_gil_batch_size_completes_in_order(ex_runner):
+
+    input_data = list(range(100))
+    expected = list(range(50))
+    actual = []
+    did_complete = False
+
+    def node_fn(input: mrc.Observable, output: mrc.Subscriber):
+
+        # Completes in the middle of the second batch, after the items before it were buffered
+        def on_next(x):
+            if (x < 50):
+                output.on_next(x)
+            elif (x == 50):
+                output.on_completed()
+
+        input.subscribe(mrc.Observer.make_observer(on_next, output.on_error, output.on_completed))
+
+    def segment_fn(seg: mrc.Builder):
+        source = seg.make_source("source", producer(input_data))
+
+        node = seg.make_node("test", ops.map(lambda x: x, gil_batch_size=32), ops.build(node_fn))
+        seg.make_edge(source, node)
+
+        def sink_on_completed():
+            nonlocal did_complete
+            did_complete = True
+
+        sink = seg.make_sink("sink", actual.append, None, sink_on_completed)
+        seg.make_edge(node, sink)
+
+    ex_runner(segment_fn)
+
+    assert did_complete, "Sink on_completed was not called"
+    assert actual == expected
+
+
+def test_sink_gil_batch_size_invalid(ex_runner):
+
+    def segment_fn(seg: mrc.Builder):
+        source = seg.make_source("source", producer([1, 2, 3]))
+
+        with pytest.raises(ValueError):
+            seg.make_sink("invalid_sink", lambda x: None, None, None, gil_batch_size=0)
+
+        sink = seg.make_sink("sink", lambda x: None, None, None)
+        seg.make_edge(source, sink)
+
+    ex_runner(segment_fn)
+
 if (__name__ == "__main__"):
     pytest.main(['-s', 'tests/test_operators.py::test_filter_error'])